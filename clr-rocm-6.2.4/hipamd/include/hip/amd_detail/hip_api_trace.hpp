@@ -61,7 +61,7 @@
 // - Reset any of the *_STEP_VERSION defines to zero if the corresponding *_MAJOR_VERSION increases
 #define HIP_API_TABLE_STEP_VERSION 0
 #define HIP_COMPILER_API_TABLE_STEP_VERSION 0
-#define HIP_RUNTIME_API_TABLE_STEP_VERSION 3
+#define HIP_RUNTIME_API_TABLE_STEP_VERSION 6
 
 // HIP API interface
 typedef hipError_t (*t___hipPopCallConfiguration)(dim3* gridDim, dim3* blockDim, size_t* sharedMem,
@@ -802,6 +802,14 @@ typedef hipError_t (*t_hipMemcpy2D_spt)(void* dst, size_t dpitch, const void* sr
 typedef hipError_t (*t_hipMemcpy2DFromArray_spt)(void* dst, size_t dpitch, hipArray_const_t src,
                                                  size_t wOffset, size_t hOffset, size_t width,
                                                  size_t height, hipMemcpyKind kind);
+typedef hipError_t (*t_hipExtLaunchKernelBatch)(const hipFunctionLaunchParams* launchParamsList,
+                                                unsigned int numKernels, hipStream_t stream,
+                                                unsigned int flags);
+typedef hipError_t (*t_hipExtGraphSave)(hipGraph_t graph, const char* path, unsigned int flags);
+typedef hipError_t (*t_hipExtGraphLoad)(hipGraph_t* pGraph, const char* path, unsigned int flags);
+typedef hipError_t (*t_hipStreamBatchMemOp)(hipStream_t stream, unsigned int count,
+                                            hipStreamBatchMemOpParams* paramArray,
+                                            unsigned int flags);
 
 typedef hipError_t (*t_hipMemcpy3D_spt)(const struct hipMemcpy3DParms* p);
 
@@ -1443,4 +1451,8 @@ struct HipDispatchTable {
   t_hipMemcpyAtoHAsync hipMemcpyAtoHAsync_fn;
   t_hipMemcpyHtoAAsync hipMemcpyHtoAAsync_fn;
   t_hipMemcpy2DArrayToArray hipMemcpy2DArrayToArray_fn;
+  t_hipExtLaunchKernelBatch hipExtLaunchKernelBatch_fn;
+  t_hipExtGraphSave hipExtGraphSave_fn;
+  t_hipExtGraphLoad hipExtGraphLoad_fn;
+  t_hipStreamBatchMemOp hipStreamBatchMemOp_fn;
 };
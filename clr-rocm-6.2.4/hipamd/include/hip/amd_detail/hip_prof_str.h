@@ -417,7 +417,11 @@ enum hip_api_id_t {
   HIP_API_ID_hipMemcpyDtoA = 397,
   HIP_API_ID_hipMemcpyHtoAAsync = 398,
   HIP_API_ID_hipSetValidDevices = 399,
-  HIP_API_ID_LAST = 399,
+  HIP_API_ID_hipExtLaunchKernelBatch = 400,
+  HIP_API_ID_hipExtGraphSave = 401,
+  HIP_API_ID_hipExtGraphLoad = 402,
+  HIP_API_ID_hipStreamBatchMemOp = 403,
+  HIP_API_ID_LAST = 403,
 
   HIP_API_ID_hipChooseDevice = HIP_API_ID_CONCAT(HIP_API_ID_,hipChooseDevice),
   HIP_API_ID_hipGetDeviceProperties = HIP_API_ID_CONCAT(HIP_API_ID_,hipGetDeviceProperties),
@@ -533,7 +537,10 @@ static inline const char* hip_api_name(const uint32_t id) {
     case HIP_API_ID_hipEventSynchronize: return "hipEventSynchronize";
     case HIP_API_ID_hipExtGetLastError: return "hipExtGetLastError";
     case HIP_API_ID_hipExtGetLinkTypeAndHopCount: return "hipExtGetLinkTypeAndHopCount";
+    case HIP_API_ID_hipExtGraphLoad: return "hipExtGraphLoad";
+    case HIP_API_ID_hipExtGraphSave: return "hipExtGraphSave";
     case HIP_API_ID_hipExtLaunchKernel: return "hipExtLaunchKernel";
+    case HIP_API_ID_hipExtLaunchKernelBatch: return "hipExtLaunchKernelBatch";
     case HIP_API_ID_hipExtLaunchMultiKernelMultiDevice: return "hipExtLaunchMultiKernelMultiDevice";
     case HIP_API_ID_hipExtMallocWithFlags: return "hipExtMallocWithFlags";
     case HIP_API_ID_hipExtModuleLaunchKernel: return "hipExtModuleLaunchKernel";
@@ -796,6 +803,7 @@ static inline const char* hip_api_name(const uint32_t id) {
     case HIP_API_ID_hipSignalExternalSemaphoresAsync: return "hipSignalExternalSemaphoresAsync";
     case HIP_API_ID_hipStreamAddCallback: return "hipStreamAddCallback";
     case HIP_API_ID_hipStreamAttachMemAsync: return "hipStreamAttachMemAsync";
+    case HIP_API_ID_hipStreamBatchMemOp: return "hipStreamBatchMemOp";
     case HIP_API_ID_hipStreamBeginCapture: return "hipStreamBeginCapture";
     case HIP_API_ID_hipStreamBeginCaptureToGraph: return "hipStreamBeginCaptureToGraph";
     case HIP_API_ID_hipStreamCreate: return "hipStreamCreate";
@@ -927,7 +935,10 @@ static inline uint32_t hipApiIdByName(const char* name) {
   if (strcmp("hipEventSynchronize", name) == 0) return HIP_API_ID_hipEventSynchronize;
   if (strcmp("hipExtGetLastError", name) == 0) return HIP_API_ID_hipExtGetLastError;
   if (strcmp("hipExtGetLinkTypeAndHopCount", name) == 0) return HIP_API_ID_hipExtGetLinkTypeAndHopCount;
+  if (strcmp("hipExtGraphLoad", name) == 0) return HIP_API_ID_hipExtGraphLoad;
+  if (strcmp("hipExtGraphSave", name) == 0) return HIP_API_ID_hipExtGraphSave;
   if (strcmp("hipExtLaunchKernel", name) == 0) return HIP_API_ID_hipExtLaunchKernel;
+  if (strcmp("hipExtLaunchKernelBatch", name) == 0) return HIP_API_ID_hipExtLaunchKernelBatch;
   if (strcmp("hipExtLaunchMultiKernelMultiDevice", name) == 0) return HIP_API_ID_hipExtLaunchMultiKernelMultiDevice;
   if (strcmp("hipExtMallocWithFlags", name) == 0) return HIP_API_ID_hipExtMallocWithFlags;
   if (strcmp("hipExtModuleLaunchKernel", name) == 0) return HIP_API_ID_hipExtModuleLaunchKernel;
@@ -1190,6 +1201,7 @@ static inline uint32_t hipApiIdByName(const char* name) {
   if (strcmp("hipSignalExternalSemaphoresAsync", name) == 0) return HIP_API_ID_hipSignalExternalSemaphoresAsync;
   if (strcmp("hipStreamAddCallback", name) == 0) return HIP_API_ID_hipStreamAddCallback;
   if (strcmp("hipStreamAttachMemAsync", name) == 0) return HIP_API_ID_hipStreamAttachMemAsync;
+  if (strcmp("hipStreamBatchMemOp", name) == 0) return HIP_API_ID_hipStreamBatchMemOp;
   if (strcmp("hipStreamBeginCapture", name) == 0) return HIP_API_ID_hipStreamBeginCapture;
   if (strcmp("hipStreamBeginCaptureToGraph", name) == 0) return HIP_API_ID_hipStreamBeginCaptureToGraph;
   if (strcmp("hipStreamCreate", name) == 0) return HIP_API_ID_hipStreamCreate;
@@ -1610,6 +1622,19 @@ typedef struct hip_api_data_s {
       unsigned int* hopcount;
       unsigned int hopcount__val;
     } hipExtGetLinkTypeAndHopCount;
+    struct {
+      hipGraph_t* pGraph;
+      hipGraph_t pGraph__val;
+      const char* path;
+      char path__val;
+      unsigned int flags;
+    } hipExtGraphLoad;
+    struct {
+      hipGraph_t graph;
+      const char* path;
+      char path__val;
+      unsigned int flags;
+    } hipExtGraphSave;
     struct {
       const void* function_address;
       dim3 numBlocks;
@@ -1622,6 +1647,13 @@ typedef struct hip_api_data_s {
       hipEvent_t stopEvent;
       int flags;
     } hipExtLaunchKernel;
+    struct {
+      const hipFunctionLaunchParams* launchParamsList;
+      hipFunctionLaunchParams launchParamsList__val;
+      unsigned int numKernels;
+      hipStream_t stream;
+      unsigned int flags;
+    } hipExtLaunchKernelBatch;
     struct {
       hipLaunchParams* launchParamsList;
       hipLaunchParams launchParamsList__val;
@@ -3272,6 +3304,13 @@ typedef struct hip_api_data_s {
       size_t length;
       unsigned int flags;
     } hipStreamAttachMemAsync;
+    struct {
+      hipStream_t stream;
+      unsigned int count;
+      hipStreamBatchMemOpParams* paramArray;
+      hipStreamBatchMemOpParams paramArray__val;
+      unsigned int flags;
+    } hipStreamBatchMemOp;
     struct {
       hipStream_t stream;
       hipStreamCaptureMode mode;
@@ -3934,6 +3973,18 @@ typedef struct hip_api_data_s {
   cb_data.args.hipExtGetLinkTypeAndHopCount.linktype = (unsigned int*)linktype; \
   cb_data.args.hipExtGetLinkTypeAndHopCount.hopcount = (unsigned int*)hopcount; \
 };
+// hipExtGraphLoad[('hipGraph_t*', 'pGraph'), ('const char*', 'path'), ('unsigned int', 'flags')]
+#define INIT_hipExtGraphLoad_CB_ARGS_DATA(cb_data) { \
+  cb_data.args.hipExtGraphLoad.pGraph = (hipGraph_t*)pGraph; \
+  cb_data.args.hipExtGraphLoad.path = (path) ? strdup(path) : NULL; \
+  cb_data.args.hipExtGraphLoad.flags = (unsigned int)flags; \
+};
+// hipExtGraphSave[('hipGraph_t', 'graph'), ('const char*', 'path'), ('unsigned int', 'flags')]
+#define INIT_hipExtGraphSave_CB_ARGS_DATA(cb_data) { \
+  cb_data.args.hipExtGraphSave.graph = (hipGraph_t)graph; \
+  cb_data.args.hipExtGraphSave.path = (path) ? strdup(path) : NULL; \
+  cb_data.args.hipExtGraphSave.flags = (unsigned int)flags; \
+};
 // hipExtLaunchKernel[('const void*', 'function_address'), ('dim3', 'numBlocks'), ('dim3', 'dimBlocks'), ('void**', 'args'), ('size_t', 'sharedMemBytes'), ('hipStream_t', 'stream'), ('hipEvent_t', 'startEvent'), ('hipEvent_t', 'stopEvent'), ('int', 'flags')]
 #define INIT_hipExtLaunchKernel_CB_ARGS_DATA(cb_data) { \
   cb_data.args.hipExtLaunchKernel.function_address = (const void*)hostFunction; \
@@ -3946,6 +3997,13 @@ typedef struct hip_api_data_s {
   cb_data.args.hipExtLaunchKernel.stopEvent = (hipEvent_t)stopEvent; \
   cb_data.args.hipExtLaunchKernel.flags = (int)flags; \
 };
+// hipExtLaunchKernelBatch[('const hipFunctionLaunchParams*', 'launchParamsList'), ('unsigned int', 'numKernels'), ('hipStream_t', 'stream'), ('unsigned int', 'flags')]
+#define INIT_hipExtLaunchKernelBatch_CB_ARGS_DATA(cb_data) { \
+  cb_data.args.hipExtLaunchKernelBatch.launchParamsList = (const hipFunctionLaunchParams*)launchParamsList; \
+  cb_data.args.hipExtLaunchKernelBatch.numKernels = (unsigned int)numKernels; \
+  cb_data.args.hipExtLaunchKernelBatch.stream = (hipStream_t)stream; \
+  cb_data.args.hipExtLaunchKernelBatch.flags = (unsigned int)flags; \
+};
 // hipExtLaunchMultiKernelMultiDevice[('hipLaunchParams*', 'launchParamsList'), ('int', 'numDevices'), ('unsigned int', 'flags')]
 #define INIT_hipExtLaunchMultiKernelMultiDevice_CB_ARGS_DATA(cb_data) { \
   cb_data.args.hipExtLaunchMultiKernelMultiDevice.launchParamsList = (hipLaunchParams*)launchParamsList; \
@@ -5632,6 +5690,13 @@ typedef struct hip_api_data_s {
   cb_data.args.hipStreamAttachMemAsync.length = (size_t)length; \
   cb_data.args.hipStreamAttachMemAsync.flags = (unsigned int)flags; \
 };
+// hipStreamBatchMemOp[('hipStream_t', 'stream'), ('unsigned int', 'count'), ('hipStreamBatchMemOpParams*', 'paramArray'), ('unsigned int', 'flags')]
+#define INIT_hipStreamBatchMemOp_CB_ARGS_DATA(cb_data) { \
+  cb_data.args.hipStreamBatchMemOp.stream = (hipStream_t)stream; \
+  cb_data.args.hipStreamBatchMemOp.count = (unsigned int)count; \
+  cb_data.args.hipStreamBatchMemOp.paramArray = (hipStreamBatchMemOpParams*)paramArray; \
+  cb_data.args.hipStreamBatchMemOp.flags = (unsigned int)flags; \
+};
 // hipStreamBeginCapture[('hipStream_t', 'stream'), ('hipStreamCaptureMode', 'mode')]
 #define INIT_hipStreamBeginCapture_CB_ARGS_DATA(cb_data) { \
   cb_data.args.hipStreamBeginCapture.stream = (hipStream_t)stream; \
@@ -6251,10 +6316,23 @@ static inline void hipApiArgsInit(hip_api_id_t id, hip_api_data_t* data) {
       if (data->args.hipExtGetLinkTypeAndHopCount.linktype) data->args.hipExtGetLinkTypeAndHopCount.linktype__val = *(data->args.hipExtGetLinkTypeAndHopCount.linktype);
       if (data->args.hipExtGetLinkTypeAndHopCount.hopcount) data->args.hipExtGetLinkTypeAndHopCount.hopcount__val = *(data->args.hipExtGetLinkTypeAndHopCount.hopcount);
       break;
+// hipExtGraphLoad[('hipGraph_t*', 'pGraph'), ('const char*', 'path'), ('unsigned int', 'flags')]
+    case HIP_API_ID_hipExtGraphLoad:
+      if (data->args.hipExtGraphLoad.pGraph) data->args.hipExtGraphLoad.pGraph__val = *(data->args.hipExtGraphLoad.pGraph);
+      if (data->args.hipExtGraphLoad.path) data->args.hipExtGraphLoad.path__val = *(data->args.hipExtGraphLoad.path);
+      break;
+// hipExtGraphSave[('hipGraph_t', 'graph'), ('const char*', 'path'), ('unsigned int', 'flags')]
+    case HIP_API_ID_hipExtGraphSave:
+      if (data->args.hipExtGraphSave.path) data->args.hipExtGraphSave.path__val = *(data->args.hipExtGraphSave.path);
+      break;
 // hipExtLaunchKernel[('const void*', 'function_address'), ('dim3', 'numBlocks'), ('dim3', 'dimBlocks'), ('void**', 'args'), ('size_t', 'sharedMemBytes'), ('hipStream_t', 'stream'), ('hipEvent_t', 'startEvent'), ('hipEvent_t', 'stopEvent'), ('int', 'flags')]
     case HIP_API_ID_hipExtLaunchKernel:
       if (data->args.hipExtLaunchKernel.args) data->args.hipExtLaunchKernel.args__val = *(data->args.hipExtLaunchKernel.args);
       break;
+// hipExtLaunchKernelBatch[('const hipFunctionLaunchParams*', 'launchParamsList'), ('unsigned int', 'numKernels'), ('hipStream_t', 'stream'), ('unsigned int', 'flags')]
+    case HIP_API_ID_hipExtLaunchKernelBatch:
+      if (data->args.hipExtLaunchKernelBatch.launchParamsList) data->args.hipExtLaunchKernelBatch.launchParamsList__val = *(data->args.hipExtLaunchKernelBatch.launchParamsList);
+      break;
 // hipExtLaunchMultiKernelMultiDevice[('hipLaunchParams*', 'launchParamsList'), ('int', 'numDevices'), ('unsigned int', 'flags')]
     case HIP_API_ID_hipExtLaunchMultiKernelMultiDevice:
       if (data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList) data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList__val = *(data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList);
@@ -7271,6 +7349,10 @@ static inline void hipApiArgsInit(hip_api_id_t id, hip_api_data_t* data) {
 // hipStreamAttachMemAsync[('hipStream_t', 'stream'), ('void*', 'dev_ptr'), ('size_t', 'length'), ('unsigned int', 'flags')]
     case HIP_API_ID_hipStreamAttachMemAsync:
       break;
+// hipStreamBatchMemOp[('hipStream_t', 'stream'), ('unsigned int', 'count'), ('hipStreamBatchMemOpParams*', 'paramArray'), ('unsigned int', 'flags')]
+    case HIP_API_ID_hipStreamBatchMemOp:
+      if (data->args.hipStreamBatchMemOp.paramArray) data->args.hipStreamBatchMemOp.paramArray__val = *(data->args.hipStreamBatchMemOp.paramArray);
+      break;
 // hipStreamBeginCapture[('hipStream_t', 'stream'), ('hipStreamCaptureMode', 'mode')]
     case HIP_API_ID_hipStreamBeginCapture:
       break;
@@ -8005,6 +8087,23 @@ static inline const char* hipApiString(hip_api_id_t id, const hip_api_data_t* da
       else { oss << ", hopcount="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGetLinkTypeAndHopCount.hopcount__val); }
       oss << ")";
     break;
+    case HIP_API_ID_hipExtGraphLoad:
+      oss << "hipExtGraphLoad(";
+      if (data->args.hipExtGraphLoad.pGraph == NULL) oss << "pGraph=NULL";
+      else { oss << "pGraph="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGraphLoad.pGraph__val); }
+      if (data->args.hipExtGraphLoad.path == NULL) oss << ", path=NULL";
+      else { oss << ", path="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGraphLoad.path__val); }
+      oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGraphLoad.flags);
+      oss << ")";
+    break;
+    case HIP_API_ID_hipExtGraphSave:
+      oss << "hipExtGraphSave(";
+      oss << "graph="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGraphSave.graph);
+      if (data->args.hipExtGraphSave.path == NULL) oss << ", path=NULL";
+      else { oss << ", path="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGraphSave.path__val); }
+      oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtGraphSave.flags);
+      oss << ")";
+    break;
     case HIP_API_ID_hipExtLaunchKernel:
       oss << "hipExtLaunchKernel(";
       oss << "function_address="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernel.function_address);
@@ -8019,6 +8118,15 @@ static inline const char* hipApiString(hip_api_id_t id, const hip_api_data_t* da
       oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernel.flags);
       oss << ")";
     break;
+    case HIP_API_ID_hipExtLaunchKernelBatch:
+      oss << "hipExtLaunchKernelBatch(";
+      if (data->args.hipExtLaunchKernelBatch.launchParamsList == NULL) oss << "launchParamsList=NULL";
+      else { oss << "launchParamsList="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.launchParamsList__val); }
+      oss << ", numKernels="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.numKernels);
+      oss << ", stream="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.stream);
+      oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.flags);
+      oss << ")";
+    break;
     case HIP_API_ID_hipExtLaunchMultiKernelMultiDevice:
       oss << "hipExtLaunchMultiKernelMultiDevice(";
       if (data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList == NULL) oss << "launchParamsList=NULL";
@@ -10203,6 +10311,15 @@ static inline const char* hipApiString(hip_api_id_t id, const hip_api_data_t* da
       oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipStreamAttachMemAsync.flags);
       oss << ")";
     break;
+    case HIP_API_ID_hipStreamBatchMemOp:
+      oss << "hipStreamBatchMemOp(";
+      oss << "stream="; roctracer::hip_support::detail::operator<<(oss, data->args.hipStreamBatchMemOp.stream);
+      oss << ", count="; roctracer::hip_support::detail::operator<<(oss, data->args.hipStreamBatchMemOp.count);
+      if (data->args.hipStreamBatchMemOp.paramArray == NULL) oss << ", paramArray=NULL";
+      else { oss << ", paramArray="; roctracer::hip_support::detail::operator<<(oss, data->args.hipStreamBatchMemOp.paramArray__val); }
+      oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipStreamBatchMemOp.flags);
+      oss << ")";
+    break;
     case HIP_API_ID_hipStreamBeginCapture:
       oss << "hipStreamBeginCapture(";
       oss << "stream="; roctracer::hip_support::detail::operator<<(oss, data->args.hipStreamBeginCapture.stream);
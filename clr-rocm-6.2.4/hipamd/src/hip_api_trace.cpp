@@ -782,6 +782,13 @@ hipError_t hipMemcpyHtoAAsync(hipArray_t dstArray, size_t dstOffset, const void*
 hipError_t hipMemcpy2DArrayToArray(hipArray_t dst, size_t wOffsetDst, size_t hOffsetDst,
                                    hipArray_const_t src, size_t wOffsetSrc, size_t hOffsetSrc,
                                    size_t width, size_t height, hipMemcpyKind kind);
+hipError_t hipExtLaunchKernelBatch(const hipFunctionLaunchParams* launchParamsList,
+                                   unsigned int numKernels, hipStream_t stream,
+                                   unsigned int flags);
+hipError_t hipExtGraphSave(hipGraph_t graph, const char* path, unsigned int flags);
+hipError_t hipExtGraphLoad(hipGraph_t* pGraph, const char* path, unsigned int flags);
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags);
 }  // namespace hip
 
 namespace hip {
@@ -1265,6 +1272,10 @@ void UpdateDispatchTable(HipDispatchTable* ptrDispatchTable) {
   ptrDispatchTable->hipMemcpyAtoHAsync_fn = hip::hipMemcpyAtoHAsync;
   ptrDispatchTable->hipMemcpyHtoAAsync_fn = hip::hipMemcpyHtoAAsync;
   ptrDispatchTable->hipMemcpy2DArrayToArray_fn = hip::hipMemcpy2DArrayToArray;
+  ptrDispatchTable->hipExtLaunchKernelBatch_fn = hip::hipExtLaunchKernelBatch;
+  ptrDispatchTable->hipExtGraphSave_fn = hip::hipExtGraphSave;
+  ptrDispatchTable->hipExtGraphLoad_fn = hip::hipExtGraphLoad;
+  ptrDispatchTable->hipStreamBatchMemOp_fn = hip::hipStreamBatchMemOp;
 }
 
 #if HIP_ROCPROFILER_REGISTER > 0
@@ -1834,6 +1845,10 @@ HIP_ENFORCE_ABI(HipDispatchTable, hipMemcpyAtoA_fn, 448)
 HIP_ENFORCE_ABI(HipDispatchTable, hipMemcpyAtoHAsync_fn, 449)
 HIP_ENFORCE_ABI(HipDispatchTable, hipMemcpyHtoAAsync_fn, 450)
 HIP_ENFORCE_ABI(HipDispatchTable, hipMemcpy2DArrayToArray_fn, 451)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtLaunchKernelBatch_fn, 452)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtGraphSave_fn, 453)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtGraphLoad_fn, 454)
+HIP_ENFORCE_ABI(HipDispatchTable, hipStreamBatchMemOp_fn, 455)
 
 
 // if HIP_ENFORCE_ABI entries are added for each new function pointer in the table, the number below
@@ -1842,9 +1857,9 @@ HIP_ENFORCE_ABI(HipDispatchTable, hipMemcpy2DArrayToArray_fn, 451)
 //  HIP_ENFORCE_ABI(<table>, <functor>, 8)
 //
 //  HIP_ENFORCE_ABI_VERSIONING(<table>, 9) <- 8 + 1 = 9
-HIP_ENFORCE_ABI_VERSIONING(HipDispatchTable, 452)
+HIP_ENFORCE_ABI_VERSIONING(HipDispatchTable, 456)
 
-static_assert(HIP_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && HIP_RUNTIME_API_TABLE_STEP_VERSION == 3,
+static_assert(HIP_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && HIP_RUNTIME_API_TABLE_STEP_VERSION == 6,
               "If you get this error, add new HIP_ENFORCE_ABI(...) code for the new function "
               "pointers and then update this check so it is true");
 #endif
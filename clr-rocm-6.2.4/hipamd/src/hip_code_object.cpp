@@ -30,6 +30,9 @@ THE SOFTWARE.
 #include "hip_internal.hpp"
 #include "platform/program.hpp"
 #include <elf/elf.hpp>
+#if defined(HIP_SUPPORT_ZSTD_UNBUNDLER)
+#include <zstd.h>
+#endif
 #include "comgrctx.hpp"
 namespace hip {
 hipError_t ihipFree(void* ptr);
@@ -79,6 +82,10 @@ struct __ClangOffloadBundleCompressedHeader {
   uint64_t Hash;
   const char compressedBinarydesc[1];
 };
+
+// Compressed bundle layout handled by the runtime, others are unbundled by comgr
+constexpr uint16_t kOffloadBundleCompressedVersion = 2;
+constexpr uint16_t kOffloadBundleCompressionZstd = 1;
 }  // namespace
 
 bool CodeObject::IsClangOffloadMagicBundle(const void* data, bool& isCompressed) {
@@ -99,6 +106,83 @@ bool CodeObject::IsClangOffloadMagicBundle(const void* data, bool& isCompressed)
 
 uint64_t CodeObject::ElfSize(const void* emi) { return amd::Elf::getElfSize(emi); }
 
+std::string CodeObject::ContentDigest(const void* data, size_t size) {
+  // SHA-256 (FIPS 180-4)
+  static constexpr uint32_t kRound[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+      0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+      0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+      0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+      0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+      0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+      0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+      0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+      0xc67178f2};
+  uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+  auto rotr = [](uint32_t x, uint32_t n) { return (x >> n) | (x << (32 - n)); };
+  auto compress = [&](const uint8_t* block) {
+    uint32_t w[64];
+    for (uint32_t i = 0; i < 16; ++i) {
+      w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) |
+             (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+             (static_cast<uint32_t>(block[4 * i + 2]) << 8) | block[4 * i + 3];
+    }
+    for (uint32_t i = 16; i < 64; ++i) {
+      uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (uint32_t i = 0; i < 64; ++i) {
+      uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                    kRound[i] + w[i];
+      uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+  };
+
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    compress(ptr + i);
+  }
+  // Pad the tail with 0x80, zeros and the message length in bits, big endian
+  uint8_t tail[128] = {};
+  const size_t rest = size - i;
+  std::memcpy(tail, ptr + i, rest);
+  tail[rest] = 0x80;
+  const size_t tail_size = (rest < 56) ? 64 : 128;
+  const uint64_t bits = static_cast<uint64_t>(size) * 8;
+  for (uint32_t j = 0; j < 8; ++j) {
+    tail[tail_size - 1 - j] = static_cast<uint8_t>(bits >> (8 * j));
+  }
+  for (size_t j = 0; j < tail_size; j += 64) {
+    compress(tail + j);
+  }
+
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string digest(64, '0');
+  for (uint32_t j = 0; j < 32; ++j) {
+    const uint8_t byte = static_cast<uint8_t>(state[j / 4] >> (24 - 8 * (j % 4)));
+    digest[2 * j] = kHex[byte >> 4];
+    digest[2 * j + 1] = kHex[byte & 0xf];
+  }
+  return digest;
+}
+
 static bool getProcName(uint32_t EFlags, std::string& proc_name, bool& xnackSupported,
                         bool& sramEccSupported) {
   switch (EFlags & EF_AMDGPU_MACH) {
@@ -599,6 +683,195 @@ hipError_t CodeObject::extractCodeObjectFromFatBinary(
   }
 }
 
+#if defined(HIP_SUPPORT_ZSTD_UNBUNDLER)
+// Code object entry of a compressed bundle, filled while the stream is decompressed
+struct CompressedBundleEntry {
+  uint64_t offset;              // Offset in the decompressed bundle
+  uint64_t size;                // Size of the code object
+  char* data;                   // Extracted code object, deleted in fatbin's destructor
+};
+
+// Parses the bundle index from the decompressed head of the bundle. ready is false if more
+// data is needed, entry_of_device maps every device to an index in entries.
+static hipError_t parseCompressedBundleIndex(const std::vector<char>& head,
+    const std::vector<std::string>& agent_triple_target_ids,
+    std::vector<CompressedBundleEntry>& entries, std::vector<size_t>& entry_of_device,
+    bool& ready) {
+  ready = false;
+  const size_t desc_size = 3 * sizeof(uint64_t);
+  size_t pos = offsetof(__ClangOffloadBundleUncompressedHeader, desc);
+  if (head.size() < pos) {
+    return hipSuccess;
+  }
+  if (std::memcmp(head.data(), kOffloadBundleUncompressedMagicStr,
+                  kOffloadBundleUncompressedMagicStrSize - 1) != 0) {
+    LogError("Decompressed bundle doesn't start with the offload bundle magic");
+    return hipErrorInvalidKernelFile;
+  }
+
+  uint64_t num_code_objs = 0;
+  std::memcpy(&num_code_objs, head.data() + offsetof(__ClangOffloadBundleUncompressedHeader,
+              numOfCodeObjects), sizeof(num_code_objs));
+  entries.clear();
+  entry_of_device.assign(agent_triple_target_ids.size(), entries.max_size());
+  for (uint64_t i = 0; i < num_code_objs; ++i) {
+    if (head.size() < pos + desc_size) {
+      return hipSuccess;
+    }
+    uint64_t desc_fields[3];  // offset, size, bundleEntryIdSize
+    std::memcpy(desc_fields, head.data() + pos, desc_size);
+    const uint64_t offset = desc_fields[0];
+    const uint64_t size = desc_fields[1];
+    const uint64_t id_size = desc_fields[2];
+    if (head.size() < pos + desc_size + id_size) {
+      return hipSuccess;
+    }
+    std::string co_triple_target_id(head.data() + pos + desc_size, id_size);
+    pos += desc_size + id_size;
+
+    // Code objects before V4 need the ELF to get the target ID, leave those to comgr
+    if (size == 0 || !consume(co_triple_target_id, kOffloadKindHipv4_)) {
+      continue;
+    }
+    for (size_t dev = 0; dev < agent_triple_target_ids.size(); ++dev) {
+      if (entry_of_device[dev] != entries.max_size()) continue;
+      if (isCodeObjectCompatibleWithDevice(co_triple_target_id, agent_triple_target_ids[dev])) {
+        if (entries.empty() || entries.back().offset != offset) {
+          entries.push_back({offset, size, nullptr});
+        }
+        entry_of_device[dev] = entries.size() - 1;
+      }
+    }
+  }
+
+  for (size_t dev = 0; dev < agent_triple_target_ids.size(); ++dev) {
+    if (entry_of_device[dev] == entries.max_size()) {
+      LogPrintfInfo("No V4 code object for %s in the bundle index, fall back to comgr",
+                    agent_triple_target_ids[dev].c_str());
+      return hipErrorNotSupported;
+    }
+  }
+  ready = true;
+  return hipSuccess;
+}
+
+// Copies the part of the decompressed chunk at stream_offset which overlaps the entries
+static void copyCompressedBundleChunk(const char* chunk, size_t chunk_size,
+                                      uint64_t stream_offset,
+                                      std::vector<CompressedBundleEntry>& entries) {
+  for (auto& entry : entries) {
+    uint64_t begin = std::max(entry.offset, stream_offset);
+    uint64_t end = std::min(entry.offset + entry.size, stream_offset + chunk_size);
+    if (begin < end) {
+      std::memcpy(entry.data + (begin - entry.offset), chunk + (begin - stream_offset),
+                  end - begin);
+    }
+  }
+}
+#endif
+
+// ================================================================================================
+hipError_t CodeObject::extractCodeObjectFromCompressedBundle(const void* data,
+    const std::vector<std::string>& agent_triple_target_ids,
+    std::vector<std::pair<const void*, size_t>>& code_objs) {
+#if defined(HIP_SUPPORT_ZSTD_UNBUNDLER)
+  const auto obheader = reinterpret_cast<const __ClangOffloadBundleCompressedHeader*>(data);
+  const size_t header_size = offsetof(__ClangOffloadBundleCompressedHeader, compressedBinarydesc);
+  if (obheader->versionNumber != kOffloadBundleCompressedVersion ||
+      obheader->compressionMethod != kOffloadBundleCompressionZstd ||
+      obheader->totalSize <= header_size) {
+    return hipErrorNotSupported;
+  }
+
+  ZSTD_DCtx* dctx = ZSTD_createDCtx();
+  if (dctx == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+
+  // Staging buffer of the decompression stream, reused by the next bundles on this thread
+  thread_local std::vector<char> staging(ZSTD_DStreamOutSize());
+
+  ZSTD_inBuffer input = {obheader->compressedBinarydesc, obheader->totalSize - header_size, 0};
+  std::vector<char> head;
+  std::vector<CompressedBundleEntry> entries;
+  std::vector<size_t> entry_of_device;
+  bool index_ready = false;
+  uint64_t stream_offset = 0;
+  uint64_t end_offset = 0;
+  hipError_t hip_status = hipSuccess;
+
+  while (true) {
+    ZSTD_outBuffer output = {staging.data(), staging.size(), 0};
+    size_t ret = ZSTD_decompressStream(dctx, &output, &input);
+    if (ZSTD_isError(ret)) {
+      LogPrintfError("ZSTD_decompressStream failed: %s", ZSTD_getErrorName(ret));
+      hip_status = hipErrorInvalidKernelFile;
+      break;
+    }
+    const bool stream_done = (ret == 0) || (input.pos == input.size && output.pos == 0);
+
+    const char* chunk = staging.data();
+    size_t chunk_size = output.pos;
+    if (!index_ready) {
+      // Accumulate the head of the bundle until the whole index is available
+      head.insert(head.end(), staging.data(), staging.data() + output.pos);
+      hip_status = parseCompressedBundleIndex(head, agent_triple_target_ids, entries,
+                                              entry_of_device, index_ready);
+      if (hip_status != hipSuccess) {
+        break;
+      }
+      if (!index_ready) {
+        if (stream_done) {
+          hip_status = hipErrorInvalidKernelFile;
+          break;
+        }
+        continue;
+      }
+      for (auto& entry : entries) {
+        entry.data = new char[entry.size];
+        end_offset = std::max(end_offset, entry.offset + entry.size);
+      }
+      chunk = head.data();
+      chunk_size = head.size();
+    }
+
+    copyCompressedBundleChunk(chunk, chunk_size, stream_offset, entries);
+    stream_offset += chunk_size;
+    // Everything past the last needed code object is never decompressed
+    if (stream_offset >= end_offset) {
+      break;
+    }
+    if (stream_done) {
+      LogError("Compressed bundle ends before its code objects");
+      hip_status = hipErrorInvalidKernelFile;
+      break;
+    }
+  }
+  ZSTD_freeDCtx(dctx);
+
+  if (hip_status != hipSuccess) {
+    for (auto& entry : entries) {
+      delete[] entry.data;
+    }
+    return hip_status;
+  }
+
+  code_objs.clear();
+  code_objs.reserve(agent_triple_target_ids.size());
+  for (size_t dev = 0; dev < agent_triple_target_ids.size(); ++dev) {
+    const auto& entry = entries[entry_of_device[dev]];
+    code_objs.push_back(std::make_pair(reinterpret_cast<const void*>(entry.data),
+                                       static_cast<size_t>(entry.size)));
+  }
+  LogPrintfInfo("Decompressed %zu of %u bytes of the compressed bundle %p for %zu code objects",
+                static_cast<size_t>(stream_offset), obheader->uncompressedBinarySize, data,
+                entries.size());
+  return hipSuccess;
+#else
+  return hipErrorNotSupported;
+#endif
+}
+
 // ================================================================================================
 size_t CodeObject::getFatbinSize(const void* data, const bool isCompressed) {
   if (isCompressed) {
@@ -632,6 +905,14 @@ hipError_t CodeObject::extractCodeObjectFromFatBinaryUsingComgr(
     return hipErrorInvalidKernelFile;
   }
 
+  if (isCompressed && HIP_STREAMING_UNBUNDLER) {
+    hipStatus = extractCodeObjectFromCompressedBundle(data, agent_triple_target_ids, code_objs);
+    if (hipStatus != hipErrorNotSupported) {
+      return hipStatus;
+    }
+    hipStatus = hipSuccess;
+  }
+
   if (size == 0) size = getFatbinSize(data, isCompressed);
 
   amd_comgr_data_t dataCodeObj{0};
@@ -938,6 +1219,7 @@ hipError_t CodeObject::extractCodeObjectFromFatBinaryUsingComgr(
 
 hipError_t DynCO::loadCodeObject(const char* fname, const void* image) {
   amd::ScopedLock lock(dclock_);
+  uint64_t start = amd::Os::timeNanos();
 
   // Number of devices = 1 in dynamic code object
   fb_info_ = new FatBinaryInfo(fname, image);
@@ -953,6 +1235,9 @@ hipError_t DynCO::loadCodeObject(const char* fname, const void* image) {
   // Define Global functions
   IHIP_RETURN_ONFAIL(populateDynGlobalFuncs());
 
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Module load took %lu us, %zu funcs, %zu vars "
+          "registered, %zu symbols deferred", (amd::Os::timeNanos() - start) / 1000,
+          functions_.size(), vars_.size(), symbols_.size());
   return hipSuccess;
 }
 
@@ -982,13 +1267,13 @@ hipError_t DynCO::getDeviceVar(DeviceVar** dvar, std::string var_name) {
 
   CheckDeviceIdMatch();
 
-  auto it = vars_.find(var_name);
-  if (it == vars_.end()) {
+  Var* var = findDynVar(var_name);
+  if (var == nullptr) {
     LogPrintfError("Cannot find the Var: %s ", var_name.c_str());
     return hipErrorNotFound;
   }
 
-  hipError_t err = it->second->getDeviceVar(dvar, device_id_, module());
+  hipError_t err = var->getDeviceVar(dvar, device_id_, module());
   return err;
 }
 
@@ -1001,14 +1286,48 @@ hipError_t DynCO::getDynFunc(hipFunction_t* hfunc, std::string func_name) {
     return hipErrorInvalidValue;
   }
 
-  auto it = functions_.find(func_name);
-  if (it == functions_.end()) {
+  Function* func = findDynFunc(func_name);
+  if (func == nullptr) {
     LogPrintfError("Cannot find the function: %s ", func_name.c_str());
     return hipErrorNotFound;
   }
 
   /* See if this could be solved */
-  return it->second->getDynFunc(hfunc, module());
+  return func->getDynFunc(hfunc, module());
+}
+
+Function* DynCO::findDynFunc(const std::string& func_name) {
+  auto it = functions_.find(func_name);
+  if (it != functions_.end()) {
+    return it->second;
+  }
+
+  auto sym = symbols_.find(func_name);
+  if (sym == symbols_.end() || sym->second != kSymbolFunc) {
+    return nullptr;
+  }
+  symbols_.erase(sym);
+
+  Function* func = new Function(func_name);
+  functions_.insert(std::make_pair(func_name, func));
+  return func;
+}
+
+Var* DynCO::findDynVar(const std::string& var_name) {
+  auto it = vars_.find(var_name);
+  if (it != vars_.end()) {
+    return it->second;
+  }
+
+  auto sym = symbols_.find(var_name);
+  if (sym == symbols_.end() || sym->second != kSymbolVar) {
+    return nullptr;
+  }
+  symbols_.erase(sym);
+
+  Var* var = new Var(var_name, Var::DeviceVarKind::DVK_Variable, 0, 0, 0, nullptr);
+  vars_.insert(std::make_pair(var_name, var));
+  return var;
 }
 
 hipError_t DynCO::initDynManagedVars(const std::string& managedVar) {
@@ -1078,15 +1397,26 @@ hipError_t DynCO::populateDynGlobalVars() {
     return hipErrorSharedObjectSymbolNotFound;
   }
 
+  symbols_.reserve(symbols_.size() + var_names.size());
   for (auto& elem : var_names) {
-    vars_.insert(
-        std::make_pair(elem, new Var(elem, Var::DeviceVarKind::DVK_Variable, 0, 0, 0, nullptr)));
+    if (HIP_LAZY_MODULE_SYMBOLS) {
+      symbols_.insert(std::make_pair(elem, kSymbolVar));
+    } else {
+      vars_.insert(
+          std::make_pair(elem, new Var(elem, Var::DeviceVarKind::DVK_Variable, 0, 0, 0, nullptr)));
+    }
   }
 
+  // Managed variables must be backed by managed memory at load time, so they are
+  // always materialized here
   for (auto& elem : var_names) {
     if (elem.find(managedVarExt) != std::string::npos) {
       std::string managedVar = elem;
       managedVar.erase(managedVar.length() - managedVarExt.length(), managedVarExt.length());
+      if (findDynVar(managedVar) == nullptr) {
+        LogPrintfError("Cannot find the managed Var: %s ", managedVar.c_str());
+        return hipErrorNotFound;
+      }
       err = initDynManagedVars(managedVar);
     }
   }
@@ -1106,6 +1436,14 @@ hipError_t DynCO::populateDynGlobalFuncs() {
     return hipErrorSharedObjectSymbolNotFound;
   }
 
+  if (HIP_LAZY_MODULE_SYMBOLS) {
+    symbols_.reserve(symbols_.size() + func_names.size());
+    for (auto& elem : func_names) {
+      symbols_.insert(std::make_pair(elem, kSymbolFunc));
+    }
+    return hipSuccess;
+  }
+
   for (auto& elem : func_names) {
     functions_.insert(std::make_pair(elem, new Function(elem)));
   }
@@ -1227,6 +1565,17 @@ const char* StatCO::getStatFuncName(const void* hostFunction) {
   return it->second->name().c_str();
 }
 
+const void* StatCO::getStatHostFunction(const std::string& name) {
+  amd::ScopedLock lock(sclock_);
+
+  for (const auto& it : functions_) {
+    if (it.second->name() == name) {
+      return it.first;
+    }
+  }
+  return nullptr;
+}
+
 hipError_t StatCO::getStatFunc(hipFunction_t* hfunc, const void* hostFunction, int deviceId) {
   amd::ScopedLock lock(sclock_);
 
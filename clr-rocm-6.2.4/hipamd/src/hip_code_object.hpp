@@ -63,6 +63,9 @@ class CodeObject {
 
   static uint64_t ElfSize(const void* emi);
 
+  // SHA-256 of a binary as 64 hex digits, used to identify identical bundles
+  static std::string ContentDigest(const void* data, size_t size);
+
   static bool IsClangOffloadMagicBundle(const void* data, bool& isCompressed);
 
   // Return size of fat bin
@@ -95,6 +98,13 @@ class CodeObject {
   static hipError_t extractCodeObjectFromFatBinary(const void*,
                     const std::vector<std::string>&,
                     std::vector<std::pair<const void*, size_t>>&);
+
+  //Given a compressed bundle, reads the bundle index from the head of the decompressed
+  //stream and only decompresses up to the end of the code objects of the devices.
+  //Returns hipErrorNotSupported if the bundle has to go through comgr.
+  static hipError_t extractCodeObjectFromCompressedBundle(const void* data,
+                    const std::vector<std::string>& agent_triple_target_ids,
+                    std::vector<std::pair<const void*, size_t>>& code_objs);
  
   CodeObject() {}
 private:
@@ -143,10 +153,19 @@ private:
   std::unordered_map<std::string, Function*> functions_;
   std::unordered_map<std::string, Var*> vars_;
 
+  //Symbol index of the code object, built at module load. With HIP_LAZY_MODULE_SYMBOLS
+  //the Function/Var objects are only created on the first lookup of the symbol
+  enum SymbolKind { kSymbolFunc, kSymbolVar };
+  std::unordered_map<std::string, SymbolKind> symbols_;
+
   //Populate Global Vars/Funcs from an code object(@ module_load)
   hipError_t populateDynGlobalFuncs();
   hipError_t populateDynGlobalVars();
   hipError_t initDynManagedVars(const std::string& managedVar);
+
+  //Returns the registered Function/Var for the name, materializing it from symbols_
+  Function* findDynFunc(const std::string& func_name);
+  Var* findDynVar(const std::string& var_name);
 };
 
 //Static Code Object
@@ -168,6 +187,7 @@ public:
 
   //Retrive Vars/Funcs for a given hostSidePtr(const void*), unless stated otherwise.
   const char* getStatFuncName(const void* hostFunction);
+  const void* getStatHostFunction(const std::string& name);
   hipError_t getStatFunc(hipFunction_t* hfunc, const void* hostFunction, int deviceId);
   hipError_t getStatFuncAttr(hipFuncAttributes* func_attr, const void* hostFunction, int deviceId);
   hipError_t getStatGlobalVar(const void* hostVar, int deviceId, hipDeviceptr_t* dev_ptr,
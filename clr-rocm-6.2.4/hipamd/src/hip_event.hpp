@@ -23,6 +23,7 @@
 
 #include "hip_internal.hpp"
 #include "thread/monitor.hpp"
+#include "hip_event_ipc.hpp"
 
 // Internal structure for stream callback handler
 namespace hip {
@@ -68,15 +69,8 @@ class LaunchHostFuncCallback : public StreamCallback {
 void CL_CALLBACK ihipStreamCallback(cl_event event, cl_int command_exec_status, void* user_data);
 
 
-#define IPC_SIGNALS_PER_EVENT 32
-typedef struct ihipIpcEventShmem_s {
-  std::atomic<int> owners;
-  std::atomic<int> owners_device_id;
-  std::atomic<int> owners_process_id;
-  std::atomic<int> read_index;
-  std::atomic<int> write_index;
-  uint32_t signal[IPC_SIGNALS_PER_EVENT];
-} ihipIpcEventShmem_t;
+//! Wait until the signal recorded before prev_read_idx completes or is recycled
+void ihipIpcEventWait(ihipIpcEventShmem_t* shmem, int prev_read_idx);
 
 class EventMarker : public amd::Marker {
  public:
@@ -200,6 +194,10 @@ class IPCEvent : public Event {
     void setipcname(const char* name) { ipc_name_ = std::string(name); }
   };
   ihipIpcEvent_t ipc_evt_;
+  amd::Monitor notifyLock_{"IPC event notify lock"};
+  uint32_t pendingNotifies_ = 0;  //!< Completion callbacks, which access the shmem
+
+  static void CL_CALLBACK notifyCompletion(cl_event event, cl_int status, void* user_data);
 
  public:
   ~IPCEvent() {
@@ -207,6 +205,12 @@ class IPCEvent : public Event {
       int owners = --ipc_evt_.ipc_shmem_->owners;
       // Make sure event is synchronized
       hipError_t status = synchronize();
+      {
+        amd::ScopedLock lock(notifyLock_);
+        while (pendingNotifies_ != 0) {
+          notifyLock_.wait();
+        }
+      }
       status  = ihipHostUnregister(&ipc_evt_.ipc_shmem_->signal);
       if (!amd::Os::MemoryUnmapFile(ipc_evt_.ipc_shmem_, sizeof(hip::ihipIpcEventShmem_t))) {
         // print hipErrorInvalidHandle;
@@ -32,6 +32,56 @@ namespace hip {
 
 hipError_t ihipEventCreateWithFlags(hipEvent_t* event, unsigned flags);
 
+namespace {
+// Upper bound of a blocked wait, so a waiter still makes progress if the recording process
+// exits before its completion callback wakes the waiters
+constexpr uint64_t kIpcEventMaxBlockNs = 1000 * 1000;
+
+// IPC event wait latency counters of this process
+struct IpcEventWaitStats {
+  std::atomic<uint64_t> waits{0};    //!< Waits, which found the signal busy
+  std::atomic<uint64_t> blocked{0};  //!< Waits, which exceeded the spin budget
+  std::atomic<uint64_t> waitNs{0};   //!< Total time spent in the waits
+} ipcWaitStats;
+
+// Waits on the shared block until done() returns true and accounts the wait latency
+template <typename Pred>
+void IpcEventWaitFor(ihipIpcEventShmem_t* shmem, Pred done) {
+  if (done()) {
+    return;
+  }
+  const uint64_t start = amd::Os::timeNanos();
+  bool blocked = ihipIpcEventWaitFor(shmem, static_cast<uint64_t>(HIP_IPC_EVENT_SPIN_US) * 1000,
+                                     kIpcEventMaxBlockNs, done);
+  const uint64_t waitNs = amd::Os::timeNanos() - start;
+  uint64_t waits = ++ipcWaitStats.waits;
+  uint64_t totalNs = ipcWaitStats.waitNs += waitNs;
+  uint64_t numBlocked = blocked ? ++ipcWaitStats.blocked : ipcWaitStats.blocked.load();
+  if ((waits % 1024) == 0) {
+    ClPrint(amd::LOG_INFO, amd::LOG_WAIT,
+            "IPC event waits: %lu, blocked: %lu, average latency: %lu ns", waits, numBlocked,
+            totalNs / waits);
+  }
+}
+}  // namespace
+
+void ihipIpcEventWait(ihipIpcEventShmem_t* shmem, int prev_read_idx) {
+  int offset = prev_read_idx % IPC_SIGNALS_PER_EVENT;
+  IpcEventWaitFor(shmem, [shmem, prev_read_idx, offset]() {
+    return !((shmem->read_index < prev_read_idx + IPC_SIGNALS_PER_EVENT) &&
+             (shmem->signal[offset] != 0));
+  });
+}
+
+void CL_CALLBACK IPCEvent::notifyCompletion(cl_event event, cl_int status, void* user_data) {
+  IPCEvent* ipcEvent = reinterpret_cast<IPCEvent*>(user_data);
+  ihipIpcEventNotify(ipcEvent->ipc_evt_.ipc_shmem_);
+  amd::ScopedLock lock(ipcEvent->notifyLock_);
+  if (--ipcEvent->pendingNotifies_ == 0) {
+    ipcEvent->notifyLock_.notifyAll();
+  }
+}
+
 bool IPCEvent::createIpcEventShmemIfNeeded() {
   if (ipc_evt_.ipc_shmem_) {
     // ipc_shmem_ already created, no need to create it again
@@ -58,12 +108,7 @@ bool IPCEvent::createIpcEventShmemIfNeeded() {
   close(temp_fd);
 #endif
 
-  ipc_evt_.ipc_shmem_->owners = 1;
-  ipc_evt_.ipc_shmem_->read_index = -1;
-  ipc_evt_.ipc_shmem_->write_index = 0;
-  for (uint32_t sig_idx = 0; sig_idx < IPC_SIGNALS_PER_EVENT; ++sig_idx) {
-    ipc_evt_.ipc_shmem_->signal[sig_idx] = 0;
-  }
+  ihipIpcEventShmemInit(ipc_evt_.ipc_shmem_);
 
   // device sets 0 to this ptr when the ipc event is completed
   hipError_t status = ihipHostRegister(&ipc_evt_.ipc_shmem_->signal,
@@ -91,11 +136,7 @@ hipError_t IPCEvent::synchronize() {
   if (ipc_evt_.ipc_shmem_) {
     int prev_read_idx = ipc_evt_.ipc_shmem_->read_index;
     if (prev_read_idx >= 0) {
-      int offset = (prev_read_idx % IPC_SIGNALS_PER_EVENT);
-      while ((ipc_evt_.ipc_shmem_->read_index < prev_read_idx + IPC_SIGNALS_PER_EVENT) &&
-             (ipc_evt_.ipc_shmem_->signal[offset] != 0)) {
-        amd::Os::sleep(1);
-      }
+      ihipIpcEventWait(ipc_evt_.ipc_shmem_, prev_read_idx);
     }
   }
   return hipSuccess;
@@ -156,9 +197,8 @@ hipError_t IPCEvent::enqueueRecordCommand(hipStream_t stream, amd::Command* comm
     createIpcEventShmemIfNeeded();
     int write_index = ipc_evt_.ipc_shmem_->write_index++;
     int offset = write_index % IPC_SIGNALS_PER_EVENT;
-    while (ipc_evt_.ipc_shmem_->signal[offset] != 0) {
-      amd::Os::sleep(1);
-    }
+    ihipIpcEventShmem_t* shmem = ipc_evt_.ipc_shmem_;
+    IpcEventWaitFor(shmem, [shmem, offset]() { return shmem->signal[offset] == 0; });
     // Lock signal.
     ipc_evt_.ipc_shmem_->signal[offset] = 1;
     ipc_evt_.ipc_shmem_->owners_device_id = deviceId();
@@ -174,6 +214,21 @@ hipError_t IPCEvent::enqueueRecordCommand(hipStream_t stream, amd::Command* comm
       return status;
     }
 
+    // Wake the waiting processes after the device cleared the signal
+    amd::Command* marker = new amd::Marker(*hip::getStream(stream), false);
+    {
+      amd::ScopedLock lock(notifyLock_);
+      pendingNotifies_++;
+    }
+    if (!marker->setCallback(CL_COMPLETE, notifyCompletion, this)) {
+      amd::ScopedLock lock(notifyLock_);
+      pendingNotifies_--;
+      marker->release();
+      return hipErrorInvalidHandle;
+    }
+    marker->enqueue();
+    marker->release();
+
     // Update read index to indicate new signal.
     int expected = write_index - 1;
     while (!ipc_evt_.ipc_shmem_->read_index.compare_exchange_weak(expected, write_index)) {
@@ -204,6 +259,17 @@ hipError_t IPCEvent::OpenHandle(ihipIpcEventHandle_t* handle) {
     return hipErrorInvalidValue;
   }
 
+  if (!ihipIpcEventShmemCompatible(ipc_evt_.ipc_shmem_)) {
+    // The event was created by a runtime with another layout of the shared block
+    LogPrintfError("IPC event %s has shared layout 0x%x of %u bytes, expected 0x%x of %zu bytes",
+                   ipc_evt_.ipc_name_.c_str(), ipc_evt_.ipc_shmem_->version,
+                   ipc_evt_.ipc_shmem_->size, kIpcEventShmemVersion,
+                   sizeof(ihipIpcEventShmem_t));
+    amd::Os::MemoryUnmapFile(ipc_evt_.ipc_shmem_, sizeof(ihipIpcEventShmem_t));
+    ipc_evt_.ipc_shmem_ = nullptr;
+    return hipErrorInvalidValue;
+  }
+
   if (amd::Os::getProcessId() == ipc_evt_.ipc_shmem_->owners_process_id.load()) {
     // If this is in the same process, return error.
     return hipErrorInvalidContext;
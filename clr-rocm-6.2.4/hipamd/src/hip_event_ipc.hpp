@@ -0,0 +1,106 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "top.hpp"
+#include "os/os.hpp"
+
+namespace hip {
+
+#define IPC_SIGNALS_PER_EVENT 32
+
+//! Layout version of the shared block. The upper half keeps it apart from the owner count, which
+//! was the first field of the unversioned layout.
+constexpr uint32_t kIpcEventShmemVersion = 0x48490002;
+
+typedef struct ihipIpcEventShmem_s {
+  uint32_t version;  //!< kIpcEventShmemVersion of the creating process
+  uint32_t size;     //!< Size of the block in the creating process
+  std::atomic<int> owners;
+  std::atomic<int> owners_device_id;
+  std::atomic<int> owners_process_id;
+  std::atomic<int> read_index;
+  std::atomic<int> write_index;
+  uint32_t signal[IPC_SIGNALS_PER_EVENT];
+  std::atomic<uint32_t> completion_seq;  //!< Futex word, bumped after each completed record
+  std::atomic<uint32_t> waiters;         //!< Number of threads blocked on completion_seq
+} ihipIpcEventShmem_t;
+
+//! Initializes a newly created shared block
+inline void ihipIpcEventShmemInit(ihipIpcEventShmem_t* shmem) {
+  shmem->owners = 1;
+  shmem->read_index = -1;
+  shmem->write_index = 0;
+  for (uint32_t sig_idx = 0; sig_idx < IPC_SIGNALS_PER_EVENT; ++sig_idx) {
+    shmem->signal[sig_idx] = 0;
+  }
+  shmem->completion_seq = 0;
+  shmem->waiters = 0;
+  shmem->size = sizeof(ihipIpcEventShmem_t);
+  shmem->version = kIpcEventShmemVersion;
+}
+
+//! Returns true if the shared block was created with the layout of this process
+inline bool ihipIpcEventShmemCompatible(const ihipIpcEventShmem_t* shmem) {
+  return (shmem->version == kIpcEventShmemVersion) &&
+         (shmem->size == sizeof(ihipIpcEventShmem_t));
+}
+
+//! Spins for spinNs and then blocks on the completion futex of the shared block until done()
+//! returns true. The recorder bumps completion_seq after the device cleared a signal, so a wait
+//! with a stale sequence number returns immediately and no wakeup is lost. Each blocked wait is
+//! bounded by maxBlockNs. Returns true if the wait blocked.
+template <typename Pred>
+bool ihipIpcEventWaitFor(ihipIpcEventShmem_t* shmem, uint64_t spinNs, uint64_t maxBlockNs,
+                         Pred done) {
+  const uint64_t spinEnd = amd::Os::timeNanos() + spinNs;
+  bool blocked = false;
+  while (true) {
+    uint32_t seq = shmem->completion_seq.load(std::memory_order_acquire);
+    if (done()) {
+      break;
+    }
+    if (amd::Os::timeNanos() < spinEnd) {
+      amd::Os::spinPause();
+      continue;
+    }
+    blocked = true;
+    shmem->waiters++;
+    amd::Os::waitOnAddress(reinterpret_cast<volatile uint32_t*>(&shmem->completion_seq), seq,
+                           maxBlockNs);
+    shmem->waiters--;
+  }
+  return blocked;
+}
+
+//! Bumps the completion sequence and wakes the waiters of all the processes
+inline void ihipIpcEventNotify(ihipIpcEventShmem_t* shmem) {
+  shmem->completion_seq.fetch_add(1, std::memory_order_release);
+  if (shmem->waiters.load() != 0) {
+    amd::Os::wakeOnAddress(reinterpret_cast<volatile uint32_t*>(&shmem->completion_seq));
+  }
+}
+
+}  // namespace hip
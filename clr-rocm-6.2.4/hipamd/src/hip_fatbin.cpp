@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 #include "hip_fatbin.hpp"
 
+#include <algorithm>
 #include <unordered_map>
 #include "hip_code_object.hpp"
 #include "hip_platform.hpp"
@@ -53,15 +54,23 @@ FatBinaryInfo::FatBinaryInfo(const char* fname, const void* image) : fdesc_(amd:
 FatBinaryInfo::~FatBinaryInfo() {
   // Different devices in the same model have the same binary_image_
   std::set<const void*> toDelete;
+  // The programs may still reference the images, so those are released after the programs
+  std::vector<const void*> toRelease;
   // Release per device fat bin info.
   for (auto* fbd: fatbin_dev_info_) {
     if (fbd != nullptr) {
-      if (fbd->binary_image_ && fbd->binary_offset_ == 0 && fbd->binary_image_ != image_) {
+      if (fbd->shared_image_) {
+        toRelease.push_back(fbd->binary_image_);
+      } else if (fbd->binary_image_ && fbd->binary_offset_ == 0 &&
+                 fbd->binary_image_ != image_) {
         toDelete.insert(fbd->binary_image_);
       }
       delete fbd;
     }
   }
+  for (auto itemData : toRelease) {
+    PlatformState::instance().ReleaseCodeObject(itemData);
+  }
   for (auto itemData : toDelete) {
     LogPrintfInfo("~FatBinaryInfo(%p) will delete binary_image_ %p", this, itemData);
     delete[] reinterpret_cast<const char*>(itemData);
@@ -481,13 +490,18 @@ hipError_t FatBinaryInfo::ExtractFatBinaryUsingCOMGR(const void *data,
       device_names.push_back(devices[dev_idx]->devices()[0]->isa().isaName());
     }
 
-    hip_status = CodeObject::extractCodeObjectFromFatBinaryUsingComgr(data, 0,
-      device_names, code_objs);
+    if (HIP_CODE_OBJECT_CACHE) {
+      hip_status = ExtractSharedCodeObjects(data, device_names, code_objs);
+    } else {
+      hip_status = CodeObject::extractCodeObjectFromFatBinaryUsingComgr(data, 0,
+        device_names, code_objs);
+    }
     if (hip_status == hipErrorNoBinaryForGpu || hip_status == hipSuccess) {
       for (size_t dev_idx = 0; dev_idx < devices.size(); ++dev_idx) {
         if (code_objs[dev_idx].first) {
           fatbin_dev_info_[devices[dev_idx]->deviceId()] =
               new FatBinaryDeviceInfo(code_objs[dev_idx].first, code_objs[dev_idx].second, 0);
+          fatbin_dev_info_[devices[dev_idx]->deviceId()]->shared_image_ = HIP_CODE_OBJECT_CACHE;
 
           fatbin_dev_info_[devices[dev_idx]->deviceId()]->program_ =
               new amd::Program(*devices[dev_idx]->asContext());
@@ -524,4 +538,81 @@ hipError_t FatBinaryInfo::ExtractFatBinaryUsingCOMGR(const void *data,
   return hip_status;
 }
 
+// ================================================================================================
+hipError_t FatBinaryInfo::ExtractSharedCodeObjects(const void* data,
+    const std::vector<std::string>& device_names,
+    std::vector<std::pair<const void*, size_t>>& code_objs) {
+  bool isCompressed = false;
+  if (!CodeObject::IsClangOffloadMagicBundle(data, isCompressed)) {
+    return hipErrorInvalidKernelFile;
+  }
+
+  PlatformState& platform = PlatformState::instance();
+  const size_t size = CodeObject::getFatbinSize(data, isCompressed);
+  const std::string bundle_key = CodeObject::ContentDigest(data, size) + ":";
+
+  // Take the code objects already extracted by other modules or devices from the cache
+  code_objs.assign(device_names.size(), std::make_pair(nullptr, 0));
+  std::vector<std::string> missing_names;
+  for (size_t dev_idx = 0; dev_idx < device_names.size(); ++dev_idx) {
+    code_objs[dev_idx].first = platform.AcquireCodeObject(bundle_key + device_names[dev_idx],
+                                                          &code_objs[dev_idx].second);
+    if (code_objs[dev_idx].first == nullptr &&
+        std::find(missing_names.begin(), missing_names.end(), device_names[dev_idx]) ==
+        missing_names.end()) {
+      missing_names.push_back(device_names[dev_idx]);
+    }
+  }
+
+  if (missing_names.empty()) {
+    return hipSuccess;
+  }
+
+  // Only unbundle the ISAs which aren't in the cache yet
+  std::vector<std::pair<const void*, size_t>> extracted;
+  hipError_t hip_status = CodeObject::extractCodeObjectFromFatBinaryUsingComgr(data, size,
+                                                                missing_names, extracted);
+  if (hip_status != hipSuccess && hip_status != hipErrorNoBinaryForGpu) {
+    for (auto& code_obj : code_objs) {
+      if (code_obj.first != nullptr) {
+        platform.ReleaseCodeObject(code_obj.first);
+      }
+    }
+    return hip_status;
+  }
+
+  // Image to key of the code objects added by this extraction
+  std::unordered_map<const void*, std::string> added_images;
+  for (size_t idx = 0; idx < missing_names.size(); ++idx) {
+    if (extracted[idx].first == nullptr) {
+      continue;
+    }
+    std::string key = bundle_key + missing_names[idx];
+    const void* image = nullptr;
+    // ISAs, which resolve to the same bundle entry, get the same buffer from the unbundler. It's
+    // registered once, under the key of the first ISA, and the others take references to it
+    bool acquire = false;
+    auto added_it = added_images.find(extracted[idx].first);
+    if (added_it != added_images.end()) {
+      key = added_it->second;
+      acquire = true;
+    } else {
+      image = platform.AddCodeObject(key, extracted[idx].first, extracted[idx].second);
+      added_images.emplace(extracted[idx].first, key);
+    }
+    for (size_t dev_idx = 0; dev_idx < device_names.size(); ++dev_idx) {
+      if (code_objs[dev_idx].first != nullptr || device_names[dev_idx] != missing_names[idx]) {
+        continue;
+      }
+      // AddCodeObject already took the reference for the first device
+      if (acquire) {
+        image = platform.AcquireCodeObject(key, &code_objs[dev_idx].second);
+      }
+      code_objs[dev_idx] = std::make_pair(image, extracted[idx].second);
+      acquire = true;
+    }
+  }
+  return hip_status;
+}
+
 } //namespace : hip
@@ -39,7 +39,7 @@ public:
   FatBinaryDeviceInfo (const void* binary_image, size_t binary_size, size_t binary_offset)
                       : binary_image_(binary_image), binary_size_(binary_size),
                         binary_offset_(binary_offset), program_(nullptr),
-                        add_dev_prog_(false), prog_built_(false) {}
+                        add_dev_prog_(false), prog_built_(false), shared_image_(false) {}
 
   ~FatBinaryDeviceInfo();
 
@@ -54,6 +54,7 @@ private:
   //Control Variables
   bool add_dev_prog_;
   bool prog_built_;
+  bool shared_image_;        // binary_image_ is owned by the shared code object cache
 };
 
 
@@ -82,6 +83,11 @@ public:
   hipError_t ExtractFatBinaryUsingCOMGR(const void* data,
                                               const std::vector<hip::Device*>& devices);
   hipError_t ExtractFatBinary(const std::vector<hip::Device*>& devices);
+
+  // Extracts code objects with comgr, sharing them through the PlatformState code object cache
+  hipError_t ExtractSharedCodeObjects(const void* data,
+                                      const std::vector<std::string>& device_names,
+                                      std::vector<std::pair<const void*, size_t>>& code_objs);
   hipError_t AddDevProgram(const int device_id);
   hipError_t BuildProgram(const int device_id);
 
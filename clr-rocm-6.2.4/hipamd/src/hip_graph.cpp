@@ -25,6 +25,10 @@
 #include "hip_platform.hpp"
 #include "hip_event.hpp"
 #include "hip_mempool_impl.hpp"
+#include "hip_graph_file.hpp"
+#include "hip_launch_batch.hpp"
+#include <deque>
+#include <map>
 
 namespace hip {
 extern std::unordered_map<GraphExec*, std::pair<hip::Stream*, bool>> GraphExecStatus_;
@@ -67,16 +71,8 @@ inline hipError_t ihipGraphAddNode(hip::GraphNode* graphNode, hip::Graph* graph,
     DuplicateDep.insert(pDependencies[i]);
     pDependencies[i]->AddEdge(graphNode);
   }
-  if (capture == false) {
-    {
-      amd::ScopedLock lock(g_streamSetLock);
-      for (auto stream : g_allCapturingStreams) {
-        if (stream->GetCaptureGraph() == graph) {
-          graph->AddManualNodeDuringCapture(graphNode);
-          break;
-        }
-      }
-    }
+  if (capture == false && graph->IsBeingCaptured()) {
+    graph->AddManualNodeDuringCapture(graphNode);
   }
   return hipSuccess;
 }
@@ -110,7 +106,7 @@ hipError_t ihipGraphAddKernelNode(hip::GraphNode** pGraphNode, hip::Graph* graph
     return hipErrorInvalidConfiguration;
   }
 
-  *pGraphNode = new hip::GraphKernelNode(pNodeParams, pNodeEvents);
+  *pGraphNode = new hip::GraphKernelNode(pNodeParams, pNodeEvents, graph->Arena());
   status = ihipGraphAddNode(*pGraphNode, graph, pDependencies, numDependencies, capture);
   return status;
 }
@@ -344,6 +340,56 @@ hipError_t capturehipModuleLaunchKernel(hipStream_t& stream, hipFunction_t& f, u
   return hipSuccess;
 }
 
+hipError_t capturehipExtLaunchKernelBatch(hipStream_t& stream,
+                                          const hipFunctionLaunchParams*& launchParamsList,
+                                          unsigned int& numKernels) {
+  ClPrint(amd::LOG_INFO, amd::LOG_API,
+          "[hipGraph] Current capture node ExtLaunchKernelBatch of %u kernels on stream : %p",
+          numKernels, stream);
+  if (!hip::isValid(stream)) {
+    return hipErrorContextIsDestroyed;
+  }
+  hip::Stream* s = reinterpret_cast<hip::Stream*>(stream);
+
+  // Validate every launch before the first node is added, so an invalid entry adds nothing
+  std::vector<hipKernelNodeParams> nodeParams(numKernels);
+  auto validate = [&](unsigned int i) {
+    const hipFunctionLaunchParams& launch = launchParamsList[i];
+    nodeParams[i].func = launch.function;
+    nodeParams[i].blockDim = {launch.blockDimX, launch.blockDimY, launch.blockDimZ};
+    nodeParams[i].extra = nullptr;
+    nodeParams[i].gridDim = {launch.gridDimX, launch.gridDimY, launch.gridDimZ};
+    nodeParams[i].kernelParams = launch.kernelParams;
+    nodeParams[i].sharedMemBytes = launch.sharedMemBytes;
+    hipError_t status = hip::GraphKernelNode::validateKernelParams(&nodeParams[i]);
+    if (status != hipSuccess) {
+      return status;
+    }
+    if (static_cast<size_t>(launch.gridDimX) * launch.blockDimX >
+            std::numeric_limits<uint32_t>::max() ||
+        static_cast<size_t>(launch.gridDimY) * launch.blockDimY >
+            std::numeric_limits<uint32_t>::max() ||
+        static_cast<size_t>(launch.gridDimZ) * launch.blockDimZ >
+            std::numeric_limits<uint32_t>::max()) {
+      return hipErrorInvalidConfiguration;
+    }
+    return hipSuccess;
+  };
+  // Each launch of the batch becomes a kernel node in the captured graph
+  auto add = [&](unsigned int i) {
+    hip::GraphNode* pGraphNode;
+    hipError_t status =
+        ihipGraphAddKernelNode(&pGraphNode, s->GetCaptureGraph(),
+                               s->GetLastCapturedNodes().data(),
+                               s->GetLastCapturedNodes().size(), &nodeParams[i]);
+    if (status == hipSuccess) {
+      s->SetLastCapturedNode(pGraphNode);
+    }
+    return status;
+  };
+  return hip::CaptureLaunchBatch(numKernels, validate, add);
+}
+
 hipError_t capturehipMemcpy3DAsync(hipStream_t& stream, const hipMemcpy3DParms*& p) {
   ClPrint(amd::LOG_INFO, amd::LOG_API, "[hipGraph] Current capture node Memcpy3D on stream : %p",
           stream);
@@ -924,6 +970,7 @@ hipError_t hipStreamBeginCapture_common(hipStream_t stream, hipStreamCaptureMode
     amd::ScopedLock lock(g_streamSetLock);
     g_allCapturingStreams.insert(s);
   }
+  s->GetCaptureGraph()->BeginCapture();
   return hipSuccess;
 }
 
@@ -1006,6 +1053,7 @@ hipError_t hipStreamEndCapture_common(hipStream_t stream, hip::Graph** pGraph) {
     g_allCapturingStreams.erase(
         std::find(g_allCapturingStreams.begin(), g_allCapturingStreams.end(), s));
   }
+  s->GetCaptureGraph()->EndCapture();
   // If capture was invalidated, due to a violation of the rules of stream capture
   if (s->GetCaptureStatus() == hipStreamCaptureStatusInvalidated) {
     *pGraph = nullptr;
@@ -2393,6 +2441,96 @@ hipError_t hipGraphExecHostNodeSetParams(hipGraphExec_t hGraphExec, hipGraphNode
   HIP_RETURN(reinterpret_cast<hip::GraphHostNode*>(clonedNode)->SetParams(pNodeParams));
 }
 
+// Pairs the nodes of the updated graph with the nodes of the executable graph. Nodes are matched
+// by identity first, since instantiated nodes are clones keeping the IDs of their source nodes,
+// then by type and the signature of the already matched dependencies and at last by type alone,
+// leaving edge changes to be patched into the executable graph. Type-only pairing is done only when
+// a single node of that type is left on both sides, since several candidates could pair unrelated
+// nodes. Returns the first node that couldn't be matched and sets the reason in result.
+hip::GraphNode* ihipGraphExecMatchNodes(
+    const std::vector<hip::GraphNode*>& newNodes, const std::vector<hip::GraphNode*>& execNodes,
+    std::unordered_map<hip::GraphNode*, hip::GraphNode*>& matches,
+    hipGraphExecUpdateResult& result) {
+  using Signature = std::pair<hipGraphNodeType, std::vector<hip::GraphNode*>>;
+  std::unordered_map<int, hip::GraphNode*> execById;
+  std::map<Signature, std::deque<hip::GraphNode*>> execBySignature;
+  std::map<hipGraphNodeType, std::deque<hip::GraphNode*>> execByType;
+  for (auto node : execNodes) {
+    execById[node->GetID()] = node;
+    std::vector<hip::GraphNode*> deps = node->GetDependencies();
+    std::sort(deps.begin(), deps.end());
+    execBySignature[Signature(node->GetType(), deps)].push_back(node);
+    execByType[node->GetType()].push_back(node);
+  }
+
+  std::unordered_set<hip::GraphNode*> used;
+  auto take = [&used](std::deque<hip::GraphNode*>& candidates) -> hip::GraphNode* {
+    while (!candidates.empty()) {
+      hip::GraphNode* candidate = candidates.front();
+      candidates.pop_front();
+      if (used.insert(candidate).second) {
+        return candidate;
+      }
+    }
+    return nullptr;
+  };
+
+  for (auto node : newNodes) {
+    auto it = execById.find(node->GetID());
+    if (it != execById.end() && it->second->GetType() == node->GetType()) {
+      matches[node] = it->second;
+      used.insert(it->second);
+    }
+  }
+  // New nodes are visited in topological order, so dependencies are matched before dependents
+  std::vector<hip::GraphNode*> unmatched;
+  for (auto node : newNodes) {
+    if (matches.find(node) != matches.end()) {
+      continue;
+    }
+    hip::GraphNode* match = nullptr;
+    std::vector<hip::GraphNode*> deps;
+    bool depsMatched = true;
+    for (auto dep : node->GetDependencies()) {
+      auto depMatch = matches.find(dep);
+      if (depMatch == matches.end()) {
+        depsMatched = false;
+        break;
+      }
+      deps.push_back(depMatch->second);
+    }
+    if (depsMatched) {
+      std::sort(deps.begin(), deps.end());
+      auto sig = execBySignature.find(Signature(node->GetType(), deps));
+      if (sig != execBySignature.end()) {
+        match = take(sig->second);
+      }
+    }
+    if (match != nullptr) {
+      matches[node] = match;
+    } else {
+      unmatched.push_back(node);
+    }
+  }
+  std::map<hipGraphNodeType, size_t> unmatchedByType;
+  for (auto node : unmatched) {
+    unmatchedByType[node->GetType()]++;
+  }
+  for (auto node : unmatched) {
+    hip::GraphNode* match = take(execByType[node->GetType()]);
+    if (match == nullptr) {
+      result = hipGraphExecUpdateErrorNodeTypeChanged;
+      return node;
+    }
+    if (unmatchedByType[node->GetType()] > 1) {
+      result = hipGraphExecUpdateErrorTopologyChanged;
+      return node;
+    }
+    matches[node] = match;
+  }
+  return nullptr;
+}
+
 hipError_t hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
                               hipGraphNode_t* hErrorNode_out,
                               hipGraphExecUpdateResult* updateResult_out) {
@@ -2403,75 +2541,108 @@ hipError_t hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
     HIP_RETURN(hipErrorInvalidValue);
   }
 
+  hip::GraphExec* graphExec = reinterpret_cast<hip::GraphExec*>(hGraphExec);
   std::vector<hip::GraphNode*> newGraphNodes;
   reinterpret_cast<hip::Graph*>(hGraph)->TopologicalOrder(newGraphNodes);
-  std::vector<hip::GraphNode*>& oldGraphExecNodes =
-      reinterpret_cast<hip::GraphExec*>(hGraphExec)->GetNodes();
+  std::vector<hip::GraphNode*>& oldGraphExecNodes = graphExec->GetNodes();
   if (newGraphNodes.size() != oldGraphExecNodes.size()) {
     *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
     *hErrorNode_out = nullptr;
     HIP_RETURN(hipErrorGraphExecUpdateFailure);
   }
 
-  for (std::vector<hip::GraphNode*>::size_type i = 0; i != newGraphNodes.size(); i++) {
-    // Checks if all the node types are same before updating
-    if (newGraphNodes[i]->GetType() == oldGraphExecNodes[i]->GetType()) {
-      if (newGraphNodes[i]->GetType() != hipGraphNodeTypeHost &&
-          newGraphNodes[i]->GetType() != hipGraphNodeTypeEmpty) {
-        if (newGraphNodes[i]->GetParentGraph()->device_ !=
-            oldGraphExecNodes[i]->GetParentGraph()->device_) {
-          *updateResult_out = hipGraphExecUpdateErrorUnsupportedFunctionChange;
-          *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
-          return hipErrorGraphExecUpdateFailure;
-        }
-      }
+  std::unordered_map<hip::GraphNode*, hip::GraphNode*> matches;
+  hipGraphExecUpdateResult matchResult = hipGraphExecUpdateSuccess;
+  hip::GraphNode* unmatchedNode =
+      ihipGraphExecMatchNodes(newGraphNodes, oldGraphExecNodes, matches, matchResult);
+  if (unmatchedNode != nullptr) {
+    *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(unmatchedNode);
+    *updateResult_out = matchResult;
+    HIP_RETURN(hipErrorGraphExecUpdateFailure);
+  }
 
-      if (newGraphNodes[i]->GetType() == hipGraphNodeTypeMemcpy) {
-        // Checks if the memcpy node's parameters are same
-        const hip::GraphMemcpyNode* newMemcpyNode =
-            static_cast<hip::GraphMemcpyNode const*>(newGraphNodes[i]);
-        const hip::GraphMemcpyNode* oldMemcpyNode =
-            static_cast<hip::GraphMemcpyNode const*>(oldGraphExecNodes[i]);
-        hipMemcpyKind newKind, oldKind;
-        newKind = newMemcpyNode->GetMemcpyKind();
-        oldKind = oldMemcpyNode->GetMemcpyKind();
-        if (newKind != oldKind) {
-          *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
-          *updateResult_out = hipGraphExecUpdateErrorParametersChanged;
-          HIP_RETURN(hipErrorGraphExecUpdateFailure);
-        }
-      }
-      // Checks if all the node's dependencies are same
-      const std::vector<hip::GraphNode*>& newGraphDependencies =
-                        newGraphNodes[i]->GetDependencies();
-      const std::vector<hip::GraphNode*>& oldGraphDependencies =
-                        oldGraphExecNodes[i]->GetDependencies();
-      if (newGraphDependencies.size() != oldGraphDependencies.size()) {
-        *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
-        *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
+  // Validate all the node pairs before the executable graph is modified
+  bool topologyChanged = false;
+  hip::GraphNode* firstRewiredNode = nullptr;
+  for (auto newNode : newGraphNodes) {
+    hip::GraphNode* oldNode = matches[newNode];
+    if (newNode->GetType() != hipGraphNodeTypeHost && newNode->GetType() != hipGraphNodeTypeEmpty) {
+      if (newNode->GetParentGraph()->device_ != oldNode->GetParentGraph()->device_) {
+        *updateResult_out = hipGraphExecUpdateErrorUnsupportedFunctionChange;
+        *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newNode);
         HIP_RETURN(hipErrorGraphExecUpdateFailure);
       }
+    }
 
-      hipError_t status = oldGraphExecNodes[i]->SetParams(newGraphNodes[i]);
-      if (status != hipSuccess) {
-        *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
-        if (status == hipErrorInvalidDeviceFunction) {
-          *updateResult_out = hipGraphExecUpdateErrorUnsupportedFunctionChange;
-        } else if (status == hipErrorInvalidValue || status == hipErrorInvalidDevicePointer) {
-          *updateResult_out = hipGraphExecUpdateErrorParametersChanged;
-        } else {
-          *updateResult_out = hipGraphExecUpdateErrorNotSupported;
-        }
+    if (newNode->GetType() == hipGraphNodeTypeMemcpy) {
+      // Checks if the memcpy node's parameters are same
+      const hip::GraphMemcpyNode* newMemcpyNode = static_cast<hip::GraphMemcpyNode const*>(newNode);
+      const hip::GraphMemcpyNode* oldMemcpyNode = static_cast<hip::GraphMemcpyNode const*>(oldNode);
+      if (newMemcpyNode->GetMemcpyKind() != oldMemcpyNode->GetMemcpyKind()) {
+        *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newNode);
+        *updateResult_out = hipGraphExecUpdateErrorParametersChanged;
         HIP_RETURN(hipErrorGraphExecUpdateFailure);
-      } else if (DEBUG_CLR_GRAPH_PACKET_CAPTURE &&
-                 oldGraphExecNodes[i]->GetType() == hipGraphNodeTypeKernel) {
-        status =
-            reinterpret_cast<hip::GraphExec*>(hGraphExec)
-                ->UpdateAQLPacket(reinterpret_cast<hip::GraphKernelNode*>(oldGraphExecNodes[i]));
       }
-    } else {
-      *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
-      *updateResult_out = hipGraphExecUpdateErrorNodeTypeChanged;
+    }
+    // Checks if the node's dependencies map onto the instantiated node's dependencies
+    const std::vector<hip::GraphNode*>& newGraphDependencies = newNode->GetDependencies();
+    const std::vector<hip::GraphNode*>& oldGraphDependencies = oldNode->GetDependencies();
+    bool sameDependencies = (newGraphDependencies.size() == oldGraphDependencies.size());
+    for (auto dep : newGraphDependencies) {
+      if (!sameDependencies) {
+        break;
+      }
+      sameDependencies = std::find(oldGraphDependencies.begin(), oldGraphDependencies.end(),
+                                   matches[dep]) != oldGraphDependencies.end();
+    }
+    if (!sameDependencies && !topologyChanged) {
+      topologyChanged = true;
+      firstRewiredNode = newNode;
+    }
+  }
+
+  // New parameters are validated on a copy of each instantiated node they change, so a failing
+  // node leaves the executable graph untouched. Unchanged nodes aren't copied or patched
+  std::vector<std::pair<hip::GraphNode*, std::unique_ptr<hip::GraphNode>>> updates;
+  for (auto newNode : newGraphNodes) {
+    hip::GraphNode* oldNode = matches[newNode];
+    if (oldNode->HasSameParams(newNode)) {
+      continue;
+    }
+    std::unique_ptr<hip::GraphNode> update(oldNode->clone());
+    hipError_t status = update->SetParams(newNode);
+    if (status != hipSuccess) {
+      *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newNode);
+      if (status == hipErrorInvalidDeviceFunction) {
+        *updateResult_out = hipGraphExecUpdateErrorUnsupportedFunctionChange;
+      } else if (status == hipErrorInvalidValue || status == hipErrorInvalidDevicePointer) {
+        *updateResult_out = hipGraphExecUpdateErrorParametersChanged;
+      } else {
+        *updateResult_out = hipGraphExecUpdateErrorNotSupported;
+      }
+      HIP_RETURN(hipErrorGraphExecUpdateFailure);
+    }
+    updates.emplace_back(oldNode, std::move(update));
+  }
+
+  // Edge changes re-partition the executable graph in place instead of a new instantiation,
+  // a failed re-partition restores the previous edges
+  if (topologyChanged && graphExec->UpdateTopology(matches) != hipSuccess) {
+    *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(firstRewiredNode);
+    *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
+    HIP_RETURN(hipErrorGraphExecUpdateFailure);
+  }
+
+  // The validated parameters are applied last, only an allocation failure can still fail here
+  for (auto& entry : updates) {
+    hipError_t status = entry.first->SetParams(entry.second.get());
+    if ((status == hipSuccess) && DEBUG_CLR_GRAPH_PACKET_CAPTURE &&
+        (entry.first->GetType() == hipGraphNodeTypeKernel)) {
+      status = graphExec->UpdateAQLPacket(reinterpret_cast<hip::GraphKernelNode*>(entry.first));
+    }
+    if (status != hipSuccess) {
+      *hErrorNode_out = nullptr;
+      *updateResult_out = hipGraphExecUpdateErrorNotSupported;
       HIP_RETURN(hipErrorGraphExecUpdateFailure);
     }
   }
@@ -2480,38 +2651,52 @@ hipError_t hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
 }
 
 // ================================================================================================
-hipError_t hipGraphAddMemAllocNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
-                                   const hipGraphNode_t* pDependencies, size_t numDependencies,
-                                   hipMemAllocNodeParams* pNodeParams) {
-  HIP_INIT_API(hipGraphAddMemAllocNode, pGraphNode, graph, pDependencies, numDependencies,
-               pNodeParams);
+hipError_t ihipGraphAddMemAllocNode(hip::GraphNode** pGraphNode, hip::Graph* graph,
+                                    hip::GraphNode* const* pDependencies, size_t numDependencies,
+                                    hipMemAllocNodeParams* pNodeParams) {
   if (pGraphNode == nullptr || graph == nullptr ||
       (numDependencies > 0 && pDependencies == nullptr) || pNodeParams == nullptr) {
-    HIP_RETURN(hipErrorInvalidValue);
+    return hipErrorInvalidValue;
   }
   if (pNodeParams->bytesize == 0 ||
       pNodeParams->poolProps.allocType != hipMemAllocationTypePinned ||
       pNodeParams->poolProps.location.type != hipMemLocationTypeDevice) {
     pNodeParams->dptr = nullptr;
-    HIP_RETURN(hipErrorInvalidValue);
+    return hipErrorInvalidValue;
   }
   if (pNodeParams->poolProps.location.type == hipMemLocationTypeDevice) {
     if (pNodeParams->poolProps.location.id < 0 ||
         pNodeParams->poolProps.location.id >= g_devices.size()) {
-      HIP_RETURN(hipErrorInvalidValue);
+      return hipErrorInvalidValue;
     }
   }
   // Clear the pointer to allocated memory because it may contain stale/uninitialized data
   pNodeParams->dptr = nullptr;
   auto mem_alloc_node = new hip::GraphMemAllocNode(pNodeParams);
-  hip::GraphNode* node = mem_alloc_node;
-  auto status =
-      ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                       reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+  *pGraphNode = mem_alloc_node;
+  auto status = ihipGraphAddNode(*pGraphNode, graph, pDependencies, numDependencies);
   // The address must be provided during the node creation time
   pNodeParams->dptr =
       (HIP_MEM_POOL_USE_VM) ? mem_alloc_node->ReserveAddress() : mem_alloc_node->Execute();
-  *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
+  return status;
+}
+
+hipError_t hipGraphAddMemAllocNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                   const hipGraphNode_t* pDependencies, size_t numDependencies,
+                                   hipMemAllocNodeParams* pNodeParams) {
+  HIP_INIT_API(hipGraphAddMemAllocNode, pGraphNode, graph, pDependencies, numDependencies,
+               pNodeParams);
+  if (pGraphNode == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::GraphNode* node = nullptr;
+  hipError_t status =
+      ihipGraphAddMemAllocNode(&node, reinterpret_cast<hip::Graph*>(graph),
+                               reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                               numDependencies, pNodeParams);
+  if (node != nullptr) {
+    *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
+  }
   HIP_RETURN(status);
 }
 
@@ -2529,15 +2714,14 @@ hipError_t hipGraphMemAllocNodeGetParams(hipGraphNode_t node, hipMemAllocNodePar
 }
 
 // ================================================================================================
-hipError_t hipGraphAddMemFreeNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
-                                  const hipGraphNode_t* pDependencies, size_t numDependencies,
-                                  void* dev_ptr) {
-  HIP_INIT_API(hipGraphAddMemFreeNode, pGraphNode, graph, pDependencies, numDependencies, dev_ptr);
+hipError_t ihipGraphAddMemFreeNode(hip::GraphNode** pGraphNode, hip::Graph* graph,
+                                   hip::GraphNode* const* pDependencies, size_t numDependencies,
+                                   void* dev_ptr) {
   if (pGraphNode == nullptr || graph == nullptr ||
       ((numDependencies > 0 && pDependencies == nullptr) ||
        (pDependencies != nullptr && numDependencies == 0)) ||
       dev_ptr == nullptr) {
-    HIP_RETURN(hipErrorInvalidValue);
+    return hipErrorInvalidValue;
   }
 
   // Is memory passed to be free'd valid
@@ -2549,16 +2733,29 @@ hipError_t hipGraphAddMemFreeNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
       memory = amd::MemObjMap::FindVirtualMemObj(dev_ptr);
     }
     if (memory == nullptr) {
-      HIP_RETURN(hipErrorInvalidValue);
+      return hipErrorInvalidValue;
     }
   }
 
-  auto mem_free_node = new hip::GraphMemFreeNode(dev_ptr);
-  hip::GraphNode* node = mem_free_node;
-  auto status =
-      ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                       reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
-  *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
+  *pGraphNode = new hip::GraphMemFreeNode(dev_ptr);
+  return ihipGraphAddNode(*pGraphNode, graph, pDependencies, numDependencies);
+}
+
+hipError_t hipGraphAddMemFreeNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
+                                  const hipGraphNode_t* pDependencies, size_t numDependencies,
+                                  void* dev_ptr) {
+  HIP_INIT_API(hipGraphAddMemFreeNode, pGraphNode, graph, pDependencies, numDependencies, dev_ptr);
+  if (pGraphNode == nullptr) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::GraphNode* node = nullptr;
+  hipError_t status =
+      ihipGraphAddMemFreeNode(&node, reinterpret_cast<hip::Graph*>(graph),
+                              reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                              numDependencies, dev_ptr);
+  if (node != nullptr) {
+    *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
+  }
   HIP_RETURN(status);
 }
 
@@ -3063,4 +3260,468 @@ hipError_t hipGraphExecExternalSemaphoresWaitNodeSetParams(hipGraphExec_t hGraph
       nodeParams));
 }
 
+// ================================================================================================
+hipError_t ihipGraphSave(hip::Graph* graph, GraphFileWriter& writer);
+
+// Saves a pointer unless it refers to runtime memory, which isn't allocated by the saved graph
+bool ihipGraphSavePointer(const void* ptr, GraphFileWriter& writer) {
+  size_t offset = 0;
+  if (ptr != nullptr && !writer.IsAllocation(ptr) && getMemoryObject(ptr, offset) != nullptr) {
+    LogPrintfError("[hipGraph] Can't save pointer %p allocated outside of the graph", ptr);
+    return false;
+  }
+  writer.WritePointer(ptr);
+  return true;
+}
+
+hipError_t ihipGraphSaveNode(hip::GraphNode* node, GraphFileWriter& writer) {
+  switch (node->GetType()) {
+    case hipGraphNodeTypeKernel: {
+      hipKernelNodeParams params;
+      static_cast<hip::GraphKernelNode*>(node)->GetParams(&params);
+      // Only statically registered kernels can be found by name in another process
+      const char* name = PlatformState::instance().getStatFuncName(params.func);
+      hipFunction_t func = hip::GraphKernelNode::getFunc(
+          params, node->GetParentGraph()->device_->deviceId());
+      if (name == nullptr || func == nullptr) {
+        return hipErrorNotSupported;
+      }
+      const amd::KernelSignature& signature =
+          hip::DeviceFunc::asFunction(func)->kernel()->signature();
+      writer.WriteString(name);
+      writer.Write(params.gridDim);
+      writer.Write(params.blockDim);
+      writer.Write(params.sharedMemBytes);
+      // Arguments in an extra kernarg buffer are split up by the signature offsets, same as
+      // on launch, so their pointers are relocated like kernelParams
+      const char* kernargs =
+          (params.extra != nullptr) ? reinterpret_cast<const char*>(params.extra[1]) : nullptr;
+      uint32_t numParams =
+          (params.kernelParams != nullptr || kernargs != nullptr) ? signature.numParameters() : 0;
+      writer.Write(kGraphFileKernelParams);
+      writer.Write(numParams);
+      for (uint32_t i = 0; i < numParams; ++i) {
+        const amd::KernelParameterDescriptor& desc = signature.at(i);
+        const void* value =
+            (kernargs != nullptr) ? kernargs + desc.offset_ : params.kernelParams[i];
+        const uint8_t isPointer = (desc.type_ == T_POINTER) && (desc.size_ == sizeof(void*));
+        writer.Write(static_cast<uint32_t>(desc.size_));
+        writer.Write(isPointer);
+        if (isPointer) {
+          void* ptr = nullptr;
+          ::memcpy(&ptr, value, sizeof(void*));
+          if (!ihipGraphSavePointer(ptr, writer)) {
+            return hipErrorNotSupported;
+          }
+        } else {
+          writer.Write(value, desc.size_);
+        }
+      }
+      break;
+    }
+    case hipGraphNodeTypeMemcpy: {
+      if (dynamic_cast<hip::GraphMemcpyNodeFromSymbol*>(node) != nullptr ||
+          dynamic_cast<hip::GraphMemcpyNodeToSymbol*>(node) != nullptr) {
+        return hipErrorNotSupported;
+      }
+      if (auto memcpy1D = dynamic_cast<hip::GraphMemcpyNode1D*>(node)) {
+        void* dst;
+        const void* src;
+        size_t count;
+        hipMemcpyKind kind;
+        memcpy1D->GetParams(&dst, &src, &count, &kind);
+        writer.Write(kGraphFileMemcpy1D);
+        if (!ihipGraphSavePointer(dst, writer) || !ihipGraphSavePointer(src, writer)) {
+          return hipErrorNotSupported;
+        }
+        writer.Write(static_cast<uint64_t>(count));
+        writer.Write(static_cast<uint32_t>(kind));
+        break;
+      }
+      auto memcpy3D = dynamic_cast<hip::GraphMemcpyNode*>(node);
+      if (memcpy3D == nullptr) {
+        return hipErrorNotSupported;
+      }
+      hipMemcpy3DParms params;
+      memcpy3D->GetParams(&params);
+      if (params.srcArray != nullptr || params.dstArray != nullptr) {
+        return hipErrorNotSupported;
+      }
+      writer.Write(kGraphFileMemcpy3D);
+      for (const hipPitchedPtr* ptr : {&params.srcPtr, &params.dstPtr}) {
+        if (!ihipGraphSavePointer(ptr->ptr, writer)) {
+          return hipErrorNotSupported;
+        }
+        writer.Write(static_cast<uint64_t>(ptr->pitch));
+        writer.Write(static_cast<uint64_t>(ptr->xsize));
+        writer.Write(static_cast<uint64_t>(ptr->ysize));
+      }
+      for (const hipPos* pos : {&params.srcPos, &params.dstPos}) {
+        writer.Write(static_cast<uint64_t>(pos->x));
+        writer.Write(static_cast<uint64_t>(pos->y));
+        writer.Write(static_cast<uint64_t>(pos->z));
+      }
+      writer.Write(static_cast<uint64_t>(params.extent.width));
+      writer.Write(static_cast<uint64_t>(params.extent.height));
+      writer.Write(static_cast<uint64_t>(params.extent.depth));
+      writer.Write(static_cast<uint32_t>(params.kind));
+      break;
+    }
+    case hipGraphNodeTypeMemset: {
+      auto memset = static_cast<hip::GraphMemsetNode*>(node);
+      hipMemsetParams params;
+      memset->GetParams(&params);
+      if (!ihipGraphSavePointer(params.dst, writer)) {
+        return hipErrorNotSupported;
+      }
+      writer.Write(params.value);
+      writer.Write(params.elementSize);
+      writer.Write(static_cast<uint64_t>(params.pitch));
+      writer.Write(static_cast<uint64_t>(params.width));
+      writer.Write(static_cast<uint64_t>(params.height));
+      writer.Write(static_cast<uint64_t>(memset->GetDepth()));
+      break;
+    }
+    case hipGraphNodeTypeEmpty:
+      break;
+    case hipGraphNodeTypeGraph:
+      return ihipGraphSave(node->GetChildGraph(), writer);
+    case hipGraphNodeTypeMemAlloc: {
+      hipMemAllocNodeParams params;
+      static_cast<hip::GraphMemAllocNode*>(node)->GetParams(&params);
+      writer.Write(static_cast<uint32_t>(params.poolProps.allocType));
+      writer.Write(static_cast<uint32_t>(params.poolProps.handleTypes));
+      writer.Write(static_cast<uint32_t>(params.poolProps.location.type));
+      writer.Write(static_cast<int32_t>(params.poolProps.location.id));
+      writer.Write(static_cast<uint64_t>(params.bytesize));
+      const size_t accessDescCount =
+          (params.accessDescs != nullptr) ? params.accessDescCount : 0;
+      writer.Write(static_cast<uint64_t>(accessDescCount));
+      for (size_t i = 0; i < accessDescCount; ++i) {
+        writer.Write(params.accessDescs[i]);
+      }
+      writer.AddAllocation(params.dptr, params.bytesize);
+      break;
+    }
+    case hipGraphNodeTypeMemFree: {
+      void* ptr = nullptr;
+      static_cast<hip::GraphMemFreeNode*>(node)->GetParams(&ptr);
+      if (!ihipGraphSavePointer(ptr, writer)) {
+        return hipErrorNotSupported;
+      }
+      break;
+    }
+    default:
+      // Host functions, events and semaphores have no meaning in another process
+      return hipErrorNotSupported;
+  }
+  return hipSuccess;
+}
+
+hipError_t ihipGraphSave(hip::Graph* graph, GraphFileWriter& writer) {
+  std::vector<hip::GraphNode*> nodes;
+  if (!graph->TopologicalOrder(nodes)) {
+    return hipErrorInvalidValue;
+  }
+  std::unordered_map<hip::GraphNode*, uint32_t> indices;
+  writer.Write(static_cast<uint32_t>(nodes.size()));
+  for (auto node : nodes) {
+    const uint32_t index = static_cast<uint32_t>(indices.size());
+    indices[node] = index;
+    writer.Write(static_cast<uint32_t>(node->GetType()));
+    const std::vector<hip::GraphNode*>& dependencies = node->GetDependencies();
+    writer.Write(static_cast<uint32_t>(dependencies.size()));
+    for (auto dep : dependencies) {
+      writer.Write(indices[dep]);
+    }
+    hipError_t status = ihipGraphSaveNode(node, writer);
+    if (status != hipSuccess) {
+      LogPrintfError("[hipGraph] Can't save node %u of type %d", node->GetID(),
+                     node->GetType());
+      return status;
+    }
+  }
+  return hipSuccess;
+}
+
+hipError_t ihipGraphLoad(hip::Graph* graph, GraphFileReader& reader);
+
+hipError_t ihipGraphLoadNode(hip::GraphNode** pNode, uint32_t type, hip::Graph* graph,
+                             const std::vector<hip::GraphNode*>& deps, GraphFileReader& reader) {
+  switch (type) {
+    case hipGraphNodeTypeKernel: {
+      std::string name;
+      hipKernelNodeParams params = {};
+      uint32_t form = 0;
+      if (!reader.ReadString(&name) || !reader.Read(&params.gridDim) ||
+          !reader.Read(&params.blockDim) || !reader.Read(&params.sharedMemBytes) ||
+          !reader.Read(&form)) {
+        return hipErrorInvalidValue;
+      }
+      params.func = const_cast<void*>(PlatformState::instance().getStatHostFunction(name));
+      if (params.func == nullptr) {
+        LogPrintfError("[hipGraph] Kernel %s isn't registered", name.c_str());
+        return hipErrorInvalidDeviceFunction;
+      }
+      std::vector<char> values;
+      std::vector<void*> args;
+      size_t kernargsSize = 0;
+      void* extra[] = {HIP_LAUNCH_PARAM_BUFFER_POINTER, nullptr, HIP_LAUNCH_PARAM_BUFFER_SIZE,
+                       &kernargsSize, HIP_LAUNCH_PARAM_END};
+      if (form == kGraphFileKernelExtra) {
+        uint64_t size = 0;
+        if (!reader.Read(&size) || !reader.Readable(size)) {
+          return hipErrorInvalidValue;
+        }
+        values.resize(size);
+        reader.Read(values.data(), size);
+        kernargsSize = size;
+        extra[1] = values.data();
+        params.extra = extra;
+      } else if (form == kGraphFileKernelParams) {
+        uint32_t numParams = 0;
+        if (!reader.Read(&numParams)) {
+          return hipErrorInvalidValue;
+        }
+        // The saved arguments must match the signature of the kernel registered now
+        hipFunction_t func = hip::GraphKernelNode::getFunc(params, graph->device_->deviceId());
+        if (func == nullptr) {
+          return hipErrorInvalidDeviceFunction;
+        }
+        const amd::KernelSignature& signature =
+            hip::DeviceFunc::asFunction(func)->kernel()->signature();
+        if (numParams != signature.numParameters()) {
+          LogPrintfError("[hipGraph] Kernel %s takes %u arguments, the file has %u", name.c_str(),
+                         signature.numParameters(), numParams);
+          return hipErrorInvalidValue;
+        }
+        std::vector<size_t> offsets;
+        for (uint32_t i = 0; i < numParams; ++i) {
+          uint32_t size = 0;
+          uint8_t isPointer = 0;
+          if (!reader.Read(&size) || !reader.Read(&isPointer) || !reader.Readable(size)) {
+            return hipErrorInvalidValue;
+          }
+          const amd::KernelParameterDescriptor& desc = signature.at(i);
+          if ((size != desc.size_) ||
+              (isPointer != ((desc.type_ == T_POINTER) && (desc.size_ == sizeof(void*))))) {
+            LogPrintfError("[hipGraph] Argument %u of kernel %s doesn't match the file", i,
+                           name.c_str());
+            return hipErrorInvalidValue;
+          }
+          const size_t offset = values.size();
+          values.resize(offset + amd::alignUp(size, sizeof(void*)));
+          if (isPointer) {
+            void* ptr = nullptr;
+            if (size != sizeof(void*) || !reader.ReadPointer(&ptr)) {
+              return hipErrorInvalidValue;
+            }
+            ::memcpy(values.data() + offset, &ptr, sizeof(void*));
+          } else {
+            reader.Read(values.data() + offset, size);
+          }
+          offsets.push_back(offset);
+        }
+        for (auto offset : offsets) {
+          args.push_back(values.data() + offset);
+        }
+        params.kernelParams = args.empty() ? nullptr : args.data();
+      } else {
+        return hipErrorInvalidValue;
+      }
+      return ihipGraphAddKernelNode(pNode, graph, deps.data(), deps.size(), &params);
+    }
+    case hipGraphNodeTypeMemcpy: {
+      uint32_t form = 0;
+      if (!reader.Read(&form)) {
+        return hipErrorInvalidValue;
+      }
+      if (form == kGraphFileMemcpy1D) {
+        void* dst = nullptr;
+        void* src = nullptr;
+        uint64_t count = 0;
+        uint32_t kind = 0;
+        if (!reader.ReadPointer(&dst) || !reader.ReadPointer(&src) || !reader.Read(&count) ||
+            !reader.Read(&kind)) {
+          return hipErrorInvalidValue;
+        }
+        return ihipGraphAddMemcpyNode1D(pNode, graph, deps.data(), deps.size(), dst, src, count,
+                                        static_cast<hipMemcpyKind>(kind));
+      } else if (form != kGraphFileMemcpy3D) {
+        return hipErrorInvalidValue;
+      }
+      hipMemcpy3DParms params = {};
+      uint64_t values[9] = {};
+      for (hipPitchedPtr* ptr : {&params.srcPtr, &params.dstPtr}) {
+        if (!reader.ReadPointer(&ptr->ptr) || !reader.Read(&values[0]) ||
+            !reader.Read(&values[1]) || !reader.Read(&values[2])) {
+          return hipErrorInvalidValue;
+        }
+        ptr->pitch = values[0];
+        ptr->xsize = values[1];
+        ptr->ysize = values[2];
+      }
+      uint32_t kind = 0;
+      for (auto& value : values) {
+        if (!reader.Read(&value)) {
+          return hipErrorInvalidValue;
+        }
+      }
+      if (!reader.Read(&kind)) {
+        return hipErrorInvalidValue;
+      }
+      params.srcPos = make_hipPos(values[0], values[1], values[2]);
+      params.dstPos = make_hipPos(values[3], values[4], values[5]);
+      params.extent = make_hipExtent(values[6], values[7], values[8]);
+      params.kind = static_cast<hipMemcpyKind>(kind);
+      return ihipGraphAddMemcpyNode(pNode, graph, deps.data(), deps.size(), &params);
+    }
+    case hipGraphNodeTypeMemset: {
+      hipMemsetParams params = {};
+      uint64_t pitch = 0, width = 0, height = 0, depth = 0;
+      if (!reader.ReadPointer(&params.dst) || !reader.Read(&params.value) ||
+          !reader.Read(&params.elementSize) || !reader.Read(&pitch) || !reader.Read(&width) ||
+          !reader.Read(&height) || !reader.Read(&depth)) {
+        return hipErrorInvalidValue;
+      }
+      params.pitch = pitch;
+      params.width = width;
+      params.height = height;
+      return ihipGraphAddMemsetNode(pNode, graph, deps.data(), deps.size(), &params, true, depth);
+    }
+    case hipGraphNodeTypeEmpty:
+      *pNode = new hip::GraphEmptyNode();
+      return ihipGraphAddNode(*pNode, graph, deps.data(), deps.size(), false);
+    case hipGraphNodeTypeGraph: {
+      hip::Graph* childGraph = new hip::Graph(graph->device_);
+      hipError_t status = ihipGraphLoad(childGraph, reader);
+      if (status == hipSuccess) {
+        *pNode = new hip::ChildGraphNode(childGraph);
+        status = ihipGraphAddNode(*pNode, graph, deps.data(), deps.size(), false);
+      }
+      delete childGraph;
+      return status;
+    }
+    case hipGraphNodeTypeMemAlloc: {
+      hipMemAllocNodeParams params = {};
+      uint32_t allocType = 0, handleTypes = 0, locationType = 0;
+      int32_t locationId = 0;
+      uint64_t bytesize = 0, accessDescCount = 0;
+      if (!reader.Read(&allocType) || !reader.Read(&handleTypes) || !reader.Read(&locationType) ||
+          !reader.Read(&locationId) || !reader.Read(&bytesize) || !reader.Read(&accessDescCount) ||
+          !reader.Readable(accessDescCount * sizeof(hipMemAccessDesc))) {
+        return hipErrorInvalidValue;
+      }
+      std::vector<hipMemAccessDesc> accessDescs(accessDescCount);
+      for (auto& desc : accessDescs) {
+        reader.Read(&desc);
+      }
+      params.poolProps.allocType = static_cast<hipMemAllocationType>(allocType);
+      params.poolProps.handleTypes = static_cast<hipMemAllocationHandleType>(handleTypes);
+      params.poolProps.location.type = static_cast<hipMemLocationType>(locationType);
+      params.poolProps.location.id = locationId;
+      params.bytesize = bytesize;
+      params.accessDescs = accessDescs.empty() ? nullptr : accessDescs.data();
+      params.accessDescCount = accessDescs.size();
+      hipError_t status =
+          ihipGraphAddMemAllocNode(pNode, graph, deps.data(), deps.size(), &params);
+      reader.AddAllocation(params.dptr);
+      return status;
+    }
+    case hipGraphNodeTypeMemFree: {
+      void* ptr = nullptr;
+      if (!reader.ReadPointer(&ptr)) {
+        return hipErrorInvalidValue;
+      }
+      return ihipGraphAddMemFreeNode(pNode, graph, deps.data(), deps.size(), ptr);
+    }
+    default:
+      return hipErrorInvalidValue;
+  }
+}
+
+hipError_t ihipGraphLoad(hip::Graph* graph, GraphFileReader& reader) {
+  uint32_t numNodes = 0;
+  if (!reader.Read(&numNodes)) {
+    return hipErrorInvalidValue;
+  }
+  std::vector<hip::GraphNode*> nodes;
+  std::vector<hip::GraphNode*> deps;
+  for (uint32_t i = 0; i < numNodes; ++i) {
+    uint32_t type = 0;
+    uint32_t numDeps = 0;
+    if (!reader.Read(&type) || !reader.Read(&numDeps) || numDeps > nodes.size()) {
+      return hipErrorInvalidValue;
+    }
+    deps.clear();
+    for (uint32_t j = 0; j < numDeps; ++j) {
+      uint32_t dep = 0;
+      if (!reader.Read(&dep) || dep >= nodes.size()) {
+        return hipErrorInvalidValue;
+      }
+      deps.push_back(nodes[dep]);
+    }
+    hip::GraphNode* node = nullptr;
+    hipError_t status = ihipGraphLoadNode(&node, type, graph, deps, reader);
+    if (status != hipSuccess) {
+      return status;
+    }
+    nodes.push_back(node);
+  }
+  return hipSuccess;
+}
+
+hipError_t hipExtGraphSave(hipGraph_t graph, const char* path, unsigned int flags) {
+  HIP_INIT_API(hipExtGraphSave, graph, path, flags);
+  hip::Graph* g = reinterpret_cast<hip::Graph*>(graph);
+  if (graph == nullptr || path == nullptr || flags != 0 || !hip::Graph::isGraphValid(g)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  GraphFileWriter writer;
+  writer.Write(kGraphFileMagic, sizeof(kGraphFileMagic));
+  writer.Write(kGraphFileVersion);
+  hipError_t status = ihipGraphSave(g, writer);
+  if (status != hipSuccess) {
+    HIP_RETURN(status);
+  }
+  std::ofstream fout(path, std::ios::out | std::ios::binary);
+  if (fout.fail()) {
+    LogPrintfError("[hipGraph] Error during opening of file : %s", path);
+    HIP_RETURN(hipErrorOperatingSystem);
+  }
+  fout.write(writer.Buffer().data(), writer.Buffer().size());
+  fout.close();
+  HIP_RETURN(fout.fail() ? hipErrorOperatingSystem : hipSuccess);
+}
+
+hipError_t hipExtGraphLoad(hipGraph_t* pGraph, const char* path, unsigned int flags) {
+  HIP_INIT_API(hipExtGraphLoad, pGraph, path, flags);
+  if (pGraph == nullptr || path == nullptr || flags != 0) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  std::ifstream fin(path, std::ios::in | std::ios::binary);
+  if (fin.fail()) {
+    LogPrintfError("[hipGraph] Error during opening of file : %s", path);
+    HIP_RETURN(hipErrorOperatingSystem);
+  }
+  std::vector<char> buffer((std::istreambuf_iterator<char>(fin)),
+                           std::istreambuf_iterator<char>());
+  GraphFileReader reader(buffer);
+  char magic[sizeof(kGraphFileMagic)];
+  uint32_t version = 0;
+  if (!reader.Read(magic, sizeof(magic)) ||
+      ::memcmp(magic, kGraphFileMagic, sizeof(magic)) != 0 || !reader.Read(&version) ||
+      version != kGraphFileVersion) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  hip::Graph* graph = new hip::Graph(hip::getCurrentDevice());
+  hipError_t status = ihipGraphLoad(graph, reader);
+  if (status != hipSuccess) {
+    delete graph;
+    HIP_RETURN(status);
+  }
+  *pGraph = reinterpret_cast<hipGraph_t>(graph);
+  HIP_RETURN(hipSuccess);
+}
+
 }  // namespace hip
@@ -0,0 +1,148 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hip {
+// Graph file layout, all values are in host byte order:
+//   header: magic, version
+//   graph:  node count, then for every node in topological order its type, the indices of its
+//           dependencies among the preceding nodes and the node parameters. Child graph nodes
+//           hold a nested graph.
+// Pointers are saved as the index of the memory allocation node, which owns the pointer, plus
+// the offset in its allocation, or kGraphFileNoAlloc plus the raw pointer value. Allocation
+// nodes are indexed in file order, so the loader can fix up the pointers with the addresses
+// of its own allocations. Raw values are only saved for memory the runtime doesn't own, since
+// other device or pinned allocations don't exist in the loading process. Kernel arguments are
+// always saved one by one, so pointers in an extra kernarg buffer are relocated as well.
+constexpr char kGraphFileMagic[8] = {'H', 'I', 'P', 'G', 'R', 'A', 'P', 'H'};
+constexpr uint32_t kGraphFileVersion = 1;
+constexpr uint32_t kGraphFileNoAlloc = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t kGraphFileKernelParams = 0;  //!< Kernel arguments passed as kernelParams
+constexpr uint32_t kGraphFileKernelExtra = 1;   //!< Kernel arguments passed as extra
+constexpr uint32_t kGraphFileMemcpy3D = 0;
+constexpr uint32_t kGraphFileMemcpy1D = 1;
+
+class GraphFileWriter {
+ public:
+  void Write(const void* data, size_t size) {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+  template <typename T> void Write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only POD values can be written");
+    Write(&value, sizeof(T));
+  }
+  void WriteString(const std::string& str) {
+    Write(static_cast<uint32_t>(str.size()));
+    Write(str.data(), str.size());
+  }
+  void WritePointer(const void* ptr) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    auto it = allocs_.upper_bound(addr);
+    if (it != allocs_.begin()) {
+      --it;
+      if (addr < it->first + it->second.first) {
+        Write(it->second.second);
+        Write(static_cast<uint64_t>(addr - it->first));
+        return;
+      }
+    }
+    Write(kGraphFileNoAlloc);
+    Write(static_cast<uint64_t>(addr));
+  }
+  //! Returns true if the pointer lies in the allocation of a saved memory allocation node
+  bool IsAllocation(const void* ptr) const {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    auto it = allocs_.upper_bound(addr);
+    return (it != allocs_.begin()) && (addr < std::prev(it)->first + std::prev(it)->second.first);
+  }
+  void AddAllocation(const void* ptr, size_t size) {
+    allocs_[reinterpret_cast<uintptr_t>(ptr)] = std::make_pair(size, numAllocs_++);
+  }
+  const std::vector<char>& Buffer() const { return buffer_; }
+
+ private:
+  std::vector<char> buffer_;
+  //! Allocations of the saved memory allocation nodes: address -> (size, index)
+  std::map<uintptr_t, std::pair<size_t, uint32_t>> allocs_;
+  uint32_t numAllocs_ = 0;
+};
+
+class GraphFileReader {
+ public:
+  GraphFileReader(const std::vector<char>& buffer) : buffer_(buffer) {}
+
+  bool Readable(size_t size) const { return size <= buffer_.size() - offset_; }
+  bool Read(void* data, size_t size) {
+    if (!Readable(size)) {
+      return false;
+    }
+    ::memcpy(data, buffer_.data() + offset_, size);
+    offset_ += size;
+    return true;
+  }
+  template <typename T> bool Read(T* value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only POD values can be read");
+    return Read(value, sizeof(T));
+  }
+  bool ReadString(std::string* str) {
+    uint32_t size = 0;
+    if (!Read(&size) || !Readable(size)) {
+      return false;
+    }
+    str->assign(buffer_.data() + offset_, size);
+    offset_ += size;
+    return true;
+  }
+  bool ReadPointer(void** ptr) {
+    uint32_t alloc = 0;
+    uint64_t value = 0;
+    if (!Read(&alloc) || !Read(&value)) {
+      return false;
+    }
+    if (alloc == kGraphFileNoAlloc) {
+      *ptr = reinterpret_cast<void*>(value);
+    } else if (alloc < allocs_.size()) {
+      *ptr = reinterpret_cast<char*>(allocs_[alloc]) + value;
+    } else {
+      return false;
+    }
+    return true;
+  }
+  void AddAllocation(void* ptr) { allocs_.push_back(ptr); }
+
+ private:
+  const std::vector<char>& buffer_;
+  size_t offset_ = 0;
+  std::vector<void*> allocs_;  //!< Addresses of the loaded memory allocation nodes
+};
+}  // namespace hip
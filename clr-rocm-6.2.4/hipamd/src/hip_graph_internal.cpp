@@ -58,12 +58,9 @@ amd::Monitor GraphExecStatusLock_ ROCCLR_INIT_PRIORITY(101){
 
 int GraphNode::nextID = 0;
 int Graph::nextID = 0;
-std::unordered_set<GraphNode*> GraphNode::nodeSet_;
-amd::Monitor GraphNode::nodeSetLock_{"Guards global node set"};
-std::unordered_set<Graph*> Graph::graphSet_;
-amd::Monitor Graph::graphSetLock_{"Guards global graph set"};
-std::unordered_set<GraphExec*> GraphExec::graphExecSet_;
-amd::Monitor GraphExec::graphExecSetLock_{"Guards global exec graph set"};
+GraphObjectRegistry<GraphNode> GraphNode::nodeSet_;
+GraphObjectRegistry<Graph> Graph::graphSet_;
+GraphObjectRegistry<GraphExec> GraphExec::graphExecSet_;
 std::unordered_set<UserObject*> UserObject::ObjectSet_;
 amd::Monitor UserObject::UserObjectLock_{"Guards global user object"};
 
@@ -106,13 +103,7 @@ hipError_t GraphMemcpyNode::ValidateParams(const hipMemcpy3DParms* pNodeParams)
   return hipSuccess;
 }
 
-bool Graph::isGraphValid(Graph* pGraph) {
-  amd::ScopedLock lock(graphSetLock_);
-  if (graphSet_.find(pGraph) == graphSet_.end()) {
-    return false;
-  }
-  return true;
-}
+bool Graph::isGraphValid(Graph* pGraph) { return graphSet_.Contains(pGraph); }
 
 void Graph::AddNode(const Node& node) {
   vertices_.emplace_back(node);
@@ -305,11 +296,7 @@ Graph* Graph::clone() const {
 }
 
 bool GraphExec::isGraphExecValid(GraphExec* pGraphExec) {
-  amd::ScopedLock lock(graphExecSetLock_);
-  if (graphExecSet_.find(pGraphExec) == graphExecSet_.end()) {
-    return false;
-  }
-  return true;
+  return graphExecSet_.Contains(pGraphExec);
 }
 
 hipError_t GraphExec::CreateStreams(uint32_t num_streams) {
@@ -354,6 +341,94 @@ hipError_t GraphExec::Init() {
   return status;
 }
 
+// Make the outgoing edges of the node match the given list, keeping degrees and dependencies
+// consistent
+static void RewireEdges(Node node, const std::vector<Node>& edges) {
+  const std::vector<Node> current = node->GetEdges();
+  for (auto child : current) {
+    if (std::find(edges.begin(), edges.end(), child) == edges.end()) {
+      node->RemoveUpdateEdge(child);
+    }
+  }
+  for (auto child : edges) {
+    if (std::find(node->GetEdges().begin(), node->GetEdges().end(), child) ==
+        node->GetEdges().end()) {
+      node->AddEdge(child);
+    }
+  }
+}
+
+hipError_t GraphExec::UpdateTopology(const std::unordered_map<Node, Node>& execNodes) {
+  // Only the nodes whose edges differ are touched, their previous edges are kept to roll back
+  std::vector<std::pair<Node, std::vector<Node>>> rewired;
+  std::vector<Node> edges;
+  for (const auto& entry : execNodes) {
+    edges.clear();
+    for (auto child : entry.first->GetEdges()) {
+      edges.push_back(execNodes.at(child));
+    }
+    const std::vector<Node>& current = entry.second->GetEdges();
+    if (edges.size() == current.size() &&
+        std::is_permutation(edges.begin(), edges.end(), current.begin())) {
+      continue;
+    }
+    rewired.emplace_back(entry.second, current);
+    RewireEdges(entry.second, edges);
+  }
+  if (rewired.empty()) {
+    return hipSuccess;
+  }
+
+  hipError_t status = hipSuccess;
+  std::vector<Node> topoOrder;
+  std::vector<std::vector<Node>> parallelLists;
+  std::unordered_map<Node, std::vector<Node>> nodeWaitLists;
+  if (!clonedGraph_->TopologicalOrder(topoOrder)) {
+    status = hipErrorInvalidValue;
+  } else {
+    clonedGraph_->GetRunList(parallelLists, nodeWaitLists);
+    // Captured packets are dispatched only for single list graphs, switching between single and
+    // multiple lists requires the graph to be instantiated again
+    if (DEBUG_CLR_GRAPH_PACKET_CAPTURE &&
+        ((parallelLists.size() == 1) != (parallelLists_.size() == 1))) {
+      status = hipErrorNotSupported;
+    }
+  }
+  size_t min_num_streams = 1;
+  for (auto& node : topoOrder) {
+    if (status != hipSuccess) {
+      break;
+    }
+    status = node->GetNumParallelStreams(min_num_streams);
+  }
+  if (status == hipSuccess) {
+    size_t num_streams = parallelLists.size() - 1 + min_num_streams;
+    if (num_streams > parallel_streams_.size()) {
+      status = CreateStreams(num_streams - parallel_streams_.size());
+    }
+  }
+  if (status != hipSuccess) {
+    for (auto& entry : rewired) {
+      RewireEdges(entry.first, entry.second);
+    }
+    // Restore the run lists of the embedded child graphs
+    std::vector<std::vector<Node>> lists;
+    std::unordered_map<Node, std::vector<Node>> waitLists;
+    clonedGraph_->GetRunList(lists, waitLists);
+    for (auto& node : topoOrder_) {
+      node->GetNumParallelStreams(min_num_streams);
+    }
+    return status;
+  }
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE,
+          "[hipGraph] Re-partitioned graph exec(%p) with %zu rewired nodes into %zu lists", this,
+          rewired.size(), parallelLists.size());
+  topoOrder_.swap(topoOrder);
+  parallelLists_.swap(parallelLists);
+  nodeWaitLists_.swap(nodeWaitLists);
+  return hipSuccess;
+}
+
 void GetKernelArgSizeForGraph(std::vector<std::vector<Node>>& parallelLists,
                               size_t& kernArgSizeForGraph) {
   // GPU packet capture is enabled for kernel nodes. Calculate the kernel
@@ -20,9 +20,12 @@
 
 #pragma once
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <queue>
 #include <stack>
 #include <iostream>
+#include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -165,6 +168,98 @@ struct hipGraphNodeDOTAttribute {
   }
 };
 
+//! Registry of the live graph objects, used to validate the handles passed by the app.
+//! The set is split into shards with separate locks, so the threads, which build or validate
+//! different graphs, rarely contend on the same lock
+template <typename T> class GraphObjectRegistry {
+ public:
+  void Add(T* object) {
+    Shard& shard = GetShard(object);
+    amd::ScopedLock lock(shard.lock_);
+    shard.objects_.insert(object);
+  }
+
+  void Remove(T* object) {
+    Shard& shard = GetShard(object);
+    amd::ScopedLock lock(shard.lock_);
+    shard.objects_.erase(object);
+  }
+
+  bool Contains(T* object) {
+    if (object == nullptr) {
+      return false;
+    }
+    Shard& shard = GetShard(object);
+    amd::ScopedLock lock(shard.lock_);
+    return shard.objects_.find(object) != shard.objects_.end();
+  }
+
+ private:
+  static constexpr size_t kNumShards = 64;
+
+  struct alignas(64) Shard {
+    amd::Monitor lock_{"Guards graph object registry shard"};
+    std::unordered_set<T*> objects_;
+  };
+
+  Shard& GetShard(T* object) {
+    // Drop the allocator alignment bits, so the objects spread over all shards
+    const uintptr_t key = reinterpret_cast<uintptr_t>(object) >> 4;
+    return shards_[(key ^ (key >> 8)) % kNumShards];
+  }
+
+  std::array<Shard, kNumShards> shards_;
+};
+
+//! Bump allocator for the captured node arguments of a graph. The memory is released in bulk
+//! with the owning graph. Like the graph itself, the arena isn't thread safe
+class GraphArena {
+ public:
+  static constexpr size_t kChunkSize = 64 * Ki;  //!< Default chunk size
+  static constexpr size_t kAlignment = 16;       //!< Alignment of every allocation
+
+  GraphArena() : cur_(nullptr), end_(nullptr), allocated_(0) {}
+  ~GraphArena() {
+    for (auto chunk : chunks_) {
+      free(chunk);
+    }
+  }
+
+  //! Returns aligned storage of the requested size or nullptr if out of memory
+  address Alloc(size_t size) {
+    size = amd::alignUp(std::max<size_t>(size, 1), kAlignment);
+    if (size > static_cast<size_t>(end_ - cur_)) {
+      // Large blobs get a dedicated chunk, so the rest of the current chunk isn't wasted
+      const size_t chunkSize = (size > kChunkSize / 4) ? size : kChunkSize;
+      address chunk = reinterpret_cast<address>(malloc(chunkSize));
+      if (chunk == nullptr) {
+        return nullptr;
+      }
+      chunks_.push_back(chunk);
+      allocated_ += size;
+      if (chunkSize == size) {
+        return chunk;
+      }
+      cur_ = chunk + size;
+      end_ = chunk + chunkSize;
+      return chunk;
+    }
+    address ptr = cur_;
+    cur_ += size;
+    allocated_ += size;
+    return ptr;
+  }
+
+  //! Returns the total size of the allocations from the arena
+  size_t Allocated() const { return allocated_; }
+
+ private:
+  std::vector<address> chunks_;  //!< Chunks of memory owned by the arena
+  address cur_;                  //!< Current position in the active chunk
+  address end_;                  //!< End of the active chunk
+  size_t allocated_;             //!< Total size of the allocations
+};
+
 struct GraphNode : public hipGraphNodeDOTAttribute {
  protected:
   hip::Stream* stream_ = nullptr;
@@ -180,8 +275,7 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
   size_t outDegree_;
   static int nextID;
   struct Graph* parentGraph_;
-  static std::unordered_set<GraphNode*> nodeSet_;
-  static amd::Monitor nodeSetLock_;
+  static GraphObjectRegistry<GraphNode> nodeSet_;
   unsigned int isEnabled_;
   uint8_t gpuPacket_[64];  //!< GPU Packet to enqueue during graph launch
   std::string capturedKernelName_;
@@ -197,8 +291,7 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
         parentGraph_(nullptr),
         isEnabled_(1),
         hipGraphNodeDOTAttribute(style, shape, label) {
-    amd::ScopedLock lock(nodeSetLock_);
-    nodeSet_.insert(this);
+    nodeSet_.Add(this);
   }
   /// Copy Constructor
   GraphNode(const GraphNode& node) : hipGraphNodeDOTAttribute(node) {
@@ -208,8 +301,7 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
     visited_ = false;
     id_ = node.id_;
     parentGraph_ = nullptr;
-    amd::ScopedLock lock(nodeSetLock_);
-    nodeSet_.insert(this);
+    nodeSet_.Add(this);
     isEnabled_ = node.isEnabled_;
   }
 
@@ -220,18 +312,11 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
     for (auto node : dependencies_) {
       node->RemoveEdge(this);
     }
-    amd::ScopedLock lock(nodeSetLock_);
-    nodeSet_.erase(this);
+    nodeSet_.Remove(this);
   }
 
   // check node validity
-  static bool isNodeValid(GraphNode* pGraphNode) {
-    amd::ScopedLock lock(nodeSetLock_);
-    if (pGraphNode == nullptr || nodeSet_.find(pGraphNode) == nodeSet_.end()) {
-      return false;
-    }
-    return true;
-  }
+  static bool isNodeValid(GraphNode* pGraphNode) { return nodeSet_.Contains(pGraphNode); }
   // Return gpu packet address to update with actual packet under capture.
   uint8_t* GetAqlPacket() { return gpuPacket_; }
   void SetKernelName(const std::string& kernelName) { capturedKernelName_ = kernelName; }
@@ -349,6 +434,8 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
   virtual Graph* GetChildGraph() { return nullptr; }
   void SetParentGraph(Graph* graph) { parentGraph_ = graph; }
   virtual hipError_t SetParams(GraphNode* node) { return hipSuccess; }
+  //! Returns true if SetParams(node) would leave the parameters of this node as they are
+  virtual bool HasSameParams(const GraphNode* node) const { return false; }
   virtual void GenerateDOT(std::ostream& fout, hipGraphDebugDotFlags flag) {}
   virtual void GenerateDOTNode(size_t graphId, std::ostream& fout, hipGraphDebugDotFlags flag) {
     fout << "\n";
@@ -377,8 +464,8 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
 struct Graph {
   std::vector<Node> vertices_;
   const Graph* pOriginalGraph_ = nullptr;
-  static std::unordered_set<Graph*> graphSet_;
-  static amd::Monitor graphSetLock_;
+  static GraphObjectRegistry<Graph> graphSet_;
+  amd::Monitor userObjLock_{"Guards graph user objects"};
   std::unordered_set<UserObject*> graphUserObj_;
   unsigned int id_;
   static int nextID;
@@ -386,14 +473,15 @@ struct Graph {
   hip::MemoryPool* mem_pool_; //!< Memory pool, associated with this graph
   std::unordered_set<GraphNode*> capturedNodes_;
   bool graphInstantiated_;
+  GraphArena arena_;          //!< Storage for the captured node arguments
+  std::atomic<uint32_t> captureStreams_{0};  //!< Number of streams capturing into the graph
 
  public:
   Graph(hip::Device* device, const Graph* original = nullptr)
       : pOriginalGraph_(original)
       , id_(nextID++)
       , device_(device) {
-    amd::ScopedLock lock(graphSetLock_);
-    graphSet_.insert(this);
+    graphSet_.Add(this);
     mem_pool_ = device->GetGraphMemoryPool();
     mem_pool_->retain();
     graphInstantiated_ = false;
@@ -403,8 +491,8 @@ struct Graph {
     for (auto node : vertices_) {
       delete node;
     }
-    amd::ScopedLock lock(graphSetLock_);
-    graphSet_.erase(this);
+    graphSet_.Remove(this);
+    amd::ScopedLock lock(userObjLock_);
     for (auto userobj : graphUserObj_) {
       userobj->release();
     }
@@ -418,6 +506,12 @@ struct Graph {
 
   std::unordered_set<GraphNode*> GetManualNodesDuringCapture() { return capturedNodes_; }
 
+  /// Tracks the streams, which capture into the graph
+  void BeginCapture() { ++captureStreams_; }
+  void EndCapture() { --captureStreams_; }
+  /// Returns true if a stream captures into the graph
+  bool IsBeingCaptured() const { return captureStreams_.load(std::memory_order_relaxed) != 0; }
+
   void RemoveManualNodesDuringCapture() {
     capturedNodes_.erase(capturedNodes_.begin(), capturedNodes_.end());
   }
@@ -425,6 +519,9 @@ struct Graph {
   /// Return graph unique ID
   int GetID() const { return id_; }
 
+  /// Returns the arena for the captured node arguments, released with the graph
+  GraphArena* Arena() { return &arena_; }
+
   // check graphs validity
   static bool isGraphValid(Graph* pGraph);
 
@@ -447,7 +544,7 @@ struct Graph {
   const Graph* getOriginalGraph() const { return pOriginalGraph_; }
   // Add user obj resource to graph
   void addUserObjGraph(UserObject* pUserObj) {
-    amd::ScopedLock lock(graphSetLock_);
+    amd::ScopedLock lock(userObjLock_);
     graphUserObj_.insert(pUserObj);
   }
   // Check user obj resource from graph is valid
@@ -555,8 +652,7 @@ struct GraphExec : public amd::ReferenceCountedObject {
   uint currentQueueIndex_;
   std::unordered_map<Node, Node> clonedNodes_;
   amd::Command* lastEnqueuedCommand_;
-  static std::unordered_set<GraphExec*> graphExecSet_;
-  static amd::Monitor graphExecSetLock_;
+  static GraphObjectRegistry<GraphExec> graphExecSet_;
   uint64_t flags_ = 0;
   bool repeatLaunch_ = false;
   // Graph Kernel arg vars
@@ -582,8 +678,7 @@ struct GraphExec : public amd::ReferenceCountedObject {
         lastEnqueuedCommand_(nullptr),
         currentQueueIndex_(0),
         flags_(flags) {
-    amd::ScopedLock lock(graphExecSetLock_);
-    graphExecSet_.insert(this);
+    graphExecSet_.Add(this);
   }
 
   ~GraphExec() {
@@ -604,8 +699,7 @@ struct GraphExec : public amd::ReferenceCountedObject {
         }
       }
     }
-    amd::ScopedLock lock(graphExecSetLock_);
-    graphExecSet_.erase(this);
+    graphExecSet_.Remove(this);
     delete clonedGraph_;
   }
 
@@ -649,6 +743,9 @@ struct GraphExec : public amd::ReferenceCountedObject {
   // Capture GPU Packets from graph commands
   hipError_t CaptureAQLPackets();
   hipError_t UpdateAQLPacket(hip::GraphKernelNode* node);
+  // Rewire the instantiated nodes to the edges of the matched updated graph nodes
+  // and re-partition the run lists
+  hipError_t UpdateTopology(const std::unordered_map<Node, Node>& execNodes);
   using KernelArgImpl = device::Settings::KernelArgImpl;
 };
 
@@ -697,6 +794,7 @@ struct ChildGraphNode : public GraphNode {
 
 
   hipError_t GetNumParallelStreams(size_t &num) override {
+    childGraphNodeOrder_.clear();
     if (false == TopologicalOrder(childGraphNodeOrder_)) {
       return hipErrorInvalidValue;
     }
@@ -746,6 +844,9 @@ struct ChildGraphNode : public GraphNode {
 
   void GetRunList(std::vector<std::vector<Node>>& parallelList,
                   std::unordered_map<Node, std::vector<Node>>& dependencies) override {
+    // The run list is rebuilt when the parent executable graph is re-partitioned
+    parallelLists_.clear();
+    nodeWaitLists_.clear();
     childGraph_->GetRunList(parallelLists_, nodeWaitLists_);
   }
   bool TopologicalOrder(std::vector<Node>& TopoOrder) override {
@@ -809,6 +910,9 @@ class GraphKernelNode : public GraphNode {
   size_t kernargSegmentByteSize_;      //!< Kernel arg segment byte size
   size_t kernargSegmentAlignment_;     //!< Kernel arg segment alignment
   bool hasHiddenHeap_;                 //!< Kernel has hidden heap(device side allocation)
+  GraphArena* arena_ = nullptr;        //!< Graph arena for the params or nullptr for heap
+  address paramsBlob_ = nullptr;       //!< Packed copy of the kernel params
+  size_t paramsBlobSize_ = 0;          //!< Size of the packed params storage
 
 
  public:
@@ -938,22 +1042,31 @@ class GraphKernelNode : public GraphNode {
     }
     const amd::KernelSignature& signature = kernel->signature();
     numParams_ = signature.numParameters();
+    constexpr size_t kAlignment = GraphArena::kAlignment;
+    address blob = nullptr;
+    size_t blobSize = 0;
 
-    // Allocate/assign memory if params are passed part of 'kernelParams'
+    // Pack params passed as part of 'kernelParams' into a single blob: the array of pointers
+    // followed by the argument values
     if (pNodeParams->kernelParams != nullptr) {
-      kernelParams_.kernelParams = (void**)malloc(numParams_ * sizeof(void*));
-      if (kernelParams_.kernelParams == nullptr) {
+      const size_t arraySize = amd::alignUp(numParams_ * sizeof(void*), kAlignment);
+      blobSize = arraySize;
+      for (uint32_t i = 0; i < numParams_; ++i) {
+        blobSize += amd::alignUp(signature.at(i).size_, kAlignment);
+      }
+      blob = allocParams(blobSize, pNodeParams);
+      if (blob == nullptr) {
         return hipErrorOutOfMemory;
       }
-
+      void** params = reinterpret_cast<void**>(blob);
+      address value = blob + arraySize;
       for (uint32_t i = 0; i < numParams_; ++i) {
         const amd::KernelParameterDescriptor& desc = signature.at(i);
-        kernelParams_.kernelParams[i] = malloc(desc.size_);
-        if (kernelParams_.kernelParams[i] == nullptr) {
-          return hipErrorOutOfMemory;
-        }
-        ::memcpy(kernelParams_.kernelParams[i], (pNodeParams->kernelParams[i]), desc.size_);
+        ::memcpy(value, pNodeParams->kernelParams[i], desc.size_);
+        params[i] = value;
+        value += amd::alignUp(desc.size_, kAlignment);
       }
+      kernelParams_.kernelParams = params;
       for (uint32_t i = signature.numParameters(); i < signature.numParametersAll(); ++i) {
         if (signature.at(i).info_.oclObject_ == amd::KernelParameterDescriptor::HiddenHeap) {
           hasHiddenHeap_ = true;
@@ -961,37 +1074,71 @@ class GraphKernelNode : public GraphNode {
       }
     }
 
-    // Allocate/assign memory if params are passed as part of 'extra'
+    // Pack params passed as part of 'extra' into a single blob: the 'extra' array, the size of
+    // the kernel arguments and the kernel arguments
     else if (pNodeParams->extra != nullptr) {
       // 'extra' is a struct that contains the following info: {
       // HIP_LAUNCH_PARAM_BUFFER_POINTER, kernargs,
       // HIP_LAUNCH_PARAM_BUFFER_SIZE, &kernargs_size,
       // HIP_LAUNCH_PARAM_END }
-      unsigned int numExtra = 5;
-      kernelParams_.extra = (void**)malloc(numExtra * sizeof(void*));
-      if (kernelParams_.extra == nullptr) {
-        return hipErrorOutOfMemory;
-      }
-      kernelParams_.extra[0] = pNodeParams->extra[0];
+      constexpr size_t numExtra = 5;
+      const size_t headerSize = amd::alignUp(numExtra * sizeof(void*) + sizeof(size_t),
+                                             kAlignment);
       size_t kernargs_size = *((size_t*)pNodeParams->extra[3]);
-      kernelParams_.extra[1] = malloc(kernargs_size);
-      if (kernelParams_.extra[1] == nullptr) {
+      blobSize = headerSize + kernargs_size;
+      blob = allocParams(blobSize, pNodeParams);
+      if (blob == nullptr) {
         return hipErrorOutOfMemory;
       }
-      kernelParams_.extra[2] = pNodeParams->extra[2];
-      kernelParams_.extra[3] = malloc(sizeof(void*));
-      if (kernelParams_.extra[3] == nullptr) {
-        return hipErrorOutOfMemory;
-      }
-      *((size_t*)kernelParams_.extra[3]) = kernargs_size;
-      ::memcpy(kernelParams_.extra[1], (pNodeParams->extra[1]), kernargs_size);
-      kernelParams_.extra[4] = pNodeParams->extra[4];
+      void** extra = reinterpret_cast<void**>(blob);
+      size_t* size = reinterpret_cast<size_t*>(blob + numExtra * sizeof(void*));
+      ::memcpy(blob + headerSize, pNodeParams->extra[1], kernargs_size);
+      *size = kernargs_size;
+      extra[0] = pNodeParams->extra[0];
+      extra[1] = blob + headerSize;
+      extra[2] = pNodeParams->extra[2];
+      extra[3] = size;
+      extra[4] = pNodeParams->extra[4];
+      kernelParams_.extra = extra;
+    }
+
+    if (blob != paramsBlob_) {
+      freeParams();
+      paramsBlob_ = blob;
+      paramsBlobSize_ = blobSize;
     }
     return hipSuccess;
   }
 
-  GraphKernelNode(const hipKernelNodeParams* pNodeParams, const ihipExtKernelEvents* pEvents)
-      : GraphNode(hipGraphNodeTypeKernel, "bold", "octagon", "KERNEL") {
+  //! Returns storage for the packed params. The current storage is reused if it's big enough
+  //! and the new params don't point into it
+  address allocParams(size_t size, const hipKernelNodeParams* pNodeParams) {
+    if ((paramsBlob_ != nullptr) && (size <= paramsBlobSize_)) {
+      auto aliased = [this](const void* ptr) {
+        auto addr = reinterpret_cast<const_address>(ptr);
+        return (addr >= paramsBlob_) && (addr < paramsBlob_ + paramsBlobSize_);
+      };
+      bool reuse = !aliased(pNodeParams->kernelParams) && !aliased(pNodeParams->extra);
+      if (reuse && (pNodeParams->kernelParams != nullptr)) {
+        for (uint32_t i = 0; (i < numParams_) && reuse; ++i) {
+          reuse = !aliased(pNodeParams->kernelParams[i]);
+        }
+      } else if (reuse && (pNodeParams->extra != nullptr)) {
+        reuse = !aliased(pNodeParams->extra[1]);
+      }
+      if (reuse) {
+        return paramsBlob_;
+      }
+    }
+    if (arena_ != nullptr) {
+      return arena_->Alloc(size);
+    }
+    return reinterpret_cast<address>(malloc(size));
+  }
+
+  GraphKernelNode(const hipKernelNodeParams* pNodeParams, const ihipExtKernelEvents* pEvents,
+                  GraphArena* arena = nullptr)
+      : GraphNode(hipGraphNodeTypeKernel, "bold", "octagon", "KERNEL"), arena_(arena) {
     kernelParams_ = *pNodeParams;
     kernelEvents_ = { 0 };
     if (pEvents != nullptr) {
@@ -1008,25 +1155,12 @@ class GraphKernelNode : public GraphNode {
   ~GraphKernelNode() { freeParams(); }
 
   void freeParams() {
-    // Deallocate memory allocated for kernargs passed via 'kernelParams'
-    if (kernelParams_.kernelParams != nullptr) {
-      for (size_t i = 0; i < numParams_; ++i) {
-        if (kernelParams_.kernelParams[i] != nullptr) {
-          free(kernelParams_.kernelParams[i]);
-        }
-        kernelParams_.kernelParams[i] = nullptr;
-      }
-      free(kernelParams_.kernelParams);
-      kernelParams_.kernelParams = nullptr;
-    }
-    // Deallocate memory allocated for kernargs passed via 'extra'
-    else if (kernelParams_.extra != nullptr) {
-      free(kernelParams_.extra[1]);
-      free(kernelParams_.extra[3]);
-      memset(kernelParams_.extra, 0, 5 * sizeof(kernelParams_.extra[0]));  // 5 items
-      free(kernelParams_.extra);
-      kernelParams_.extra = nullptr;
+    // Memory from the graph arena is released with the graph
+    if ((paramsBlob_ != nullptr) && (arena_ == nullptr)) {
+      free(paramsBlob_);
     }
+    paramsBlob_ = nullptr;
+    paramsBlobSize_ = 0;
   }
 
   GraphKernelNode(const GraphKernelNode& rhs) : GraphNode(rhs) {
@@ -1087,7 +1221,6 @@ class GraphKernelNode : public GraphNode {
       kernelParams_ = *params;
       return status;
     }
-    freeParams();
     kernelParams_ = *params;
     status = copyParams(params);
     if (status != hipSuccess) {
@@ -1191,6 +1324,39 @@ class GraphKernelNode : public GraphNode {
     return SetParams(&kernelNode->kernelParams_);
   }
 
+  bool HasSameParams(const GraphNode* node) const override {
+    const hipKernelNodeParams& params = static_cast<GraphKernelNode const*>(node)->kernelParams_;
+    auto sameDim = [](const dim3& a, const dim3& b) {
+      return (a.x == b.x) && (a.y == b.y) && (a.z == b.z);
+    };
+    if ((params.func != kernelParams_.func) || !sameDim(params.gridDim, kernelParams_.gridDim) ||
+        !sameDim(params.blockDim, kernelParams_.blockDim) ||
+        (params.sharedMemBytes != kernelParams_.sharedMemBytes)) {
+      return false;
+    }
+    if ((params.kernelParams != nullptr) && (kernelParams_.kernelParams != nullptr)) {
+      hipFunction_t func = getFunc(params, ihipGetDevice());
+      if (func == nullptr) {
+        return false;
+      }
+      const amd::KernelSignature& signature =
+          hip::DeviceFunc::asFunction(func)->kernel()->signature();
+      for (uint32_t i = 0; i < signature.numParameters(); ++i) {
+        if (::memcmp(params.kernelParams[i], kernelParams_.kernelParams[i],
+                     signature.at(i).size_) != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+    if ((params.extra != nullptr) && (kernelParams_.extra != nullptr)) {
+      size_t size = *reinterpret_cast<size_t*>(params.extra[3]);
+      return (size == *reinterpret_cast<size_t*>(kernelParams_.extra[3])) &&
+             (::memcmp(params.extra[1], kernelParams_.extra[1], size) == 0);
+    }
+    return false;
+  }
+
   static hipError_t validateKernelParams(const hipKernelNodeParams* pNodeParams,
                                          hipFunction_t* ptrFunc = nullptr, int devId = -1) {
     devId = devId == -1 ? ihipGetDevice() : devId;
@@ -1284,6 +1450,15 @@ class GraphMemcpyNode : public GraphNode {
     const GraphMemcpyNode* memcpyNode = static_cast<GraphMemcpyNode const*>(node);
     return SetParams(&memcpyNode->copyParams_);
   }
+
+  virtual bool HasSameParams(const GraphNode* node) const override {
+    // 1D and symbol copies share the node type, only a 3D copy compares its parameters
+    if ((typeid(*node) != typeid(GraphMemcpyNode)) || (typeid(*this) != typeid(GraphMemcpyNode))) {
+      return false;
+    }
+    const GraphMemcpyNode* memcpyNode = static_cast<GraphMemcpyNode const*>(node);
+    return ::memcmp(&memcpyNode->copyParams_, &copyParams_, sizeof(copyParams_)) == 0;
+  }
   // ToDo: use this when commands are cloned and command params are to be updated
   hipError_t ValidateParams(const hipMemcpy3DParms* pNodeParams);
 
@@ -1471,6 +1646,13 @@ class GraphMemcpyNode1D : public GraphMemcpyNode {
     return kind_;
   }
 
+  void GetParams(void** dst, const void** src, size_t* count, hipMemcpyKind* kind) const {
+    *dst = dst_;
+    *src = src_;
+    *count = count_;
+    *kind = kind_;
+  }
+
   hipError_t SetParams(void* dst, const void* src, size_t count, hipMemcpyKind kind) {
     hipError_t status = ValidateParams(dst, src, count, kind);
     if (status != hipSuccess) {
@@ -1488,6 +1670,16 @@ class GraphMemcpyNode1D : public GraphMemcpyNode {
     return SetParams(memcpy1DNode->dst_, memcpy1DNode->src_, memcpy1DNode->count_,
                      memcpy1DNode->kind_);
   }
+
+  virtual bool HasSameParams(const GraphNode* node) const override {
+    if ((typeid(*node) != typeid(GraphMemcpyNode1D)) ||
+        (typeid(*this) != typeid(GraphMemcpyNode1D))) {
+      return false;
+    }
+    const GraphMemcpyNode1D* memcpy1DNode = static_cast<GraphMemcpyNode1D const*>(node);
+    return (memcpy1DNode->dst_ == dst_) && (memcpy1DNode->src_ == src_) &&
+           (memcpy1DNode->count_ == count_) && (memcpy1DNode->kind_ == kind_);
+  }
   static hipError_t ValidateParams(void* dst, const void* src, size_t count, hipMemcpyKind kind);
   virtual std::string GetLabel(hipGraphDebugDotFlags flag) override {
     size_t sOffsetOrig = 0;
@@ -1818,6 +2010,8 @@ class GraphMemsetNode : public GraphNode {
     std::memcpy(params, &memsetParams_, sizeof(hipMemsetParams));
   }
 
+  size_t GetDepth() const { return depth_; }
+
   void GetParams(HIP_MEMSET_NODE_PARAMS* params) {
     params->dst = memsetParams_.dst;
     params->elementSize = memsetParams_.elementSize;
@@ -1913,6 +2107,15 @@ class GraphMemsetNode : public GraphNode {
     const GraphMemsetNode* memsetNode = static_cast<GraphMemsetNode const*>(node);
     return SetParams(&memsetNode->memsetParams_, false, memsetNode->depth_);
   }
+
+  bool HasSameParams(const GraphNode* node) const override {
+    const GraphMemsetNode* memsetNode = static_cast<GraphMemsetNode const*>(node);
+    const hipMemsetParams& params = memsetNode->memsetParams_;
+    return (params.dst == memsetParams_.dst) && (params.elementSize == memsetParams_.elementSize) &&
+           (params.width == memsetParams_.width) && (params.height == memsetParams_.height) &&
+           (params.pitch == memsetParams_.pitch) && (params.value == memsetParams_.value) &&
+           (memsetNode->depth_ == depth_);
+  }
 };
 
 class GraphEventRecordNode : public GraphNode {
@@ -1967,6 +2170,10 @@ class GraphEventRecordNode : public GraphNode {
         static_cast<GraphEventRecordNode const*>(node);
     return SetParams(eventRecordNode->event_);
   }
+
+  bool HasSameParams(const GraphNode* node) const override {
+    return static_cast<GraphEventRecordNode const*>(node)->event_ == event_;
+  }
 };
 
 class GraphEventWaitNode : public GraphNode {
@@ -2020,6 +2227,10 @@ class GraphEventWaitNode : public GraphNode {
     const GraphEventWaitNode* eventWaitNode = static_cast<GraphEventWaitNode const*>(node);
     return SetParams(eventWaitNode->event_);
   }
+
+  bool HasSameParams(const GraphNode* node) const override {
+    return static_cast<GraphEventWaitNode const*>(node)->event_ == event_;
+  }
 };
 
 class GraphHostNode : public GraphNode {
@@ -2089,6 +2300,12 @@ class GraphHostNode : public GraphNode {
     const GraphHostNode* hostNode = static_cast<GraphHostNode const*>(node);
     return SetParams(&hostNode->NodeParams_);
   }
+
+  bool HasSameParams(const GraphNode* node) const override {
+    const GraphHostNode* hostNode = static_cast<GraphHostNode const*>(node);
+    return (hostNode->NodeParams_.fn == NodeParams_.fn) &&
+           (hostNode->NodeParams_.userData == NodeParams_.userData);
+  }
 };
 
 class GraphEmptyNode : public GraphNode {
@@ -2100,6 +2317,8 @@ class GraphEmptyNode : public GraphNode {
     return new GraphEmptyNode(static_cast<GraphEmptyNode const&>(*this));
   }
 
+  bool HasSameParams(const GraphNode* node) const override { return true; }
+
   hipError_t CreateCommand(hip::Stream* stream) override {
     hipError_t status = GraphNode::CreateCommand(stream);
     if (status != hipSuccess) {
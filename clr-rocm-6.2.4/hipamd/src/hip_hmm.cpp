@@ -21,6 +21,7 @@
 #include <hip/hip_runtime.h>
 #include "hip_internal.hpp"
 #include "hip_conversions.hpp"
+#include "hip_hmm_ranges.hpp"
 #include "platform/context.hpp"
 #include "platform/command.hpp"
 #include "platform/memory.hpp"
@@ -61,6 +62,183 @@ static_assert(static_cast<uint32_t>(hipMemRangeAttributeAccessedBy) ==
 static_assert(static_cast<uint32_t>(hipMemRangeAttributeLastPrefetchLocation) ==
               amd::MemRangeAttribute::LastPrefetchLocation, "Enum mismatch with ROCclr!");
 
+namespace {
+/*! \brief Per allocation view of the advice and prefetch requests the application made
+ *
+ *  The view only reflects requests made through the runtime. Copies through the runtime forget
+ *  the prefetch location of their ranges, but pages can still migrate on host access or faults.
+ *  A skipped prefetch never affects correctness, only where the first touch is served from, so
+ *  the tracking is opt-in with HIP_HMM_RANGE_TRACKING. Each request is narrowed on its own,
+ *  separate requests for adjacent ranges still issue separate commands.
+ */
+class HmmRangeTracker {
+ public:
+  static HmmRangeTracker& instance() {
+    // Never destroyed, hipFree can still run during the process teardown
+    static HmmRangeTracker* tracker = new HmmRangeTracker();
+    return *tracker;
+  }
+
+  //! Narrows a device prefetch to the part not prefetched there yet, false if nothing is left
+  bool NarrowPrefetch(amd::Memory* memObj, int device, size_t* offset, size_t* count) {
+    amd::ScopedLock lock(lock_);
+    size_t begin = *offset;
+    size_t end = *offset + *count;
+    ++stats_.prefetches_;
+    // Pages return to the CPU on any host access, so CPU prefetches are always issued
+    if ((device != hipCpuDeviceId) &&
+        !HmmNarrowPrefetch(GetRanges(memObj), device, &begin, &end)) {
+      ++stats_.prefetchesSkipped_;
+      ClPrint(amd::LOG_INFO, amd::LOG_MEM, "Skipped prefetch of [%p, +%zu) to device %d, "
+              "%lu of %lu prefetches skipped, %lu narrowed", memObj->getSvmPtr(), *count, device,
+              stats_.prefetchesSkipped_, stats_.prefetches_, stats_.prefetchesNarrowed_);
+      return false;
+    }
+    if ((end - begin) != *count) {
+      ++stats_.prefetchesNarrowed_;
+    }
+    *offset = begin;
+    *count = end - begin;
+    return true;
+  }
+
+  //! Records a prefetch the stream accepted, the whole requested range ends up at the device
+  void RecordPrefetch(amd::Memory* memObj, int device, size_t offset, size_t count) {
+    amd::ScopedLock lock(lock_);
+    GetRanges(memObj).Update(offset, offset + count,
+                             [device](HmmRangeState& state) { state.prefetchLocation_ = device; });
+  }
+
+  //! Returns true if the whole range already has the advice
+  bool IsAdviceRedundant(amd::Memory* memObj, size_t offset, size_t count,
+                         hipMemoryAdvise advice, int device) {
+    amd::ScopedLock lock(lock_);
+    ++stats_.advices_;
+    bool redundant = true;
+    GetRanges(memObj).ForEach(offset, offset + count,
+        [&](size_t, size_t, const HmmRangeState& state) {
+      HmmRangeState updated = state;
+      redundant &= ApplyAdvice(&updated, advice, device) && (updated == state);
+    });
+    if (redundant) {
+      ++stats_.advicesSkipped_;
+      ClPrint(amd::LOG_INFO, amd::LOG_MEM, "Skipped advice %d on [%p, +%zu), "
+              "%lu of %lu advices skipped", advice, memObj->getSvmPtr(), count,
+              stats_.advicesSkipped_, stats_.advices_);
+    }
+    return redundant;
+  }
+
+  //! Records an advice the device accepted
+  void RecordAdvice(amd::Memory* memObj, size_t offset, size_t count, hipMemoryAdvise advice,
+                    int device) {
+    amd::ScopedLock lock(lock_);
+    GetRanges(memObj).Update(offset, offset + count,
+                             [&](HmmRangeState& state) { ApplyAdvice(&state, advice, device); });
+  }
+
+  //! Forgets the prefetch location of a range, which a copy may have migrated
+  void ForgetPrefetch(amd::Memory* memObj, size_t offset, size_t count) {
+    if (numAllocations_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    amd::ScopedLock lock(lock_);
+    auto it = allocations_.find(memObj);
+    if (it != allocations_.end()) {
+      it->second.Update(offset, offset + count, [](HmmRangeState& state) {
+        state.prefetchLocation_ = HmmRangeState::kUnknown;
+      });
+    }
+  }
+
+  //! Returns a snapshot of the tracking counters
+  HmmRangeStats Stats() {
+    amd::ScopedLock lock(lock_);
+    return stats_;
+  }
+
+  //! Drops the view of an allocation that is freed
+  void Remove(amd::Memory* memObj) {
+    if (numAllocations_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    amd::ScopedLock lock(lock_);
+    allocations_.erase(memObj);
+    numAllocations_.store(allocations_.size(), std::memory_order_relaxed);
+  }
+
+ private:
+  HmmRangeTracker() : lock_("HMM range tracker lock", true), numAllocations_(0) {}
+
+  //! Applies an advice to the state, returns false if the advice isn't tracked
+  static bool ApplyAdvice(HmmRangeState* state, hipMemoryAdvise advice, int device) {
+    uint64_t bit = HmmRangeState::LocationBit(device);
+    switch (advice) {
+      case hipMemAdviseSetReadMostly:
+        state->readMostly_ = 1;
+        return true;
+      case hipMemAdviseUnsetReadMostly:
+        state->readMostly_ = 0;
+        return true;
+      case hipMemAdviseSetPreferredLocation:
+        state->preferredLocation_ = device;
+        return true;
+      case hipMemAdviseUnsetPreferredLocation:
+        state->preferredLocation_ = HmmRangeState::kNone;
+        return true;
+      case hipMemAdviseSetAccessedBy:
+        state->accessedByKnown_ |= bit;
+        state->accessedBy_ |= bit;
+        return (bit != 0);
+      case hipMemAdviseUnsetAccessedBy:
+        state->accessedByKnown_ |= bit;
+        state->accessedBy_ &= ~bit;
+        return (bit != 0);
+      case hipMemAdviseSetCoarseGrain:
+        state->coarseGrain_ = 1;
+        return true;
+      case hipMemAdviseUnsetCoarseGrain:
+        state->coarseGrain_ = 0;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  //! Returns the ranges of an allocation, a new or resized allocation starts unknown
+  RangeMap<HmmRangeState>& GetRanges(amd::Memory* memObj) {
+    auto it = allocations_.find(memObj);
+    if ((it == allocations_.end()) || (it->second.Size() != memObj->getSize())) {
+      it = allocations_.insert_or_assign(memObj, RangeMap<HmmRangeState>(memObj->getSize())).first;
+      numAllocations_.store(allocations_.size(), std::memory_order_relaxed);
+    }
+    return it->second;
+  }
+
+  amd::Monitor lock_;                                                 //!< Lock for the maps
+  std::unordered_map<amd::Memory*, RangeMap<HmmRangeState>> allocations_;  //!< Tracked memory
+  std::atomic<size_t> numAllocations_;  //!< Number of tracked allocations, read without the lock
+  HmmRangeStats stats_;                 //!< Tracking counters
+};
+}  // namespace
+
+// ================================================================================================
+void ihipHmmRangesRemove(amd::Memory* memObj) {
+  HmmRangeTracker::instance().Remove(memObj);
+}
+
+// ================================================================================================
+void ihipHmmRangesCopied(amd::Memory* memObj, size_t offset, size_t count) {
+  if (HIP_HMM_RANGE_TRACKING && (memObj != nullptr)) {
+    HmmRangeTracker::instance().ForgetPrefetch(memObj, offset, count);
+  }
+}
+
+// ================================================================================================
+void ihipHmmRangesStats(HmmRangeStats* stats) {
+  *stats = HmmRangeTracker::instance().Stats();
+}
+
 // ================================================================================================
 hipError_t hipMallocManaged(void** dev_ptr, size_t size, unsigned int flags) {
   HIP_INIT_API(hipMallocManaged, dev_ptr, size, flags);
@@ -118,6 +296,17 @@ hipError_t hipMemPrefetchAsync(const void* dev_ptr, size_t count, int device,
     HIP_RETURN(hipErrorInvalidValue);
   }
 
+  // Drop or narrow the prefetch if the range is already at the device
+  bool track = (memObj != nullptr) && HIP_HMM_RANGE_TRACKING;
+  size_t requested = count;
+  if (track) {
+    size_t prefetch_offset = offset;
+    if (!HmmRangeTracker::instance().NarrowPrefetch(memObj, device, &prefetch_offset, &count)) {
+      HIP_RETURN(hipSuccess);
+    }
+    dev_ptr = reinterpret_cast<const char*>(dev_ptr) + (prefetch_offset - offset);
+  }
+
   amd::Command::EventWaitList waitList;
   amd::SvmPrefetchAsyncCommand* command =
       new amd::SvmPrefetchAsyncCommand(*hip_stream, waitList, dev_ptr, count, dev, cpu_access);
@@ -126,6 +315,10 @@ hipError_t hipMemPrefetchAsync(const void* dev_ptr, size_t count, int device,
   }
 
   command->enqueue();
+  // A prefetch the device rejected leaves the range where it was, so it must not be recorded
+  if (track && (command->status() >= CL_COMPLETE)) {
+    HmmRangeTracker::instance().RecordPrefetch(memObj, device, offset, requested);
+  }
   command->release();
 
   HIP_RETURN(hipSuccess);
@@ -157,10 +350,19 @@ hipError_t hipMemAdvise(const void* dev_ptr, size_t count, hipMemoryAdvise advic
     g_devices[0]->devices()[0] : g_devices[device]->devices()[0];
   bool use_cpu = (device == hipCpuDeviceId) ? true : false;
 
+  bool track = (memObj != nullptr) && HIP_HMM_RANGE_TRACKING;
+  if (track && HmmRangeTracker::instance().IsAdviceRedundant(memObj, offset, count, advice,
+                                                             device)) {
+    HIP_RETURN(hipSuccess);
+  }
+
   // Set the allocation attributes in AMD HMM
   if (!dev->SetSvmAttributes(dev_ptr, count, static_cast<amd::MemoryAdvice>(advice), use_cpu)) {
     HIP_RETURN(hipErrorInvalidValue);
   }
+  if (track) {
+    HmmRangeTracker::instance().RecordAdvice(memObj, offset, count, advice, device);
+  }
 
   HIP_RETURN(hipSuccess);
 }
@@ -0,0 +1,177 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+
+// Only the standard library is used here, so the range logic can be built and tested on the host
+// without the runtime.
+namespace hip {
+
+/*! \brief Map of the byte range [0, size) to values of T
+ *
+ *  The range is always fully covered by non-overlapping segments. Neighbouring segments with equal
+ *  values are merged on every update, so the number of segments stays proportional to the number
+ *  of distinct regions.
+ */
+template <typename T> class RangeMap {
+ public:
+  explicit RangeMap(size_t size, const T& value = T()) : size_(size) {
+    if (size_ > 0) {
+      segments_.emplace(0, Segment{size_, value});
+    }
+  }
+
+  //! Returns the size of the mapped range
+  size_t Size() const { return size_; }
+
+  //! Returns the number of segments
+  size_t NumSegments() const { return segments_.size(); }
+
+  //! Calls fn(begin, end, value) for every segment that overlaps [begin, end), clipped to it
+  template <typename Fn> void ForEach(size_t begin, size_t end, Fn fn) const {
+    end = std::min(end, size_);
+    if (begin >= end) {
+      return;
+    }
+    auto it = std::prev(segments_.upper_bound(begin));
+    for (; (it != segments_.end()) && (it->first < end); ++it) {
+      fn(std::max(begin, it->first), std::min(end, it->second.end_), it->second.value_);
+    }
+  }
+
+  //! Calls update(value) on [begin, end), splitting the segments on the boundaries
+  template <typename Fn> void Update(size_t begin, size_t end, Fn update) {
+    end = std::min(end, size_);
+    if (begin >= end) {
+      return;
+    }
+    Split(begin);
+    Split(end);
+    for (auto it = segments_.find(begin); (it != segments_.end()) && (it->first < end); ++it) {
+      update(it->second.value_);
+    }
+    Merge(begin, end);
+  }
+
+ private:
+  struct Segment {
+    size_t end_;  //!< One past the last byte of the segment
+    T value_;     //!< Value of the whole segment
+  };
+
+  //! Makes sure a segment starts at offset
+  void Split(size_t offset) {
+    if ((offset == 0) || (offset >= size_)) {
+      return;
+    }
+    auto it = std::prev(segments_.upper_bound(offset));
+    if (it->first == offset) {
+      return;
+    }
+    segments_.emplace_hint(std::next(it), offset, Segment{it->second.end_, it->second.value_});
+    it->second.end_ = offset;
+  }
+
+  //! Merges equal neighbours from the segment before begin up to the segment after end
+  void Merge(size_t begin, size_t end) {
+    auto it = segments_.lower_bound(begin);
+    if (it != segments_.begin()) {
+      --it;
+    }
+    auto next = std::next(it);
+    while ((next != segments_.end()) && (next->first <= end)) {
+      if (it->second.value_ == next->second.value_) {
+        it->second.end_ = next->second.end_;
+        next = segments_.erase(next);
+      } else {
+        it = next++;
+      }
+    }
+  }
+
+  size_t size_;                          //!< Size of the mapped range
+  std::map<size_t, Segment> segments_;   //!< Segments, keyed by their first byte
+};
+
+//! Counters of the managed memory range tracking
+struct HmmRangeStats {
+  uint64_t prefetches_ = 0;          //!< Prefetch requests on tracked allocations
+  uint64_t prefetchesSkipped_ = 0;   //!< Prefetches dropped, the range was already there
+  uint64_t prefetchesNarrowed_ = 0;  //!< Prefetches shrunk to the part that wasn't there yet
+  uint64_t advices_ = 0;             //!< Advice requests on tracked allocations
+  uint64_t advicesSkipped_ = 0;      //!< Advice dropped, the range already had it
+};
+
+//! Runtime view of the advice and the last prefetch location of a managed memory range
+struct HmmRangeState {
+  static constexpr int32_t kUnknown = INT32_MIN;  //!< Nothing was recorded
+  static constexpr int32_t kNone = -2;            //!< Matches hipInvalidDeviceId
+
+  int32_t prefetchLocation_ = kUnknown;   //!< Device of the last prefetch, -1 for the CPU
+  int32_t preferredLocation_ = kUnknown;  //!< Preferred location, kNone when it was unset
+  int8_t readMostly_ = -1;                //!< 1 or 0 once read mostly was set or unset
+  int8_t coarseGrain_ = -1;               //!< 1 or 0 once coarse grain was set or unset
+  uint64_t accessedByKnown_ = 0;          //!< Bit per location with a recorded accessed by
+  uint64_t accessedBy_ = 0;               //!< Bit per location with accessed by set
+
+  //! Bit of a location in the accessed by masks, 0 if it can't be tracked
+  static uint64_t LocationBit(int32_t location) {
+    return ((location >= -1) && (location < 63)) ? (1ull << (location + 1)) : 0;
+  }
+
+  bool operator==(const HmmRangeState& rhs) const {
+    return (prefetchLocation_ == rhs.prefetchLocation_) &&
+           (preferredLocation_ == rhs.preferredLocation_) &&
+           (readMostly_ == rhs.readMostly_) && (coarseGrain_ == rhs.coarseGrain_) &&
+           (accessedByKnown_ == rhs.accessedByKnown_) && (accessedBy_ == rhs.accessedBy_);
+  }
+};
+
+/*! \brief Narrows a prefetch of [begin, end) to the part that isn't at location yet
+ *
+ *  Returns false when the whole range was already prefetched to location. Otherwise the range is
+ *  narrowed to span from the first to the last byte that still needs the prefetch, so a single
+ *  command covers every gap.
+ */
+inline bool HmmNarrowPrefetch(const RangeMap<HmmRangeState>& ranges, int32_t location,
+                              size_t* begin, size_t* end) {
+  size_t first = *end;
+  size_t last = *begin;
+  ranges.ForEach(*begin, *end, [&](size_t segBegin, size_t segEnd, const HmmRangeState& state) {
+    if (state.prefetchLocation_ != location) {
+      first = std::min(first, segBegin);
+      last = std::max(last, segEnd);
+    }
+  });
+  if (first >= last) {
+    return false;
+  }
+  *begin = first;
+  *end = last;
+  return true;
+}
+
+}  // namespace hip
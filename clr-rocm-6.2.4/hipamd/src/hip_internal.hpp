@@ -73,6 +73,7 @@ struct Graph;
 struct GraphNode;
 struct GraphExec;
 struct UserObject;
+struct HmmRangeStats;
 class Stream;
 extern void ReleaseGraphExec(int deviceId);
 extern void ReleaseGraphExec(hip::Stream* stream);
@@ -646,6 +647,12 @@ public:
   extern hipError_t ihipGetDeviceProperties(hipDeviceProp_t* props, hipDevice_t device);
 
   extern hipError_t ihipDeviceGet(hipDevice_t* device, int deviceId);
+  //! Drops the managed memory range tracking of a freed allocation
+  extern void ihipHmmRangesRemove(amd::Memory* memObj);
+  //! Forgets where a copied managed memory range was prefetched to
+  extern void ihipHmmRangesCopied(amd::Memory* memObj, size_t offset, size_t count);
+  //! Returns the counters of the managed memory range tracking
+  extern void ihipHmmRangesStats(HmmRangeStats* stats);
   extern hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
                                         uint64_t value, uint64_t mask, unsigned int flags,
                                         size_t sizeBytes);
@@ -0,0 +1,77 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#pragma once
+
+#include <hip/hip_runtime_api.h>
+
+// Only the HIP API types are used here, so the batch logic can be built and tested on the host
+// without the runtime.
+namespace hip {
+
+/*! \brief Checks the arguments of hipExtLaunchKernelBatch() that don't depend on the device
+ *
+ *  Runs before anything is launched or captured: every entry must target stream and name a
+ *  function. Returns the first error found.
+ */
+inline hipError_t ValidateLaunchBatch(const hipFunctionLaunchParams* launchParamsList,
+                                      unsigned int numKernels, hipStream_t stream,
+                                      unsigned int flags) {
+  if ((launchParamsList == nullptr && numKernels != 0) || (flags & ~hipExtAnyOrderLaunch) != 0) {
+    return hipErrorInvalidValue;
+  }
+  // All launches of the batch must target the same stream
+  for (unsigned int i = 0; i < numKernels; ++i) {
+    if (launchParamsList[i].hStream != stream) {
+      return hipErrorInvalidValue;
+    }
+  }
+  for (unsigned int i = 0; i < numKernels; ++i) {
+    if (launchParamsList[i].function == nullptr) {
+      return hipErrorInvalidResourceHandle;
+    }
+  }
+  return hipSuccess;
+}
+
+/*! \brief Captures a launch batch all or nothing
+ *
+ *  Calls validate(i) for every entry first and add(i) only once all entries are valid, so an
+ *  invalid entry leaves the graph unchanged. Returns the first error of either pass.
+ */
+template <typename Validate, typename Add>
+hipError_t CaptureLaunchBatch(unsigned int numKernels, Validate validate, Add add) {
+  for (unsigned int i = 0; i < numKernels; ++i) {
+    hipError_t status = validate(i);
+    if (status != hipSuccess) {
+      return status;
+    }
+  }
+  for (unsigned int i = 0; i < numKernels; ++i) {
+    hipError_t status = add(i);
+    if (status != hipSuccess) {
+      return status;
+    }
+  }
+  return hipSuccess;
+}
+
+}  // namespace hip
@@ -77,6 +77,7 @@ hipError_t ihipFree(void *ptr) {
     // Wait on the device, associated with the current memory object during allocation
     auto device_id = memory_object->getUserData().deviceId;
     g_devices[device_id]->SyncAllStreams();
+    ihipHmmRangesRemove(memory_object);
 
     // Find out if memory belongs to any memory pool
     if (!g_devices[device_id]->FreeMemory(memory_object, nullptr)) {
@@ -401,6 +402,9 @@ hipError_t ihipMemcpyCommand(amd::Command*& command, void* dst, const void* src,
   amd::Memory* srcMemory = getMemoryObject(src, sOffset);
   size_t dOffset = 0;
   amd::Memory* dstMemory = getMemoryObject(dst, dOffset);
+  // A copy can migrate managed pages, so their last prefetch location isn't known anymore
+  ihipHmmRangesCopied(srcMemory, sOffset, sizeBytes);
+  ihipHmmRangesCopied(dstMemory, dOffset, sizeBytes);
   amd::Device* queueDevice = &stream.device();
   amd::CopyMetadata copyMetadata(isAsync, amd::CopyMetadata::CopyEnginePreference::NONE);
   if ((srcMemory == nullptr) && (dstMemory != nullptr)) {
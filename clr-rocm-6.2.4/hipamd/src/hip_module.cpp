@@ -26,6 +26,11 @@
 #include "platform/program.hpp"
 #include "hip_event.hpp"
 #include "hip_platform.hpp"
+#include "hip_launch_batch.hpp"
+#include "thread/threadpool.hpp"
+
+#include <algorithm>
+#include <array>
 
 namespace hip {
 hipError_t ihipModuleLoadData(hipModule_t* module, const void* mmap_ptr, size_t mmap_size);
@@ -495,6 +500,129 @@ hipError_t hipHccModuleLaunchKernel(hipFunction_t f, uint32_t globalWorkSizeX,
                                     extra, startEvent, stopEvent));
 }
 
+hipError_t ihipExtLaunchKernelBatch(const hipFunctionLaunchParams* launchParamsList,
+                                    unsigned int numKernels, hipStream_t hStream,
+                                    unsigned int flags) {
+  int deviceId = hip::Stream::DeviceId(hStream);
+  HIP_RETURN_ONFAIL(PlatformState::instance().initStatManagedVarDevicePtr(deviceId));
+  auto device = g_devices[deviceId]->devices()[0];
+  // Stream lookup and the wait for the active streams are done once for the whole batch
+  hip::Stream* hip_stream = hip::getStream(hStream);
+
+  // Validate all launches and capture their arguments before anything is submitted
+  std::vector<amd::Command*> commands;
+  commands.reserve(numKernels);
+  hipError_t status = hipSuccess;
+  for (unsigned int i = 0; i < numKernels; ++i) {
+    const hipFunctionLaunchParams& launch = launchParamsList[i];
+    if (launch.function == nullptr) {
+      LogPrintfError("Function passed in the batch entry %u is null", i);
+      status = hipErrorInvalidResourceHandle;
+      break;
+    }
+    if (launch.gridDimX > std::numeric_limits<int32_t>::max() ||
+        launch.gridDimY > std::numeric_limits<int32_t>::max() / 1024 ||
+        launch.gridDimZ > std::numeric_limits<int32_t>::max() / 1024) {
+      status = hipErrorInvalidValue;
+      break;
+    }
+    size_t globalWorkSizeX = static_cast<size_t>(launch.gridDimX) * launch.blockDimX;
+    size_t globalWorkSizeY = static_cast<size_t>(launch.gridDimY) * launch.blockDimY;
+    size_t globalWorkSizeZ = static_cast<size_t>(launch.gridDimZ) * launch.blockDimZ;
+    if (globalWorkSizeX > std::numeric_limits<uint32_t>::max()) {
+      status = hipErrorInvalidConfiguration;
+      break;
+    }
+
+    hip::DeviceFunc* function = hip::DeviceFunc::asFunction(launch.function);
+    amd::ScopedLock lock(function->dflock_);
+    status = ihipLaunchKernel_validate(
+        launch.function, static_cast<uint32_t>(globalWorkSizeX),
+        static_cast<uint32_t>(globalWorkSizeY), static_cast<uint32_t>(globalWorkSizeZ),
+        launch.blockDimX, launch.blockDimY, launch.blockDimZ, launch.sharedMemBytes,
+        launch.kernelParams, nullptr, deviceId);
+    if (status != hipSuccess) {
+      break;
+    }
+    // Check if it's a uniform kernel and validate dimensions
+    if (function->kernel()->getDeviceKernel(*device)->getUniformWorkGroupSize()) {
+      if (((globalWorkSizeX % launch.blockDimX) != 0) ||
+          ((globalWorkSizeY % launch.blockDimY) != 0) ||
+          ((globalWorkSizeZ % launch.blockDimZ) != 0)) {
+        status = hipErrorInvalidValue;
+        break;
+      }
+    }
+    amd::Command* command = nullptr;
+    status = ihipLaunchKernelCommand(
+        command, launch.function, static_cast<uint32_t>(globalWorkSizeX),
+        static_cast<uint32_t>(globalWorkSizeY), static_cast<uint32_t>(globalWorkSizeZ),
+        launch.blockDimX, launch.blockDimY, launch.blockDimZ, launch.sharedMemBytes, hip_stream,
+        launch.kernelParams, nullptr, nullptr, nullptr, flags);
+    if (status != hipSuccess) {
+      break;
+    }
+    commands.push_back(command);
+  }
+
+  if (status != hipSuccess) {
+    for (auto command : commands) {
+      command->release();
+    }
+    return status;
+  }
+
+  if (AMD_DIRECT_DISPATCH) {
+    // Hold the execution lock for the whole batch, so the packets and their kernel arguments
+    // are written back to back and the HW is notified with a single doorbell write
+    amd::ScopedLock lock(hip_stream->vdev()->execution());
+    hip_stream->vdev()->beginDispatchBatch();
+    for (auto command : commands) {
+      command->enqueue();
+    }
+    hip_stream->vdev()->endDispatchBatch();
+  } else {
+    for (auto command : commands) {
+      command->enqueue();
+    }
+  }
+
+  for (auto command : commands) {
+    if (command->status() == CL_INVALID_OPERATION) {
+      status = hipErrorIllegalState;
+    }
+    command->release();
+  }
+  return status;
+}
+
+hipError_t hipExtLaunchKernelBatch(const hipFunctionLaunchParams* launchParamsList,
+                                   unsigned int numKernels, hipStream_t stream,
+                                   unsigned int flags) {
+  HIP_INIT_API(hipExtLaunchKernelBatch, launchParamsList, numKernels, stream, flags);
+
+  if (!hip::isValid(stream)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  HIP_RETURN_ONFAIL(hip::ValidateLaunchBatch(launchParamsList, numKernels, stream, flags));
+  if (numKernels == 0) {
+    HIP_RETURN(hipSuccess);
+  }
+
+  hip::getStreamPerThread(stream);
+  if (stream != nullptr &&
+      reinterpret_cast<hip::Stream*>(stream)->GetCaptureStatus() ==
+          hipStreamCaptureStatusActive) {
+    HIP_RETURN(hip::capturehipExtLaunchKernelBatch(stream, launchParamsList, numKernels));
+  } else if (stream != nullptr &&
+             reinterpret_cast<hip::Stream*>(stream)->GetCaptureStatus() ==
+                 hipStreamCaptureStatusInvalidated) {
+    HIP_RETURN(hipErrorStreamCaptureInvalidated);
+  }
+
+  HIP_RETURN(ihipExtLaunchKernelBatch(launchParamsList, numKernels, stream, flags));
+}
+
 hipError_t hipModuleLaunchCooperativeKernel(hipFunction_t f, unsigned int gridDimX,
                                             unsigned int gridDimY, unsigned int gridDimZ,
                                             unsigned int blockDimX, unsigned int blockDimY,
@@ -522,6 +650,24 @@ hipError_t hipModuleLaunchCooperativeKernel(hipFunction_t f, unsigned int gridDi
                   nullptr, 0, amd::NDRangeKernelCommand::CooperativeGroups));
 }
 
+// Worker threads for the per-device submissions of multi-device launches. The pool is released
+// at process exit, it stops its workers before the lock goes away
+static amd::Monitor multiDeviceLaunchLock{"Guards multi-device launch pool"};
+static std::unique_ptr<amd::ThreadPool> multiDeviceLaunchPool;
+
+static amd::ThreadPool* getMultiDeviceLaunchPool() {
+  if (!HIP_PARALLEL_MULTI_DEVICE_LAUNCH || g_devices.size() < 2) {
+    return nullptr;
+  }
+  amd::ScopedLock lock(multiDeviceLaunchLock);
+  if (multiDeviceLaunchPool == nullptr) {
+    // The calling thread submits for one of the devices
+    multiDeviceLaunchPool.reset(new amd::ThreadPool("Multi-device Launch",
+                                                    static_cast<uint>(g_devices.size() - 1)));
+  }
+  return multiDeviceLaunchPool.get();
+}
+
 hipError_t ihipModuleLaunchCooperativeKernelMultiDevice(hipFunctionLaunchParams* launchParamsList,
                                                        unsigned int  numDevices,
                                                        unsigned int  flags,
@@ -566,61 +712,103 @@ hipError_t ihipModuleLaunchCooperativeKernelMultiDevice(hipFunctionLaunchParams*
       return hipErrorInvalidResourceHandle;
     }
   }
-  uint64_t prevGridSize = 0;
   uint32_t firstDevice = 0;
-
-  // Sync the execution streams on all devices
-  if ((flags & hipCooperativeLaunchMultiDeviceNoPreSync) == 0) {
-    for (int i = 0; i < numDevices; ++i) {
-      hip::Stream* hip_stream =
-          reinterpret_cast<hip::Stream*>(launchParamsList[i].hStream);
-      hip_stream->finish();
+  // The order of devices in the launch may not match the order in the global array
+  hip::Stream* first_stream = reinterpret_cast<hip::Stream*>(launchParamsList[0].hStream);
+  for (size_t dev = 0; dev < g_devices.size(); ++dev) {
+    // Find the matching device
+    if (&first_stream->vdev()->device() == g_devices[dev]->devices()[0]) {
+      // Save ROCclr index of the first device in the launch
+      firstDevice = first_stream->vdev()->device().index();
+      break;
     }
   }
 
+  // Compute the grid offsets up front, so the per-device submissions don't depend on each other
+  std::vector<std::array<size_t, 3>> globalWorkSizes(numDevices);
+  std::vector<uint64_t> prevGridSizes(numDevices);
+  uint64_t prevGridSize = 0;
   for (int i = 0; i < numDevices; ++i) {
     const hipFunctionLaunchParams& launch = launchParamsList[i];
-    hip::Stream* hip_stream = reinterpret_cast<hip::Stream*>(launch.hStream);
-
-    if (i == 0) {
-      // The order of devices in the launch may not match the order in the global array
-      for (size_t dev = 0; dev < g_devices.size(); ++dev) {
-        // Find the matching device
-        if (&hip_stream->vdev()->device() == g_devices[dev]->devices()[0]) {
-          // Save ROCclr index of the first device in the launch
-          firstDevice = hip_stream->vdev()->device().index();
-          break;
-        }
+    globalWorkSizes[i] = {static_cast<size_t>(launch.gridDimX) * launch.blockDimX,
+                          static_cast<size_t>(launch.gridDimY) * launch.blockDimY,
+                          static_cast<size_t>(launch.gridDimZ) * launch.blockDimZ};
+    for (auto size : globalWorkSizes[i]) {
+      if (size > std::numeric_limits<uint32_t>::max()) {
+        return hipErrorInvalidConfiguration;
       }
     }
+    prevGridSizes[i] = prevGridSize;
+    prevGridSize += globalWorkSizes[i][0] * globalWorkSizes[i][1] * globalWorkSizes[i][2];
+  }
 
-    size_t globalWorkSizeX = static_cast<size_t>(launch.gridDimX) * launch.blockDimX;
-    size_t globalWorkSizeY = static_cast<size_t>(launch.gridDimY) * launch.blockDimY;
-    size_t globalWorkSizeZ = static_cast<size_t>(launch.gridDimZ) * launch.blockDimZ;
-    if (globalWorkSizeX > std::numeric_limits<uint32_t>::max() ||
-        globalWorkSizeY > std::numeric_limits<uint32_t>::max() ||
-        globalWorkSizeZ > std::numeric_limits<uint32_t>::max()) {
-      return hipErrorInvalidConfiguration;
+  std::vector<hipError_t> results(numDevices, hipSuccess);
+  std::vector<uint64_t> dispatchTimes(numDevices, 0);
+  amd::ThreadPool* pool = getMultiDeviceLaunchPool();
+  // Set by the first failed submission, the devices not submitted yet are skipped then
+  std::atomic<bool> failed(false);
+
+  auto syncStreams = [&](size_t i) {
+    reinterpret_cast<hip::Stream*>(launchParamsList[i].hStream)->finish();
+  };
+  auto launchKernel = [&](size_t i) {
+    if (failed.load(std::memory_order_acquire)) {
+      return;
     }
-    result = ihipModuleLaunchKernel(
-        launch.function, static_cast<uint32_t>(globalWorkSizeX),
-        static_cast<uint32_t>(globalWorkSizeY),
-        static_cast<uint32_t>(globalWorkSizeZ), launch.blockDimX, launch.blockDimY,
+    const hipFunctionLaunchParams& launch = launchParamsList[i];
+    results[i] = ihipModuleLaunchKernel(
+        launch.function, static_cast<uint32_t>(globalWorkSizes[i][0]),
+        static_cast<uint32_t>(globalWorkSizes[i][1]),
+        static_cast<uint32_t>(globalWorkSizes[i][2]), launch.blockDimX, launch.blockDimY,
         launch.blockDimZ, launch.sharedMemBytes, launch.hStream, launch.kernelParams,
         nullptr, nullptr, nullptr, flags, extFlags,
-        i, numDevices, prevGridSize, allGridSize, firstDevice);
-    if (result != hipSuccess) {
+        i, numDevices, prevGridSizes[i], allGridSize, firstDevice);
+    if (results[i] != hipSuccess) {
+      failed.store(true, std::memory_order_release);
+    }
+    dispatchTimes[i] = amd::Os::timeNanos();
+  };
+
+  // Sync the execution streams on all devices
+  if ((flags & hipCooperativeLaunchMultiDeviceNoPreSync) == 0) {
+    if (pool != nullptr) {
+      pool->parallelFor(numDevices, syncStreams);
+    } else {
+      for (int i = 0; i < numDevices; ++i) {
+        syncStreams(i);
+      }
+    }
+  }
+
+  uint64_t start = amd::Os::timeNanos();
+  if (pool != nullptr) {
+    pool->parallelFor(numDevices, launchKernel);
+  } else {
+    for (int i = 0; i < numDevices; ++i) {
+      launchKernel(i);
+    }
+  }
+  for (int i = 0; i < numDevices; ++i) {
+    if (results[i] != hipSuccess) {
+      result = results[i];
       break;
     }
-    prevGridSize += globalWorkSizeX * globalWorkSizeY * globalWorkSizeZ;
+  }
+  if (result == hipSuccess) {
+    auto range = std::minmax_element(dispatchTimes.begin(), dispatchTimes.end());
+    ClPrint(amd::LOG_INFO, amd::LOG_KERN, "Multi-device launch on %u devices: submission %lu us,"
+            " dispatch skew %lu us", numDevices, (*range.second - start) / 1000,
+            (*range.second - *range.first) / 1000);
   }
 
   // Sync the execution streams on all devices
   if ((flags & hipCooperativeLaunchMultiDeviceNoPostSync) == 0) {
-    for (int i = 0; i < numDevices; ++i) {
-      hip::Stream* hip_stream =
-          reinterpret_cast<hip::Stream*>(launchParamsList[i].hStream);
-      hip_stream->finish();
+    if (pool != nullptr) {
+      pool->parallelFor(numDevices, syncStreams);
+    } else {
+      for (int i = 0; i < numDevices; ++i) {
+        syncStreams(i);
+      }
     }
   }
 
@@ -899,6 +899,10 @@ const char* PlatformState::getStatFuncName(const void* hostFunction) {
   return statCO_.getStatFuncName(hostFunction);
 }
 
+const void* PlatformState::getStatHostFunction(const std::string& name) {
+  return statCO_.getStatHostFunction(name);
+}
+
 hipError_t PlatformState::getStatFunc(hipFunction_t* hfunc, const void* hostFunction,
                                       int deviceId) {
   return statCO_.getStatFunc(hfunc, hostFunction, deviceId);
@@ -974,6 +978,81 @@ bool PlatformState::CloseUniqueFileHandle(const std::shared_ptr<UniqueFD>& ufd)
   return true;
 }
 
+const void* PlatformState::AcquireCodeObject(const std::string& key, size_t* size) {
+  amd::ScopedLock lock(co_cache_lock_);
+
+  auto it = co_cache_.find(key);
+  if (it == co_cache_.end()) {
+    return nullptr;
+  }
+
+  ++it->second.refcount_;
+  ++co_cache_stats_.hits_;
+  co_cache_stats_.bytes_saved_ += it->second.size_;
+  *size = it->second.size_;
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Code object cache hit %p, size: %zu, refcount: %zu, "
+          "saved: %zu bytes", it->second.image_, it->second.size_, it->second.refcount_,
+          co_cache_stats_.bytes_saved_);
+  return it->second.image_;
+}
+
+const void* PlatformState::AddCodeObject(const std::string& key, const void* image,
+                                         size_t size) {
+  amd::ScopedLock lock(co_cache_lock_);
+
+  auto key_it = co_cache_keys_.find(image);
+  if (key_it != co_cache_keys_.end()) {
+    // The image is cached already, under this or another key. Share the existing entry, a second
+    // entry would free the same image twice
+    auto it = co_cache_.find(key_it->second);
+    assert(it != co_cache_.end() && it->second.refcount_ > 0);
+    ++it->second.refcount_;
+    return image;
+  }
+
+  auto it = co_cache_.find(key);
+  if (it != co_cache_.end()) {
+    // Another thread extracted the same code object in the meantime, keep the cached copy
+    delete[] reinterpret_cast<const char*>(image);
+    ++it->second.refcount_;
+    return it->second.image_;
+  }
+
+  it = co_cache_.emplace(key, SharedCodeObject(image, size)).first;
+  co_cache_keys_.emplace(image, key);
+  ++it->second.refcount_;
+  ++co_cache_stats_.entries_;
+  co_cache_stats_.bytes_ += size;
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Code object cache add %p, size: %zu, entries: %zu, "
+          "total: %zu bytes", image, size, co_cache_stats_.entries_, co_cache_stats_.bytes_);
+  return image;
+}
+
+void PlatformState::ReleaseCodeObject(const void* image) {
+  amd::ScopedLock lock(co_cache_lock_);
+
+  auto key_it = co_cache_keys_.find(image);
+  guarantee(key_it != co_cache_keys_.end(), "Code object %p isn't in the cache", image);
+  auto it = co_cache_.find(key_it->second);
+  assert(it != co_cache_.end() && it->second.refcount_ > 0);
+
+  if (--it->second.refcount_ == 0) {
+    --co_cache_stats_.entries_;
+    co_cache_stats_.bytes_ -= it->second.size_;
+    ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Code object cache remove %p, size: %zu, entries: %zu, "
+            "total: %zu bytes", image, it->second.size_, co_cache_stats_.entries_,
+            co_cache_stats_.bytes_);
+    delete[] reinterpret_cast<const char*>(image);
+    co_cache_.erase(it);
+    co_cache_keys_.erase(key_it);
+  }
+}
+
+CodeObjectCacheStats PlatformState::GetCodeObjectCacheStats() {
+  amd::ScopedLock lock(co_cache_lock_);
+  return co_cache_stats_;
+}
+
 void* PlatformState::getDynamicLibraryHandle() {
   amd::ScopedLock lock(lock_);
 
@@ -41,6 +41,23 @@ struct UniqueFD {
   const size_t fsize_;             //!< File Size
 };
 
+// Code object extracted from a bundle, shared by all modules and devices with the same ISA
+struct SharedCodeObject {
+  SharedCodeObject(const void* image, size_t size) : image_(image), size_(size), refcount_(0) {}
+
+  const void* image_;              //!< Extracted code object, owned by the cache
+  const size_t size_;              //!< Code object size
+  size_t refcount_;                //!< Number of FatBinaryDeviceInfo referencing image_
+};
+
+// Memory statistics of the shared code object cache
+struct CodeObjectCacheStats {
+  size_t entries_ = 0;             //!< Number of cached code objects
+  size_t bytes_ = 0;               //!< Memory held by cached code objects
+  size_t hits_ = 0;                //!< Number of extractions served from the cache
+  size_t bytes_saved_ = 0;         //!< Memory not duplicated thanks to the cache hits
+};
+
 namespace hip {
 class PlatformState {
   amd::Monitor lock_{"Guards PlatformState globals", true};
@@ -48,6 +65,9 @@ class PlatformState {
   // global level lock for unique file descritor map: ufd_map_
   amd::Monitor ufd_lock_{"Unique FD Store Lock", true};
 
+  // global level lock for the shared code object cache: co_cache_
+  amd::Monitor co_cache_lock_{"Shared Code Object Cache Lock", true};
+
   // Singleton object
   static PlatformState* platform_;
   PlatformState() {}
@@ -89,6 +109,7 @@ class PlatformState {
   hipError_t registerStatManagedVar(hip::Var* var);
 
   const char* getStatFuncName(const void* hostFunction);
+  const void* getStatHostFunction(const std::string& name);
   hipError_t getStatFunc(hipFunction_t* hfunc, const void* hostFunction, int deviceId);
   hipError_t getStatFuncAttr(hipFuncAttributes* func_attr, const void* hostFunction, int deviceId);
   hipError_t getStatGlobalVar(const void* hostVar, int deviceId, hipDeviceptr_t* dev_ptr,
@@ -110,6 +131,14 @@ class PlatformState {
 
   size_t UfdMapSize() const { return ufd_map_.size(); }
 
+  // Shared code object cache. The key is built from the SHA-256 of the bundle and the ISA.
+  // Acquire returns nullptr on a miss, Add takes the ownership of image and returns the cached
+  // copy. Both take a reference, which is dropped with ReleaseCodeObject.
+  const void* AcquireCodeObject(const std::string& key, size_t* size);
+  const void* AddCodeObject(const std::string& key, const void* image, size_t size);
+  void ReleaseCodeObject(const void* image);
+  CodeObjectCacheStats GetCodeObjectCacheStats();
+
  private:
   // Dynamic Code Object map, keyin module to get the corresponding object
   std::unordered_map<hipModule_t, hip::DynCO*> dynCO_map_;
@@ -119,6 +148,10 @@ class PlatformState {
 
   std::unordered_map<std::string, std::shared_ptr<UniqueFD>> ufd_map_; //!< Unique File Desc Map
 
+  std::unordered_map<std::string, SharedCodeObject> co_cache_;  //!< Shared Code Object Map
+  std::unordered_map<const void*, std::string> co_cache_keys_;   //!< Image to co_cache_ key
+  CodeObjectCacheStats co_cache_stats_;                          //!< Cache statistics
+
   void* dynamicLibraryHandle_{nullptr};
 };
 }  // namespace hip
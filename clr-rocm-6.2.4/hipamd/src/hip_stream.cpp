@@ -21,6 +21,7 @@
 #include <hip/hip_runtime.h>
 #include "hip_internal.hpp"
 #include "hip_event.hpp"
+#include "hip_graph_internal.hpp"
 #include "thread/monitor.hpp"
 #include "hip_prof_api.h"
 
@@ -387,6 +388,9 @@ hipError_t hipStreamDestroy(hipStream_t stream) {
     if (s->GetParentStream() != nullptr) {
       reinterpret_cast<hip::Stream*>(s->GetParentStream())->EraseParallelCaptureStream(stream);
     }
+    if (s->IsOriginStream()) {
+      s->GetCaptureGraph()->EndCapture();
+    }
     auto error = s->EndCapture();
   }
   s->GetDevice()->RemoveStreamFromPools(s);
@@ -418,11 +422,7 @@ hipError_t hipStreamDestroy(hipStream_t stream) {
 // ================================================================================================
 void WaitThenDecrementSignal(hipStream_t stream, hipError_t status, void* user_data) {
   CallbackData* data =  reinterpret_cast<CallbackData*>(user_data);
-  int offset = data->previous_read_index % IPC_SIGNALS_PER_EVENT;
-  while (data->shmem->read_index < data->previous_read_index + IPC_SIGNALS_PER_EVENT &&
-         data->shmem->signal[offset] != 0) {
-    amd::Os::sleep(1);
-  }
+  hip::ihipIpcEventWait(data->shmem, data->previous_read_index);
   delete data;
 }
 
@@ -23,21 +23,16 @@
 #include "platform/command_utils.hpp"
 
 namespace hip {
-hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
-                               uint64_t value, uint64_t mask, unsigned int flags, size_t sizeBytes) {
-  size_t offset = 0;
-  unsigned int outFlags = 0;
-
+// Validates a stream operation and resolves its memory object and wait condition
+static hipError_t ihipStreamOperationValidate(cl_command_type cmdType, void* ptr,
+                                              unsigned int flags, amd::Memory** memory,
+                                              size_t* offset, unsigned int* outFlags) {
   if (ptr == nullptr) {
     return hipErrorInvalidValue;
   }
 
-  if (!hip::isValid(stream)) {
-    return hipErrorContextIsDestroyed;
-  }
-
-  amd::Memory* memory = getMemoryObject(ptr, offset);
-  if (!memory) {
+  *memory = getMemoryObject(ptr, *offset);
+  if (*memory == nullptr) {
     return hipErrorInvalidValue;
   }
 
@@ -46,21 +41,21 @@ hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void
 
   if (cmdType == ROCCLR_COMMAND_STREAM_WAIT_VALUE) {
       // Stream Wait on AQL barrier-value type packet is only supported on SignalMemory objects
-      if (GPU_STREAMOPS_CP_WAIT && (!(memory->getMemFlags() & ROCCLR_MEM_HSA_SIGNAL_MEMORY))) {
+      if (GPU_STREAMOPS_CP_WAIT && (!((*memory)->getMemFlags() & ROCCLR_MEM_HSA_SIGNAL_MEMORY))) {
       return hipErrorInvalidValue;
     }
     switch (flags) {
       case hipStreamWaitValueGte:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_GTE;
+        *outFlags = ROCCLR_STREAM_WAIT_VALUE_GTE;
       break;
       case hipStreamWaitValueEq:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_EQ;
+        *outFlags = ROCCLR_STREAM_WAIT_VALUE_EQ;
       break;
       case hipStreamWaitValueAnd:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_AND;
+        *outFlags = ROCCLR_STREAM_WAIT_VALUE_AND;
       break;
       case hipStreamWaitValueNor:
-        outFlags = ROCCLR_STREAM_WAIT_VALUE_NOR;
+        *outFlags = ROCCLR_STREAM_WAIT_VALUE_NOR;
       break;
       default:
         return hipErrorInvalidValue;
@@ -69,6 +64,28 @@ hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void
   } else if (cmdType != ROCCLR_COMMAND_STREAM_WRITE_VALUE) {
     return hipErrorInvalidValue;
   }
+  return hipSuccess;
+}
+
+hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
+                               uint64_t value, uint64_t mask, unsigned int flags, size_t sizeBytes) {
+  size_t offset = 0;
+  unsigned int outFlags = 0;
+  amd::Memory* memory = nullptr;
+
+  if (ptr == nullptr) {
+    return hipErrorInvalidValue;
+  }
+
+  if (!hip::isValid(stream)) {
+    return hipErrorContextIsDestroyed;
+  }
+
+  hipError_t status = ihipStreamOperationValidate(cmdType, ptr, flags, &memory, &offset,
+                                                  &outFlags);
+  if (status != hipSuccess) {
+    return status;
+  }
 
   hip::Stream* hip_stream = hip::getStream(stream);
   amd::Command::EventWaitList waitList;
@@ -85,6 +102,74 @@ hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void
   return hipSuccess;
 }
 
+hipError_t ihipStreamBatchOperation(hipStream_t stream, unsigned int count,
+                                    hipStreamBatchMemOpParams* paramArray, unsigned int flags) {
+  if ((count == 0) || (paramArray == nullptr) || (flags != 0)) {
+    return hipErrorInvalidValue;
+  }
+
+  if (!hip::isValid(stream)) {
+    return hipErrorContextIsDestroyed;
+  }
+
+  // Validate the whole batch before anything is enqueued
+  std::vector<amd::StreamBatchOperationCommand::Operation> ops(count);
+  for (unsigned int i = 0; i < count; ++i) {
+    const hipStreamBatchMemOpParams& param = paramArray[i];
+    amd::StreamBatchOperationCommand::Operation& op = ops[i];
+    switch (param.operation) {
+      case hipStreamMemOpWaitValue32:
+        op.type_ = ROCCLR_COMMAND_STREAM_WAIT_VALUE;
+        op.sizeBytes_ = sizeof(uint32_t);
+      break;
+      case hipStreamMemOpWriteValue32:
+        op.type_ = ROCCLR_COMMAND_STREAM_WRITE_VALUE;
+        op.sizeBytes_ = sizeof(uint32_t);
+      break;
+      case hipStreamMemOpWaitValue64:
+        op.type_ = ROCCLR_COMMAND_STREAM_WAIT_VALUE;
+        op.sizeBytes_ = sizeof(uint64_t);
+      break;
+      case hipStreamMemOpWriteValue64:
+        op.type_ = ROCCLR_COMMAND_STREAM_WRITE_VALUE;
+        op.sizeBytes_ = sizeof(uint64_t);
+      break;
+      default:
+        return hipErrorInvalidValue;
+      break;
+    }
+
+    op.flags_ = 0;
+    hipError_t status = ihipStreamOperationValidate(op.type_, param.address, param.flags,
+                                                    &op.memory_, &op.offset_, &op.flags_);
+    if (status != hipSuccess) {
+      return status;
+    }
+    // 32 bit operations use the low half of value and mask, as hipStreamWaitValue32 does
+    if (op.sizeBytes_ == sizeof(uint32_t)) {
+      op.value_ = static_cast<uint32_t>(param.value);
+      op.mask_ = static_cast<uint32_t>(param.mask);
+    } else {
+      op.value_ = param.value;
+      op.mask_ = param.mask;
+    }
+    op.memory_ = op.memory_->asBuffer();
+  }
+
+  hip::Stream* hip_stream = hip::getStream(stream);
+  amd::Command::EventWaitList waitList;
+
+  amd::StreamBatchOperationCommand* command =
+    new amd::StreamBatchOperationCommand(*hip_stream, waitList, std::move(ops));
+
+  if (command == nullptr) {
+    return hipErrorOutOfMemory;
+  }
+  command->enqueue();
+  command->release();
+  return hipSuccess;
+}
+
 hipError_t hipStreamWaitValue32(hipStream_t stream, void* ptr, uint32_t value, unsigned int flags,
                                 uint32_t mask) {
   HIP_INIT_API(hipStreamWaitValue32, stream, ptr, value, mask, flags);
@@ -136,4 +221,10 @@ hipError_t hipStreamWriteValue64(hipStream_t stream, void* ptr, uint64_t value,
       0,  // flags un-used for now set it to 0
       sizeof(uint64_t)));
 }
+
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags) {
+  HIP_INIT_API(hipStreamBatchMemOp, stream, count, paramArray, flags);
+  HIP_RETURN_DURATION(ihipStreamBatchOperation(stream, count, paramArray, flags));
+}
 }  // namespace hip
@@ -1775,4 +1775,21 @@ hipError_t hipMemcpy2DArrayToArray(hipArray_t dst, size_t wOffsetDst, size_t hOf
                                    size_t width, size_t height, hipMemcpyKind kind) {
   return hip::GetHipDispatchTable()->hipMemcpy2DArrayToArray_fn(
       dst, wOffsetDst, hOffsetDst, src, wOffsetSrc, hOffsetSrc, width, height, kind);
-}
\ No newline at end of file
+}
+extern "C" hipError_t hipExtLaunchKernelBatch(const hipFunctionLaunchParams* launchParamsList,
+                                              unsigned int numKernels, hipStream_t stream,
+                                              unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipExtLaunchKernelBatch_fn(launchParamsList, numKernels,
+                                                                stream, flags);
+}
+extern "C" hipError_t hipExtGraphSave(hipGraph_t graph, const char* path, unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipExtGraphSave_fn(graph, path, flags);
+}
+extern "C" hipError_t hipExtGraphLoad(hipGraph_t* pGraph, const char* path, unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipExtGraphLoad_fn(pGraph, path, flags);
+}
+extern "C" hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                                          hipStreamBatchMemOpParams* paramArray,
+                                          unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipStreamBatchMemOp_fn(stream, count, paramArray, flags);
+}
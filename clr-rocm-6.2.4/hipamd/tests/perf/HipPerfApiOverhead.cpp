@@ -0,0 +1,79 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfApiOverhead.h"
+
+#include <sstream>
+
+static const unsigned int Iterations = 1000000;
+
+static const char* ApiNames[] = {"hipGetDevice", "hipPeekAtLastError", "hipStreamQuery"};
+static const unsigned int NumApis = sizeof(ApiNames) / sizeof(ApiNames[0]);
+
+HipPerfApiOverhead::HipPerfApiOverhead() : stream_(nullptr) { _numSubTests = NumApis; }
+
+HipPerfApiOverhead::~HipPerfApiOverhead() {}
+
+void HipPerfApiOverhead::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->streamCreate(&stream_));
+}
+
+void HipPerfApiOverhead::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  int device = 0;
+  HipPerfTimer timer;
+  timer.Start();
+  switch (_openTest) {
+    case 0:
+      for (unsigned int i = 0; i < Iterations; ++i) {
+        CHECK_BACKEND(backend_->getDevice(&device));
+      }
+      break;
+    case 1:
+      for (unsigned int i = 0; i < Iterations; ++i) {
+        CHECK_BACKEND(backend_->peekAtLastError());
+      }
+      break;
+    case 2:
+      // The stream is idle, so this measures the entry and the status check only
+      for (unsigned int i = 0; i < Iterations; ++i) {
+        CHECK_BACKEND(backend_->streamQuery(stream_));
+      }
+      break;
+  }
+  timer.Stop();
+
+  std::stringstream stream;
+  stream << ApiNames[_openTest] << " call time (ns)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e9 / Iterations);
+}
+
+unsigned int HipPerfApiOverhead::close(void) {
+  if (stream_ != nullptr) {
+    backend_->streamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  return HipPerfTest::close();
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#ifndef _HIP_PERF_BACKEND_H_
+#define _HIP_PERF_BACKEND_H_
+
+#include <cstddef>
+#include <string>
+
+/*! \brief The device interface the benchmarks are written against
+ *
+ *  "hip" forwards every call to the HIP runtime. "null" is a mock device, which only runs the queue
+ *  helpers of the ROCm backend (KernArgCache, DoorbellBatch and BarrierCoalescer) and completes
+ *  all work immediately. It implements the API calls itself, so it measures those helpers without
+ *  a GPU, but not the host path of HIP. Other backends are shared libraries, which export
+ *  HipPerfCreateBackend().
+ *
+ *  All calls return false on failure and leave a message in error().
+ */
+class HipPerfBackend {
+ public:
+  typedef void* Stream;
+  typedef void* Event;
+  typedef void* Function;
+  typedef void* Module;
+  typedef void* Graph;
+  typedef void* GraphExec;
+
+  //! The largest number of kernel arguments, every argument is a pointer
+  static constexpr unsigned int MaxKernelArgs = 64;
+
+  virtual ~HipPerfBackend() {}
+
+  virtual const char* name() const = 0;
+  virtual bool init(unsigned int deviceId) = 0;
+  const std::string& error() const { return error_; }
+
+  //! The cheapest API entry: validates and returns the current device
+  virtual bool getDevice(int* device) = 0;
+  //! An API entry, which reads the error state of the calling thread
+  virtual bool peekAtLastError() = 0;
+
+  virtual bool streamCreate(Stream* stream) = 0;
+  virtual bool streamDestroy(Stream stream) = 0;
+  virtual bool streamSynchronize(Stream stream) = 0;
+  virtual bool streamQuery(Stream stream) = 0;
+  virtual bool streamWaitEvent(Stream stream, Event event) = 0;
+
+  virtual bool eventCreate(Event* event) = 0;
+  virtual bool eventDestroy(Event event) = 0;
+  virtual bool eventRecord(Event event, Stream stream) = 0;
+
+  virtual bool mallocAsync(void** ptr, size_t size, Stream stream) = 0;
+  virtual bool freeAsync(void* ptr, Stream stream) = 0;
+
+  //! Returns an empty kernel, which takes \a numArgs pointers
+  virtual bool getKernel(unsigned int numArgs, Function* function) = 0;
+  virtual bool launchKernel(Function function, void** args, Stream stream) = 0;
+  //! Launches \a count kernels with a single call, args[i] are the arguments of launch i
+  virtual bool launchKernelBatch(Function function, void*** args, unsigned int count,
+                                 Stream stream) = 0;
+
+  virtual bool beginCapture(Stream stream) = 0;
+  virtual bool endCapture(Stream stream, Graph* graph) = 0;
+  virtual bool graphInstantiate(Graph graph, GraphExec* exec) = 0;
+  virtual bool graphLaunch(GraphExec exec, Stream stream) = 0;
+  virtual bool graphDestroy(Graph graph) = 0;
+  virtual bool graphExecDestroy(GraphExec exec) = 0;
+
+  //! Returns a code object with the kernels of getKernel()
+  virtual bool getCodeObject(const void** image, size_t* size) = 0;
+  virtual bool moduleLoad(const void* image, Module* module) = 0;
+  virtual bool moduleUnload(Module module) = 0;
+
+  //! Returns the counters of the backend since the last call, or an empty string
+  virtual std::string stats() { return std::string(); }
+
+ protected:
+  bool fail(const std::string& msg) {
+    error_ = msg;
+    return false;
+  }
+
+  std::string error_;
+};
+
+//! Creates the backend \a name: "hip", "null" or the path of a backend library
+HipPerfBackend* HipPerfCreateBackend(const char* name);
+
+HipPerfBackend* HipPerfCreateHipBackend();
+HipPerfBackend* HipPerfCreateNullBackend();
+
+//! The entry point of a backend library
+typedef HipPerfBackend* (*HipPerfCreateBackendFunc)();
+
+#endif  // _HIP_PERF_BACKEND_H_
@@ -0,0 +1,86 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfDispatchSpeed.h"
+
+#include <sstream>
+
+static const unsigned int Iterations = 10000;
+
+static const unsigned int NumArgs[] = {0, 1, 2, 4, 8, 16, 32, 64};
+static const unsigned int NumArgCounts = sizeof(NumArgs) / sizeof(NumArgs[0]);
+
+HipPerfDispatchSpeed::HipPerfDispatchSpeed() : stream_(nullptr), function_(nullptr) {
+  // Every argument count runs with identical and with changing arguments
+  _numSubTests = NumArgCounts * 2;
+}
+
+HipPerfDispatchSpeed::~HipPerfDispatchSpeed() {}
+
+void HipPerfDispatchSpeed::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->streamCreate(&stream_));
+  CHECK_BACKEND(backend_->getKernel(NumArgs[_openTest % NumArgCounts], &function_));
+}
+
+void HipPerfDispatchSpeed::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  const unsigned int numArgs = NumArgs[_openTest % NumArgCounts];
+  const bool changeArgs = (_openTest >= NumArgCounts);
+
+  void* values[HipPerfBackend::MaxKernelArgs] = {};
+  void* args[HipPerfBackend::MaxKernelArgs] = {};
+  for (unsigned int i = 0; i < numArgs; ++i) {
+    values[i] = reinterpret_cast<void*>(static_cast<uintptr_t>(i + 1) << 8);
+    args[i] = &values[i];
+  }
+
+  // Warm up, so lazy initialization isn't measured
+  CHECK_BACKEND(backend_->launchKernel(function_, args, stream_));
+  CHECK_BACKEND(backend_->streamSynchronize(stream_));
+
+  HipPerfTimer timer;
+  timer.Start();
+  for (unsigned int i = 0; i < Iterations; ++i) {
+    if (changeArgs && (numArgs != 0)) {
+      values[0] = reinterpret_cast<void*>(static_cast<uintptr_t>(i));
+    }
+    CHECK_BACKEND(backend_->launchKernel(function_, args, stream_));
+  }
+  CHECK_BACKEND(backend_->streamSynchronize(stream_));
+  timer.Stop();
+
+  std::stringstream stream;
+  stream << "Launch time with " << numArgs << " args, "
+         << (changeArgs ? "changing" : "identical") << " values (us)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / Iterations);
+}
+
+unsigned int HipPerfDispatchSpeed::close(void) {
+  if (stream_ != nullptr) {
+    backend_->streamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  return HipPerfTest::close();
+}
@@ -0,0 +1,128 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfGraph.h"
+
+#include <sstream>
+
+//! The number of kernel nodes created per subtest, spread over the iterations
+static const unsigned int TotalNodes = 65536;
+
+static const unsigned int GraphSizes[] = {1, 16, 256};
+static const unsigned int NumGraphSizes = sizeof(GraphSizes) / sizeof(GraphSizes[0]);
+
+static const char* OpNames[] = {"capture+destroy", "instantiate+destroy", "launch"};
+static const unsigned int NumOps = sizeof(OpNames) / sizeof(OpNames[0]);
+
+static const unsigned int NumArgs = 4;
+
+HipPerfGraph::HipPerfGraph() : stream_(nullptr), function_(nullptr) {
+  _numSubTests = NumGraphSizes * NumOps;
+}
+
+HipPerfGraph::~HipPerfGraph() {}
+
+void HipPerfGraph::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->streamCreate(&stream_));
+  CHECK_BACKEND(backend_->getKernel(NumArgs, &function_));
+}
+
+void HipPerfGraph::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  const unsigned int numNodes = GraphSizes[_openTest % NumGraphSizes];
+  const unsigned int op = _openTest / NumGraphSizes;
+  const unsigned int iterations = TotalNodes / numNodes;
+
+  void* values[NumArgs] = {};
+  void* args[NumArgs] = {};
+  for (unsigned int i = 0; i < NumArgs; ++i) {
+    args[i] = &values[i];
+  }
+
+  // Captures a chain of numNodes kernels with different arguments
+  auto capture = [&](HipPerfBackend::Graph* graph) {
+    if (!backend_->beginCapture(stream_)) {
+      return false;
+    }
+    for (unsigned int n = 0; n < numNodes; ++n) {
+      values[0] = reinterpret_cast<void*>(static_cast<uintptr_t>(n));
+      if (!backend_->launchKernel(function_, args, stream_)) {
+        return false;
+      }
+    }
+    return backend_->endCapture(stream_, graph);
+  };
+
+  HipPerfBackend::Graph graph = nullptr;
+  HipPerfBackend::GraphExec exec = nullptr;
+  HipPerfTimer timer;
+
+  switch (op) {
+    case 0:
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        CHECK_BACKEND(capture(&graph));
+        CHECK_BACKEND(backend_->graphDestroy(graph));
+      }
+      timer.Stop();
+      break;
+    case 1:
+      CHECK_BACKEND(capture(&graph));
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        CHECK_BACKEND(backend_->graphInstantiate(graph, &exec));
+        CHECK_BACKEND(backend_->graphExecDestroy(exec));
+      }
+      timer.Stop();
+      CHECK_BACKEND(backend_->graphDestroy(graph));
+      break;
+    case 2:
+      CHECK_BACKEND(capture(&graph));
+      CHECK_BACKEND(backend_->graphInstantiate(graph, &exec));
+      CHECK_BACKEND(backend_->graphLaunch(exec, stream_));
+      CHECK_BACKEND(backend_->streamSynchronize(stream_));
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        CHECK_BACKEND(backend_->graphLaunch(exec, stream_));
+      }
+      CHECK_BACKEND(backend_->streamSynchronize(stream_));
+      timer.Stop();
+      CHECK_BACKEND(backend_->graphExecDestroy(exec));
+      CHECK_BACKEND(backend_->graphDestroy(graph));
+      break;
+  }
+
+  std::stringstream stream;
+  stream << "Graph " << OpNames[op] << " time, " << numNodes << " kernel nodes (us)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / iterations);
+}
+
+unsigned int HipPerfGraph::close(void) {
+  if (stream_ != nullptr) {
+    backend_->streamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  return HipPerfTest::close();
+}
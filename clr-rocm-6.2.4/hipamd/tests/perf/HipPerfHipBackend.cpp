@@ -0,0 +1,264 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include <hip/hip_runtime.h>
+#include <hip/hiprtc.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "HipPerfBackend.h"
+
+#define HIP_CHECK(call)                                                          \
+  do {                                                                           \
+    hipError_t status = (call);                                                  \
+    if (status != hipSuccess) {                                                  \
+      return fail(std::string(#call) + " failed: " + hipGetErrorString(status)); \
+    }                                                                            \
+  } while (0)
+
+#define HIPRTC_CHECK(call)                                                               \
+  do {                                                                                   \
+    hiprtcResult status = (call);                                                        \
+    if (status != HIPRTC_SUCCESS) {                                                      \
+      return fail(std::string(#call) + " failed: " + hiprtcGetErrorString(status));      \
+    }                                                                                    \
+  } while (0)
+
+//! The HIP runtime. The kernels are compiled with hiprtc for the selected device
+class HipBackend : public HipPerfBackend {
+ public:
+  HipBackend() : module_(nullptr), functions_(MaxKernelArgs + 1, nullptr) {}
+
+  ~HipBackend() {
+    if (module_ != nullptr) {
+      (void)hipModuleUnload(module_);
+    }
+  }
+
+  const char* name() const { return "hip"; }
+
+  bool init(unsigned int deviceId) {
+    int count = 0;
+    HIP_CHECK(hipGetDeviceCount(&count));
+    if (static_cast<int>(deviceId) >= count) {
+      return fail("Device index out of range");
+    }
+    HIP_CHECK(hipSetDevice(deviceId));
+    hipDeviceProp_t props;
+    HIP_CHECK(hipGetDeviceProperties(&props, deviceId));
+    if (!compileKernels(props.gcnArchName)) {
+      return false;
+    }
+    HIP_CHECK(hipModuleLoadData(&module_, code_.data()));
+    return true;
+  }
+
+  bool getDevice(int* device) {
+    HIP_CHECK(hipGetDevice(device));
+    return true;
+  }
+
+  bool peekAtLastError() {
+    (void)hipPeekAtLastError();
+    return true;
+  }
+
+  bool streamCreate(Stream* stream) {
+    HIP_CHECK(hipStreamCreate(reinterpret_cast<hipStream_t*>(stream)));
+    return true;
+  }
+
+  bool streamDestroy(Stream stream) {
+    HIP_CHECK(hipStreamDestroy(static_cast<hipStream_t>(stream)));
+    return true;
+  }
+
+  bool streamSynchronize(Stream stream) {
+    HIP_CHECK(hipStreamSynchronize(static_cast<hipStream_t>(stream)));
+    return true;
+  }
+
+  bool streamQuery(Stream stream) {
+    hipError_t status = hipStreamQuery(static_cast<hipStream_t>(stream));
+    if ((status != hipSuccess) && (status != hipErrorNotReady)) {
+      return fail(std::string("hipStreamQuery failed: ") + hipGetErrorString(status));
+    }
+    return true;
+  }
+
+  bool streamWaitEvent(Stream stream, Event event) {
+    HIP_CHECK(hipStreamWaitEvent(static_cast<hipStream_t>(stream), static_cast<hipEvent_t>(event),
+                                 0));
+    return true;
+  }
+
+  bool eventCreate(Event* event) {
+    HIP_CHECK(hipEventCreateWithFlags(reinterpret_cast<hipEvent_t*>(event),
+                                      hipEventDisableTiming));
+    return true;
+  }
+
+  bool eventDestroy(Event event) {
+    HIP_CHECK(hipEventDestroy(static_cast<hipEvent_t>(event)));
+    return true;
+  }
+
+  bool eventRecord(Event event, Stream stream) {
+    HIP_CHECK(hipEventRecord(static_cast<hipEvent_t>(event), static_cast<hipStream_t>(stream)));
+    return true;
+  }
+
+  bool mallocAsync(void** ptr, size_t size, Stream stream) {
+    HIP_CHECK(hipMallocAsync(ptr, size, static_cast<hipStream_t>(stream)));
+    return true;
+  }
+
+  bool freeAsync(void* ptr, Stream stream) {
+    HIP_CHECK(hipFreeAsync(ptr, static_cast<hipStream_t>(stream)));
+    return true;
+  }
+
+  bool getKernel(unsigned int numArgs, Function* function) {
+    if (numArgs > MaxKernelArgs) {
+      return fail("Too many kernel arguments");
+    }
+    if (functions_[numArgs] == nullptr) {
+      std::string name = "hipperf_args_" + std::to_string(numArgs);
+      HIP_CHECK(hipModuleGetFunction(&functions_[numArgs], module_, name.c_str()));
+    }
+    *function = functions_[numArgs];
+    return true;
+  }
+
+  bool launchKernel(Function function, void** args, Stream stream) {
+    HIP_CHECK(hipModuleLaunchKernel(static_cast<hipFunction_t>(function), 1, 1, 1, 1, 1, 1, 0,
+                                    static_cast<hipStream_t>(stream), args, nullptr));
+    return true;
+  }
+
+  bool launchKernelBatch(Function function, void*** args, unsigned int count, Stream stream) {
+    launchParams_.resize(count);
+    for (unsigned int i = 0; i < count; ++i) {
+      hipFunctionLaunchParams& params = launchParams_[i];
+      params.function = static_cast<hipFunction_t>(function);
+      params.gridDimX = params.gridDimY = params.gridDimZ = 1;
+      params.blockDimX = params.blockDimY = params.blockDimZ = 1;
+      params.sharedMemBytes = 0;
+      params.hStream = static_cast<hipStream_t>(stream);
+      params.kernelParams = args[i];
+    }
+    HIP_CHECK(hipExtLaunchKernelBatch(launchParams_.data(), count,
+                                      static_cast<hipStream_t>(stream), 0));
+    return true;
+  }
+
+  bool beginCapture(Stream stream) {
+    HIP_CHECK(hipStreamBeginCapture(static_cast<hipStream_t>(stream),
+                                    hipStreamCaptureModeGlobal));
+    return true;
+  }
+
+  bool endCapture(Stream stream, Graph* graph) {
+    HIP_CHECK(hipStreamEndCapture(static_cast<hipStream_t>(stream),
+                                  reinterpret_cast<hipGraph_t*>(graph)));
+    return true;
+  }
+
+  bool graphInstantiate(Graph graph, GraphExec* exec) {
+    HIP_CHECK(hipGraphInstantiate(reinterpret_cast<hipGraphExec_t*>(exec),
+                                  static_cast<hipGraph_t>(graph), nullptr, nullptr, 0));
+    return true;
+  }
+
+  bool graphLaunch(GraphExec exec, Stream stream) {
+    HIP_CHECK(hipGraphLaunch(static_cast<hipGraphExec_t>(exec), static_cast<hipStream_t>(stream)));
+    return true;
+  }
+
+  bool graphDestroy(Graph graph) {
+    HIP_CHECK(hipGraphDestroy(static_cast<hipGraph_t>(graph)));
+    return true;
+  }
+
+  bool graphExecDestroy(GraphExec exec) {
+    HIP_CHECK(hipGraphExecDestroy(static_cast<hipGraphExec_t>(exec)));
+    return true;
+  }
+
+  bool getCodeObject(const void** image, size_t* size) {
+    *image = code_.data();
+    *size = code_.size();
+    return true;
+  }
+
+  bool moduleLoad(const void* image, Module* module) {
+    HIP_CHECK(hipModuleLoadData(reinterpret_cast<hipModule_t*>(module), image));
+    return true;
+  }
+
+  bool moduleUnload(Module module) {
+    HIP_CHECK(hipModuleUnload(static_cast<hipModule_t>(module)));
+    return true;
+  }
+
+ private:
+  //! Compiles an empty kernel for every argument count
+  bool compileKernels(const char* arch) {
+    std::stringstream source;
+    for (unsigned int n = 0; n <= MaxKernelArgs; ++n) {
+      source << "extern \"C\" __global__ void hipperf_args_" << n << "(";
+      for (unsigned int i = 0; i < n; ++i) {
+        source << ((i != 0) ? ", " : "") << "void* a" << i;
+      }
+      source << ") {}\n";
+    }
+    std::string text = source.str();
+    std::string archOption = std::string("--gpu-architecture=") + arch;
+    const char* options[] = {archOption.c_str()};
+
+    hiprtcProgram program;
+    HIPRTC_CHECK(hiprtcCreateProgram(&program, text.c_str(), "hipperf.hip", 0, nullptr, nullptr));
+    hiprtcResult result = hiprtcCompileProgram(program, 1, options);
+    if (result != HIPRTC_SUCCESS) {
+      size_t logSize = 0;
+      hiprtcGetProgramLogSize(program, &logSize);
+      std::string log(logSize, '\0');
+      hiprtcGetProgramLog(program, &log[0]);
+      hiprtcDestroyProgram(&program);
+      return fail("Kernel compilation failed: " + log);
+    }
+    size_t codeSize = 0;
+    HIPRTC_CHECK(hiprtcGetCodeSize(program, &codeSize));
+    code_.resize(codeSize);
+    HIPRTC_CHECK(hiprtcGetCode(program, code_.data()));
+    HIPRTC_CHECK(hiprtcDestroyProgram(&program));
+    return true;
+  }
+
+  std::vector<char> code_;                               //!< Code object of the kernels
+  hipModule_t module_;                                   //!< The loaded code object
+  std::vector<hipFunction_t> functions_;                 //!< Kernels by argument count
+  std::vector<hipFunctionLaunchParams> launchParams_;    //!< Batch launch staging
+};
+
+HipPerfBackend* HipPerfCreateHipBackend() { return new HipBackend(); }
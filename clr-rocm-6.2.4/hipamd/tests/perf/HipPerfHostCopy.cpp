@@ -0,0 +1,151 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfHostCopy.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "os/os.hpp"
+
+//! The number of bytes every subtest moves
+static const size_t TotalBytes = 1024 * 1024 * 1024;
+
+static const size_t BufSize = 64 * 1024 * 1024;
+
+//! The pitched copies move rows of 1000 bytes with a pitch of 1KB
+static const size_t RowSize = 1000;
+static const size_t RowPitch = 1024;
+
+enum Op { Copy, Fill, Copy3D };
+
+struct Config {
+  Op op;
+  bool runtime;  //!< The runtime's Os helper instead of the plain loop
+  size_t size;   //!< Copy size or pattern size
+};
+
+static const Config Configs[] = {
+    {Copy, false, 64 * 1024},      {Copy, true, 64 * 1024},
+    {Copy, false, 4 * 1024 * 1024}, {Copy, true, 4 * 1024 * 1024},
+    {Copy, false, BufSize},         {Copy, true, BufSize},
+    {Fill, false, 4},               {Fill, true, 4},
+    {Fill, false, 16},              {Fill, true, 16},
+    {Copy3D, false, RowSize},       {Copy3D, true, RowSize},
+};
+static const unsigned int NumConfigs = sizeof(Configs) / sizeof(Configs[0]);
+
+HipPerfHostCopy::HipPerfHostCopy() : src_(nullptr), dst_(nullptr) {
+  _numSubTests = NumConfigs;
+  _higherIsBetter = true;
+}
+
+HipPerfHostCopy::~HipPerfHostCopy() {}
+
+void HipPerfHostCopy::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  src_ = new char[BufSize];
+  dst_ = new char[BufSize];
+  // Touch all pages, so page faults aren't measured
+  memset(src_, 0x5a, BufSize);
+  memset(dst_, 0, BufSize);
+}
+
+void HipPerfHostCopy::run(void) {
+  const Config& config = Configs[_openTest];
+  const char* name = config.runtime ? "runtime" : "loop";
+  std::stringstream stream;
+  size_t bytes = 0;
+  HipPerfTimer timer;
+
+  switch (config.op) {
+    case Copy: {
+      const size_t iterations = TotalBytes / config.size;
+      timer.Start();
+      for (size_t i = 0; i < iterations; ++i) {
+        if (config.runtime) {
+          amd::Os::fastMemcpy(dst_, src_, config.size);
+        } else {
+          memcpy(dst_, src_, config.size);
+        }
+      }
+      timer.Stop();
+      bytes = iterations * config.size;
+      stream << (config.runtime ? "Os::fastMemcpy" : "memcpy") << " bandwidth, " << config.size
+             << " bytes (GB/s)";
+      break;
+    }
+    case Fill: {
+      const size_t iterations = TotalBytes / BufSize;
+      const size_t count = BufSize / config.size;
+      char pattern[16];
+      for (size_t i = 0; i < sizeof(pattern); ++i) {
+        pattern[i] = static_cast<char>(i + 1);
+      }
+      timer.Start();
+      for (size_t i = 0; i < iterations; ++i) {
+        if (config.runtime) {
+          amd::Os::fastMemFill(dst_, pattern, config.size, count);
+        } else {
+          // The per element loop the host blit manager used before
+          for (size_t e = 0; e < count; ++e) {
+            memcpy(dst_ + e * config.size, pattern, config.size);
+          }
+        }
+      }
+      timer.Stop();
+      bytes = iterations * count * config.size;
+      stream << "Fill bandwidth, " << config.size << " byte pattern, " << name << " (GB/s)";
+      break;
+    }
+    case Copy3D: {
+      const size_t rows = BufSize / RowPitch;
+      const size_t slices = 16;
+      const size_t iterations = TotalBytes / BufSize;
+      timer.Start();
+      for (size_t i = 0; i < iterations; ++i) {
+        if (config.runtime) {
+          amd::Os::fastMemcpy3D(dst_, RowPitch, RowPitch * rows / slices, src_, RowPitch,
+                                RowPitch * rows / slices, RowSize, rows / slices, slices);
+        } else {
+          for (size_t r = 0; r < rows; ++r) {
+            memcpy(dst_ + r * RowPitch, src_ + r * RowPitch, RowSize);
+          }
+        }
+      }
+      timer.Stop();
+      bytes = iterations * rows * RowSize;
+      stream << "Pitched copy bandwidth, " << RowSize << " byte rows, " << name << " (GB/s)";
+      break;
+    }
+  }
+
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(bytes / timer.GetElapsedTime() / 1e9);
+}
+
+unsigned int HipPerfHostCopy::close(void) {
+  delete[] src_;
+  delete[] dst_;
+  src_ = nullptr;
+  dst_ = nullptr;
+  return HipPerfTest::close();
+}
@@ -0,0 +1,89 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfImageLookup.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "os/os.hpp"
+
+static const unsigned int Iterations = 100000;
+static const unsigned int FallbackIterations = 1000;
+
+//! Data in the executable, like the fat binary of an application
+static const char ImageData[4096] = "hipperf image";
+
+static const char* TestNames[] = {
+    "Image to file lookup time, executable (us)",
+    "Image to file lookup time, shared library (us)",
+    "Image to file lookup time, anonymous memory (us)",
+};
+static const unsigned int NumTests = sizeof(TestNames) / sizeof(TestNames[0]);
+
+HipPerfImageLookup::HipPerfImageLookup() : heap_(nullptr) { _numSubTests = NumTests; }
+
+HipPerfImageLookup::~HipPerfImageLookup() {}
+
+void HipPerfImageLookup::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  heap_ = malloc(4096);
+}
+
+void HipPerfImageLookup::run(void) {
+  const void* image = nullptr;
+  unsigned int iterations = Iterations;
+  switch (_openTest) {
+    case 0:
+      image = ImageData;
+      break;
+    case 1:
+      image = reinterpret_cast<const void*>(&strlen);
+      break;
+    case 2:
+      // No loaded object covers the heap, the lookup falls back to /proc/self/maps
+      image = heap_;
+      iterations = FallbackIterations;
+      break;
+  }
+
+  std::string name;
+  size_t offset = 0;
+  bool found = amd::Os::FindFileNameFromAddress(image, &name, &offset);
+  CHECK_RESULT((_openTest != 2) && !found, "No file found for %p", image);
+
+  HipPerfTimer timer;
+  timer.Start();
+  for (unsigned int i = 0; i < iterations; ++i) {
+    amd::Os::FindFileNameFromAddress(image, &name, &offset);
+  }
+  timer.Stop();
+
+  testDescString = TestNames[_openTest];
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / iterations);
+}
+
+unsigned int HipPerfImageLookup::close(void) {
+  free(heap_);
+  heap_ = nullptr;
+  return HipPerfTest::close();
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfLaunchBatch.h"
+
+#include <sstream>
+#include <vector>
+
+static const unsigned int TotalLaunches = 8192;
+
+static const unsigned int BatchSizes[] = {1, 8, 64};
+static const unsigned int NumBatchSizes = sizeof(BatchSizes) / sizeof(BatchSizes[0]);
+
+static const unsigned int NumArgs = 4;
+
+HipPerfLaunchBatch::HipPerfLaunchBatch() : stream_(nullptr), function_(nullptr) {
+  // Every batch size runs as single launches and as one batched launch
+  _numSubTests = NumBatchSizes * 2;
+}
+
+HipPerfLaunchBatch::~HipPerfLaunchBatch() {}
+
+void HipPerfLaunchBatch::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->streamCreate(&stream_));
+  CHECK_BACKEND(backend_->getKernel(NumArgs, &function_));
+}
+
+void HipPerfLaunchBatch::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  const unsigned int batchSize = BatchSizes[_openTest % NumBatchSizes];
+  const bool batched = (_openTest >= NumBatchSizes);
+
+  // Every launch of a batch has its own arguments
+  std::vector<void*> values(batchSize * NumArgs);
+  std::vector<void*> args(batchSize * NumArgs);
+  std::vector<void**> launchArgs(batchSize);
+  for (unsigned int k = 0; k < batchSize; ++k) {
+    for (unsigned int i = 0; i < NumArgs; ++i) {
+      values[k * NumArgs + i] = reinterpret_cast<void*>(static_cast<uintptr_t>(k * NumArgs + i));
+      args[k * NumArgs + i] = &values[k * NumArgs + i];
+    }
+    launchArgs[k] = &args[k * NumArgs];
+  }
+
+  CHECK_BACKEND(backend_->launchKernelBatch(function_, launchArgs.data(), batchSize, stream_));
+  CHECK_BACKEND(backend_->streamSynchronize(stream_));
+
+  HipPerfTimer timer;
+  timer.Start();
+  for (unsigned int n = 0; n < TotalLaunches; n += batchSize) {
+    if (batched) {
+      CHECK_BACKEND(backend_->launchKernelBatch(function_, launchArgs.data(), batchSize, stream_));
+    } else {
+      for (unsigned int k = 0; k < batchSize; ++k) {
+        CHECK_BACKEND(backend_->launchKernel(function_, launchArgs[k], stream_));
+      }
+    }
+  }
+  CHECK_BACKEND(backend_->streamSynchronize(stream_));
+  timer.Stop();
+
+  std::stringstream stream;
+  stream << "Launch time per kernel, groups of " << batchSize << " kernels "
+         << (batched ? "launched as one batch" : "launched one by one") << " (us)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / TotalLaunches);
+}
+
+unsigned int HipPerfLaunchBatch::close(void) {
+  if (stream_ != nullptr) {
+    backend_->streamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  return HipPerfTest::close();
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfMallocAsync.h"
+
+#include <sstream>
+#include <vector>
+
+static const unsigned int Iterations = 20000;
+
+static const size_t Sizes[] = {256, 64 * 1024, 4 * 1024 * 1024};
+static const unsigned int NumSizes = sizeof(Sizes) / sizeof(Sizes[0]);
+
+//! The number of allocations, which stay live in the outstanding subtests
+static const unsigned int Outstanding = 64;
+
+HipPerfMallocAsync::HipPerfMallocAsync() : stream_(nullptr) {
+  // Every size runs with each allocation freed right away and with many outstanding ones
+  _numSubTests = NumSizes * 2;
+}
+
+HipPerfMallocAsync::~HipPerfMallocAsync() {}
+
+void HipPerfMallocAsync::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->streamCreate(&stream_));
+}
+
+void HipPerfMallocAsync::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  const size_t size = Sizes[_openTest % NumSizes];
+  const unsigned int live = (_openTest >= NumSizes) ? Outstanding : 1;
+  std::vector<void*> ptrs(live, nullptr);
+
+  // Fill the pool once, so the timed loop measures reuse
+  for (auto& ptr : ptrs) {
+    CHECK_BACKEND(backend_->mallocAsync(&ptr, size, stream_));
+  }
+  for (auto ptr : ptrs) {
+    CHECK_BACKEND(backend_->freeAsync(ptr, stream_));
+  }
+  CHECK_BACKEND(backend_->streamSynchronize(stream_));
+
+  const unsigned int rounds = Iterations / live;
+  HipPerfTimer timer;
+  timer.Start();
+  for (unsigned int i = 0; i < rounds; ++i) {
+    for (auto& ptr : ptrs) {
+      CHECK_BACKEND(backend_->mallocAsync(&ptr, size, stream_));
+    }
+    for (auto ptr : ptrs) {
+      CHECK_BACKEND(backend_->freeAsync(ptr, stream_));
+    }
+  }
+  CHECK_BACKEND(backend_->streamSynchronize(stream_));
+  timer.Stop();
+
+  std::stringstream stream;
+  stream << "Async malloc+free time, " << size << " bytes, " << live << " live (us)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / (rounds * live));
+}
+
+unsigned int HipPerfMallocAsync::close(void) {
+  if (stream_ != nullptr) {
+    backend_->streamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  return HipPerfTest::close();
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfModuleLoad.h"
+
+#include <sstream>
+#include <vector>
+
+static const unsigned int Iterations = 256;
+
+//! The number of modules, which stay loaded in the second subtest
+static const unsigned int LiveModules = 64;
+
+HipPerfModuleLoad::HipPerfModuleLoad() : image_(nullptr), imageSize_(0) {
+  // Modules are loaded one at a time and with many modules loaded
+  _numSubTests = 2;
+}
+
+HipPerfModuleLoad::~HipPerfModuleLoad() {}
+
+void HipPerfModuleLoad::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->getCodeObject(&image_, &imageSize_));
+}
+
+void HipPerfModuleLoad::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  const unsigned int live = (_openTest == 0) ? 1 : LiveModules;
+  std::vector<HipPerfBackend::Module> modules(live, nullptr);
+
+  // The first load may set up the code object handling of the device
+  CHECK_BACKEND(backend_->moduleLoad(image_, &modules[0]));
+  CHECK_BACKEND(backend_->moduleUnload(modules[0]));
+
+  HipPerfTimer timer;
+  timer.Start();
+  for (unsigned int i = 0; i < Iterations; i += live) {
+    for (auto& module : modules) {
+      CHECK_BACKEND(backend_->moduleLoad(image_, &module));
+    }
+    for (auto module : modules) {
+      CHECK_BACKEND(backend_->moduleUnload(module));
+    }
+  }
+  timer.Stop();
+
+  std::stringstream stream;
+  stream << "Module load+unload time, " << imageSize_ << " byte code object, " << live
+         << " loaded (us)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / Iterations);
+}
+
+unsigned int HipPerfModuleLoad::close(void) { return HipPerfTest::close(); }
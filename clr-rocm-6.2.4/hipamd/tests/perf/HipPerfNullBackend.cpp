@@ -0,0 +1,725 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "HipPerfBackend.h"
+#include "device/rocm/rocbarrier.hpp"
+#include "device/rocm/rocdoorbell.hpp"
+#include "device/rocm/rockernargcache.hpp"
+#include "os/os.hpp"
+#include "utils/flags.hpp"
+
+namespace {
+
+//! A signal of the mock device, the handle is the address of the signal value
+struct NullSignal {
+  uint64_t handle;
+};
+
+inline std::atomic<int64_t>* SignalValue(NullSignal signal) {
+  return reinterpret_cast<std::atomic<int64_t>*>(signal.handle);
+}
+
+typedef amd::roc::BarrierCoalescer<NullSignal> NullBarrierCoalescer;
+
+enum PacketType : uint16_t { PacketDispatch = 1, PacketBarrier = 2, PacketNop = 3 };
+
+//! An AQL packet of the mock device
+struct NullPacket {
+  uint16_t header_;
+  uint64_t kernel_;
+  const void* kernarg_;
+  NullSignal deps_[NullBarrierCoalescer::kMaxDeps];
+  NullSignal completion_;
+};
+
+enum ObjectType { TypeStream, TypeEvent, TypeGraph, TypeGraphExec, TypeModule };
+
+//! Every handle the mock backend returns is validated on entry, like the runtime's handles
+struct NullObject {
+  explicit NullObject(ObjectType type) : type_(type) {}
+  virtual ~NullObject() {}
+  const ObjectType type_;
+};
+
+struct NullKernel {
+  uint64_t code_;          //!< Code handle
+  unsigned int numArgs_;   //!< Pointer arguments
+};
+
+struct NullNode {
+  const NullKernel* kernel_;
+  std::vector<uint8_t> args_;
+};
+
+struct NullGraph : public NullObject {
+  NullGraph() : NullObject(TypeGraph) {}
+  std::vector<NullNode> nodes_;
+};
+
+//! An instantiated graph keeps the arguments of all nodes in one arena
+struct NullGraphExec : public NullObject {
+  NullGraphExec() : NullObject(TypeGraphExec) {}
+  std::vector<const NullKernel*> kernels_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> sizes_;
+  std::vector<uint8_t> arena_;
+};
+
+struct NullEvent : public NullObject {
+  NullEvent() : NullObject(TypeEvent), value_(0) {}
+  NullSignal signal() { return NullSignal{reinterpret_cast<uint64_t>(&value_)}; }
+  std::atomic<int64_t> value_;  //!< Records, which haven't completed yet
+};
+
+struct NullModule : public NullObject {
+  NullModule() : NullObject(TypeModule) {}
+  std::vector<char> image_;
+  std::string file_;
+  std::unordered_map<std::string, const NullKernel*> symbols_;
+};
+
+//! Counters of the queue logic
+struct NullCounters {
+  uint64_t packets_ = 0;
+  uint64_t doorbells_ = 0;
+  uint64_t argHits_ = 0;
+  uint64_t argMisses_ = 0;
+  uint64_t argInvalidations_ = 0;
+  uint64_t barriersRequested_ = 0;
+  uint64_t barriersEmitted_ = 0;
+
+  void add(const NullCounters& other, int64_t sign) {
+    packets_ += sign * other.packets_;
+    doorbells_ += sign * other.doorbells_;
+    argHits_ += sign * other.argHits_;
+    argMisses_ += sign * other.argMisses_;
+    argInvalidations_ += sign * other.argInvalidations_;
+    barriersRequested_ += sign * other.barriersRequested_;
+    barriersEmitted_ += sign * other.barriersEmitted_;
+  }
+};
+
+/*! \brief The queue of a stream on the mock device
+ *
+ *  Commands go through the queue helpers of the ROCm backend: kernel arguments are written into
+ *  a chunked kernarg pool behind the KernArgCache, barriers are merged by the BarrierCoalescer
+ *  and doorbells are batched by DoorbellBatch::Submit() with the limits of
+ *  VirtualGPU::ringDoorbell(). ROC_KERNARG_CACHE, ROC_DOORBELL_BATCH and ROC_DOORBELL_BATCH_US
+ *  apply like in the runtime. The mock device runs all packets up to a doorbell as soon as it's
+ *  written.
+ *
+ *  Nothing else of the runtime runs here. The streams, events, graphs, modules and the memory
+ *  pool of the backend are stand-ins, so "-b null" doesn't time the HIP host path: API argument
+ *  validation, hip::Stream and amd::Command creation, graph instantiation and the rest of
+ *  VirtualGPU stay unmeasured. Use "-b hip" for those.
+ */
+class NullQueue : public NullObject {
+ public:
+  static constexpr size_t QueueSize = 4096;
+  static constexpr size_t KernargChunkSize = 256 * 1024;
+  static constexpr size_t KernargChunks = 4;
+
+  NullQueue()
+      : NullObject(TypeStream),
+        capture_(nullptr),
+        ring_(QueueSize),
+        writeIndex_(0),
+        readIndex_(0),
+        kernargPool_(new uint8_t[KernargChunkSize * KernargChunks]),
+        kernargChunk_(0),
+        kernargOffset_(0),
+        kernargCache_(ROC_KERNARG_CACHE),
+        barriers_(PacketNop),
+        batchDoorbell_(ROC_DOORBELL_BATCH > 1) {}
+
+  ~NullQueue() {
+    flush();
+    delete capture_;
+  }
+
+  std::mutex& lock() { return lock_; }
+
+  //! The graph the stream captures into, or nullptr
+  NullGraph*& capture() { return capture_; }
+
+  void dispatch(const NullKernel* kernel, const void* args, size_t size) {
+    flushBarriers();
+    const void* kernarg = writeKernArgs(kernel->code_, args, size);
+    NullPacket& packet = nextPacket();
+    packet.header_ = PacketDispatch;
+    packet.kernel_ = kernel->code_;
+    packet.kernarg_ = kernarg;
+    packet.completion_.handle = 0;
+    submit();
+  }
+
+  //! Makes the following commands wait for \a signal
+  void wait(NullSignal signal) { barriers_.Wait(*this, &signal, 1); }
+
+  //! Decrements \a signal once the commands so far are done
+  void marker(NullSignal signal) {
+    barriers_.Barrier(*this, PacketBarrier, nullptr, 0, [signal]() { return signal; });
+  }
+
+  //! Writes the staged barriers and rings the doorbell for all packets
+  void flush() {
+    flushBarriers();
+    doorbell_.Flush(*this, UINT64_MAX);
+  }
+
+  bool idle() const { return readIndex_ == writeIndex_; }
+
+  NullCounters counters() const {
+    NullCounters counters;
+    counters.packets_ = doorbell_.Packets();
+    counters.doorbells_ = doorbell_.Doorbells();
+    counters.argHits_ = kernargCache_.Hits();
+    counters.argMisses_ = kernargCache_.Misses();
+    counters.argInvalidations_ = kernargCache_.Invalidations();
+    counters.barriersRequested_ = barriers_.Requested();
+    counters.barriersEmitted_ = barriers_.Emitted();
+    return counters;
+  }
+
+  //! The queue interface of the barrier coalescer
+  bool IsSatisfied(NullSignal signal) {
+    return SignalValue(signal)->load(std::memory_order_acquire) == 0;
+  }
+
+  void Emit(uint16_t header, const NullSignal* deps, NullSignal completion) {
+    NullPacket& packet = nextPacket();
+    packet.header_ = header;
+    memcpy(packet.deps_, deps, sizeof(packet.deps_));
+    packet.completion_ = completion;
+    submit();
+  }
+
+  //! The queue interface of the doorbell batch
+  void WriteDoorbell(uint64_t index) { process(index); }
+  void BatchOpened() {}
+  void BatchClosed() {}
+
+ private:
+  void flushBarriers() {
+    if (!barriers_.Empty()) {
+      barriers_.Flush(*this);
+    }
+  }
+
+  NullPacket& nextPacket() {
+    if (writeIndex_ - readIndex_ == QueueSize) {
+      doorbell_.Flush(*this, UINT64_MAX);
+    }
+    return ring_[writeIndex_ % QueueSize];
+  }
+
+  void submit() {
+    uint64_t index = writeIndex_++;
+    uint32_t maxPackets = std::min<uint32_t>(QueueSize >> 1, ROC_DOORBELL_BATCH);
+    doorbell_.Submit(*this, index, batchDoorbell_, amd::Os::timeNanos(), maxPackets,
+                     static_cast<uint64_t>(ROC_DOORBELL_BATCH_US) * 1000);
+  }
+
+  //! The mock device: runs the packets up to \a index and completes their signals
+  void process(uint64_t index) {
+    for (; readIndex_ <= index; ++readIndex_) {
+      const NullPacket& packet = ring_[readIndex_ % QueueSize];
+      if (packet.completion_.handle != 0) {
+        SignalValue(packet.completion_)->fetch_sub(1, std::memory_order_release);
+      }
+    }
+  }
+
+  const void* writeKernArgs(uint64_t kernel, const void* args, size_t size) {
+    if (size == 0) {
+      return nullptr;
+    }
+    uint64_t hash = 0;
+    if (kernargCache_.Enabled()) {
+      void* block = kernargCache_.Find(kernel, args, size, &hash);
+      if (block != nullptr) {
+        return block;
+      }
+    }
+    size_t alignedSize = (size + 63) & ~size_t(63);
+    if (kernargOffset_ + alignedSize > KernargChunkSize) {
+      // The next chunk may still hold blocks of earlier launches, which get overwritten
+      kernargChunk_ = (kernargChunk_ + 1) % KernargChunks;
+      kernargOffset_ = 0;
+      kernargCache_.Invalidate();
+    }
+    void* block = &kernargPool_[kernargChunk_ * KernargChunkSize + kernargOffset_];
+    kernargOffset_ += alignedSize;
+    memcpy(block, args, size);
+    if (kernargCache_.Enabled()) {
+      kernargCache_.Insert(kernel, args, size, hash, block);
+    }
+    return block;
+  }
+
+  std::mutex lock_;                         //!< Serializes the commands of the stream
+  NullGraph* capture_;                      //!< The graph the stream captures into
+  std::vector<NullPacket> ring_;            //!< AQL ring
+  uint64_t writeIndex_;                     //!< The next packet to write
+  uint64_t readIndex_;                      //!< The next packet the device runs
+  std::unique_ptr<uint8_t[]> kernargPool_;  //!< Kernel argument chunks
+  size_t kernargChunk_;                     //!< The chunk in use
+  size_t kernargOffset_;                    //!< The next free byte in the chunk
+  amd::roc::KernArgCache kernargCache_;
+  amd::roc::DoorbellBatch doorbell_;
+  NullBarrierCoalescer barriers_;
+  const bool batchDoorbell_;                //!< Doorbells may be deferred
+};
+
+//! The header of a mock code object, followed by the kernel names
+struct NullCodeObjectHeader {
+  uint32_t magic_;
+  uint32_t numKernels_;
+  uint64_t size_;
+};
+
+static constexpr uint32_t NullCodeObjectMagic = 0x4e55484c;
+
+//! The code object lives in the executable, like the fat binary of an application
+static char NullCodeObject[64 * 1024];
+
+class NullBackend : public HipPerfBackend {
+ public:
+  NullBackend() : kernels_(MaxKernelArgs + 1) {}
+
+  ~NullBackend() {
+    objects_.erase(&defaultQueue_);
+    for (auto object : objects_) {
+      delete object;
+    }
+    for (auto& block : freeBlocks_) {
+      amd::Os::alignedFree(block.second);
+    }
+    for (auto& block : liveBlocks_) {
+      amd::Os::alignedFree(block.first);
+    }
+  }
+
+  const char* name() const { return "null"; }
+
+  bool init(unsigned int deviceId) {
+    if (deviceId != 0) {
+      return fail("The null backend has a single device");
+    }
+    for (unsigned int n = 0; n <= MaxKernelArgs; ++n) {
+      kernels_[n].code_ = 0x1000 * (n + 1);
+      kernels_[n].numArgs_ = n;
+    }
+    buildCodeObject();
+    objects_.insert(&defaultQueue_);
+    return true;
+  }
+
+  bool getDevice(int* device) {
+    *device = device_;
+    return true;
+  }
+
+  bool peekAtLastError() { return lastError_ == 0; }
+
+  bool streamCreate(Stream* stream) {
+    NullQueue* queue = new NullQueue();
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.insert(queue);
+    *stream = queue;
+    return true;
+  }
+
+  bool streamDestroy(Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    if ((queue == nullptr) || (queue == &defaultQueue_)) {
+      return fail("Invalid stream");
+    }
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.erase(queue);
+    queue->flush();
+    retired_.add(queue->counters(), 1);
+    delete queue;
+    return true;
+  }
+
+  bool streamSynchronize(Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    if (queue == nullptr) {
+      return fail("Invalid stream");
+    }
+    std::lock_guard<std::mutex> guard(queue->lock());
+    queue->flush();
+    return queue->idle() || fail("The stream didn't drain");
+  }
+
+  bool streamQuery(Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    if (queue == nullptr) {
+      return fail("Invalid stream");
+    }
+    std::lock_guard<std::mutex> guard(queue->lock());
+    // Like the runtime, a query closes open doorbell batches
+    queue->flush();
+    return true;
+  }
+
+  bool streamWaitEvent(Stream stream, Event event) {
+    NullQueue* queue = findQueue(stream);
+    NullEvent* nullEvent = find<NullEvent>(event, TypeEvent);
+    if ((queue == nullptr) || (nullEvent == nullptr)) {
+      return fail("Invalid stream or event");
+    }
+    std::lock_guard<std::mutex> guard(queue->lock());
+    queue->wait(nullEvent->signal());
+    return true;
+  }
+
+  bool eventCreate(Event* event) {
+    NullEvent* nullEvent = new NullEvent();
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.insert(nullEvent);
+    *event = nullEvent;
+    return true;
+  }
+
+  bool eventDestroy(Event event) {
+    NullEvent* nullEvent = find<NullEvent>(event, TypeEvent);
+    if (nullEvent == nullptr) {
+      return fail("Invalid event");
+    }
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.erase(nullEvent);
+    delete nullEvent;
+    return true;
+  }
+
+  bool eventRecord(Event event, Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    NullEvent* nullEvent = find<NullEvent>(event, TypeEvent);
+    if ((queue == nullptr) || (nullEvent == nullptr)) {
+      return fail("Invalid stream or event");
+    }
+    std::lock_guard<std::mutex> guard(queue->lock());
+    nullEvent->value_.fetch_add(1, std::memory_order_relaxed);
+    queue->marker(nullEvent->signal());
+    return true;
+  }
+
+  bool mallocAsync(void** ptr, size_t size, Stream stream) {
+    if (findQueue(stream) == nullptr) {
+      return fail("Invalid stream");
+    }
+    // Blocks are reused if they are at most twice the requested size, like a pool would
+    size = (size + 255) & ~size_t(255);
+    std::lock_guard<std::mutex> guard(poolLock_);
+    auto it = freeBlocks_.lower_bound(size);
+    if ((it != freeBlocks_.end()) && (it->first <= 2 * size)) {
+      *ptr = it->second;
+      liveBlocks_[it->second] = it->first;
+      freeBlocks_.erase(it);
+      return true;
+    }
+    *ptr = amd::Os::alignedMalloc(size, 256);
+    if (*ptr == nullptr) {
+      return fail("Out of memory");
+    }
+    liveBlocks_[*ptr] = size;
+    return true;
+  }
+
+  bool freeAsync(void* ptr, Stream stream) {
+    if (findQueue(stream) == nullptr) {
+      return fail("Invalid stream");
+    }
+    std::lock_guard<std::mutex> guard(poolLock_);
+    auto it = liveBlocks_.find(ptr);
+    if (it == liveBlocks_.end()) {
+      return fail("Invalid pointer");
+    }
+    freeBlocks_.emplace(it->second, ptr);
+    liveBlocks_.erase(it);
+    return true;
+  }
+
+  bool getKernel(unsigned int numArgs, Function* function) {
+    if (numArgs > MaxKernelArgs) {
+      return fail("Too many kernel arguments");
+    }
+    *function = &kernels_[numArgs];
+    return true;
+  }
+
+  bool launchKernel(Function function, void** args, Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    if ((queue == nullptr) || !validKernel(function)) {
+      return fail("Invalid stream or kernel");
+    }
+    const NullKernel* kernel = static_cast<const NullKernel*>(function);
+    uint64_t kernarg[MaxKernelArgs];
+    size_t size = gatherArgs(kernel, args, kernarg);
+    std::lock_guard<std::mutex> guard(queue->lock());
+    if (queue->capture() != nullptr) {
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(kernarg);
+      queue->capture()->nodes_.push_back({kernel, std::vector<uint8_t>(bytes, bytes + size)});
+      return true;
+    }
+    queue->dispatch(kernel, kernarg, size);
+    return true;
+  }
+
+  bool launchKernelBatch(Function function, void*** args, unsigned int count, Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    if ((queue == nullptr) || !validKernel(function)) {
+      return fail("Invalid stream or kernel");
+    }
+    const NullKernel* kernel = static_cast<const NullKernel*>(function);
+    uint64_t kernarg[MaxKernelArgs];
+    std::lock_guard<std::mutex> guard(queue->lock());
+    if (queue->capture() != nullptr) {
+      return fail("Batched launches can't be captured");
+    }
+    for (unsigned int i = 0; i < count; ++i) {
+      size_t size = gatherArgs(kernel, args[i], kernarg);
+      queue->dispatch(kernel, kernarg, size);
+    }
+    // The batch takes a single doorbell
+    queue->flush();
+    return true;
+  }
+
+  bool beginCapture(Stream stream) {
+    NullQueue* queue = findQueue(stream);
+    if (queue == nullptr) {
+      return fail("Invalid stream");
+    }
+    std::lock_guard<std::mutex> guard(queue->lock());
+    if (queue->capture() != nullptr) {
+      return fail("The stream is capturing already");
+    }
+    queue->capture() = new NullGraph();
+    return true;
+  }
+
+  bool endCapture(Stream stream, Graph* graph) {
+    NullQueue* queue = findQueue(stream);
+    if (queue == nullptr) {
+      return fail("Invalid stream");
+    }
+    NullGraph* captured = nullptr;
+    {
+      std::lock_guard<std::mutex> guard(queue->lock());
+      captured = queue->capture();
+      queue->capture() = nullptr;
+    }
+    if (captured == nullptr) {
+      return fail("The stream isn't capturing");
+    }
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.insert(captured);
+    *graph = captured;
+    return true;
+  }
+
+  bool graphInstantiate(Graph graph, GraphExec* exec) {
+    NullGraph* nullGraph = find<NullGraph>(graph, TypeGraph);
+    if (nullGraph == nullptr) {
+      return fail("Invalid graph");
+    }
+    NullGraphExec* nullExec = new NullGraphExec();
+    size_t arenaSize = 0;
+    for (const auto& node : nullGraph->nodes_) {
+      arenaSize += node.args_.size();
+    }
+    nullExec->arena_.reserve(arenaSize);
+    for (const auto& node : nullGraph->nodes_) {
+      nullExec->kernels_.push_back(node.kernel_);
+      nullExec->offsets_.push_back(nullExec->arena_.size());
+      nullExec->sizes_.push_back(node.args_.size());
+      nullExec->arena_.insert(nullExec->arena_.end(), node.args_.begin(), node.args_.end());
+    }
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.insert(nullExec);
+    *exec = nullExec;
+    return true;
+  }
+
+  bool graphLaunch(GraphExec exec, Stream stream) {
+    NullGraphExec* nullExec = find<NullGraphExec>(exec, TypeGraphExec);
+    NullQueue* queue = findQueue(stream);
+    if ((nullExec == nullptr) || (queue == nullptr)) {
+      return fail("Invalid graph or stream");
+    }
+    std::lock_guard<std::mutex> guard(queue->lock());
+    for (size_t i = 0; i < nullExec->kernels_.size(); ++i) {
+      queue->dispatch(nullExec->kernels_[i], nullExec->arena_.data() + nullExec->offsets_[i],
+                      nullExec->sizes_[i]);
+    }
+    return true;
+  }
+
+  bool graphDestroy(Graph graph) { return destroy<NullGraph>(graph, TypeGraph, "Invalid graph"); }
+
+  bool graphExecDestroy(GraphExec exec) {
+    return destroy<NullGraphExec>(exec, TypeGraphExec, "Invalid graph exec");
+  }
+
+  bool getCodeObject(const void** image, size_t* size) {
+    *image = NullCodeObject;
+    *size = sizeof(NullCodeObject);
+    return true;
+  }
+
+  bool moduleLoad(const void* image, Module* module) {
+    NullCodeObjectHeader header;
+    memcpy(&header, image, sizeof(header));
+    if (header.magic_ != NullCodeObjectMagic) {
+      return fail("Invalid code object");
+    }
+    NullModule* nullModule = new NullModule();
+    // Like a fat binary registration, find the file the image was loaded from
+    size_t offset = 0;
+    amd::Os::FindFileNameFromAddress(image, &nullModule->file_, &offset);
+    const char* data = static_cast<const char*>(image);
+    nullModule->image_.assign(data, data + header.size_);
+    const char* name = nullModule->image_.data() + sizeof(header);
+    for (uint32_t n = 0; n < header.numKernels_; ++n) {
+      nullModule->symbols_[name] = &kernels_[n];
+      name += strlen(name) + 1;
+    }
+    std::lock_guard<std::mutex> guard(registryLock_);
+    objects_.insert(nullModule);
+    *module = nullModule;
+    return true;
+  }
+
+  bool moduleUnload(Module module) {
+    return destroy<NullModule>(module, TypeModule, "Invalid module");
+  }
+
+  std::string stats() {
+    NullCounters current = retired_;
+    {
+      std::lock_guard<std::mutex> guard(registryLock_);
+      for (auto object : objects_) {
+        if (object->type_ == TypeStream) {
+          current.add(static_cast<NullQueue*>(object)->counters(), 1);
+        }
+      }
+    }
+    NullCounters delta = current;
+    delta.add(reported_, -1);
+    reported_ = current;
+    if (delta.packets_ == 0) {
+      return std::string();
+    }
+    std::stringstream stream;
+    stream << delta.packets_ << " packets, " << delta.doorbells_ << " doorbells, "
+           << delta.argHits_ << "/" << (delta.argHits_ + delta.argMisses_)
+           << " kernarg cache hits, " << delta.argInvalidations_ << " invalidations, "
+           << delta.barriersEmitted_ << "/" << delta.barriersRequested_ << " barrier packets";
+    return stream.str();
+  }
+
+ private:
+  template <typename T> T* find(void* handle, ObjectType type) {
+    std::lock_guard<std::mutex> guard(registryLock_);
+    auto it = objects_.find(static_cast<NullObject*>(handle));
+    if ((it == objects_.end()) || ((*it)->type_ != type)) {
+      return nullptr;
+    }
+    return static_cast<T*>(*it);
+  }
+
+  template <typename T> bool destroy(void* handle, ObjectType type, const char* msg) {
+    std::lock_guard<std::mutex> guard(registryLock_);
+    auto it = objects_.find(static_cast<NullObject*>(handle));
+    if ((it == objects_.end()) || ((*it)->type_ != type)) {
+      return fail(msg);
+    }
+    delete static_cast<T*>(*it);
+    objects_.erase(it);
+    return true;
+  }
+
+  //! Returns the queue of \a stream, nullptr is the default stream
+  NullQueue* findQueue(Stream stream) {
+    return (stream == nullptr) ? &defaultQueue_ : find<NullQueue>(stream, TypeStream);
+  }
+
+  bool validKernel(Function function) const {
+    const NullKernel* kernel = static_cast<const NullKernel*>(function);
+    return (kernel >= kernels_.data()) && (kernel < kernels_.data() + kernels_.size());
+  }
+
+  //! Copies the argument values into a kernarg image and returns its size
+  static size_t gatherArgs(const NullKernel* kernel, void** args, uint64_t* kernarg) {
+    for (unsigned int i = 0; i < kernel->numArgs_; ++i) {
+      memcpy(&kernarg[i], args[i], sizeof(uint64_t));
+    }
+    return kernel->numArgs_ * sizeof(uint64_t);
+  }
+
+  //! Builds the code object with the names of all kernels
+  void buildCodeObject() {
+    std::vector<char> names;
+    for (unsigned int n = 0; n <= MaxKernelArgs; ++n) {
+      std::string name = "hipperf_args_" + std::to_string(n);
+      names.insert(names.end(), name.c_str(), name.c_str() + name.size() + 1);
+    }
+    NullCodeObjectHeader header = {NullCodeObjectMagic, MaxKernelArgs + 1, sizeof(NullCodeObject)};
+    memcpy(NullCodeObject, &header, sizeof(header));
+    memcpy(NullCodeObject + sizeof(header), names.data(), names.size());
+  }
+
+  static thread_local int device_;
+  static thread_local int lastError_;
+
+  std::vector<NullKernel> kernels_;              //!< Kernels by argument count
+  NullQueue defaultQueue_;                       //!< The null stream
+  std::mutex registryLock_;                      //!< Guards the handle registry
+  std::unordered_set<NullObject*> objects_;      //!< All live handles
+  std::mutex poolLock_;                          //!< Guards the memory pool
+  std::multimap<size_t, void*> freeBlocks_;      //!< Freed blocks by size
+  std::unordered_map<void*, size_t> liveBlocks_; //!< Allocated blocks
+  NullCounters retired_;                         //!< Counters of destroyed streams
+  NullCounters reported_;                        //!< Counters at the last stats() call
+};
+
+thread_local int NullBackend::device_ = 0;
+thread_local int NullBackend::lastError_ = 0;
+
+}  // namespace
+
+HipPerfBackend* HipPerfCreateNullBackend() { return new NullBackend(); }
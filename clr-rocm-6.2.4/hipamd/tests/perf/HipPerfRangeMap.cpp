@@ -0,0 +1,140 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfRangeMap.h"
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "utils/concurrent.hpp"
+
+//! Lookups per thread
+static const unsigned int Lookups = 1000000;
+
+//! The number of ranges in the map, like the allocations a large application keeps live
+static const unsigned int NumRanges = 4096;
+static const uintptr_t RangeBase = 0x7f0000000000ull;
+static const uintptr_t RangeStride = 0x10000;
+
+static const unsigned int Threads[] = {1, 2, 4, 8};
+static const unsigned int NumThreadCounts = sizeof(Threads) / sizeof(Threads[0]);
+
+//! A map guarded by a single mutex, how MemObjMap looked up addresses before
+class LockedRangeMap {
+ public:
+  template <typename R, typename F> R floor(uintptr_t key, R notFound, F f) const {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = map_.upper_bound(key);
+    if (it == map_.begin()) {
+      return notFound;
+    }
+    --it;
+    return f(it->first, it->second);
+  }
+
+  std::map<uintptr_t, size_t>& map() { return map_; }
+
+ private:
+  mutable std::mutex lock_;
+  std::map<uintptr_t, size_t> map_;
+};
+
+//! Runs the lookups of all threads and returns the elapsed time in seconds
+template <typename Map> static double lookupAll(const Map& map, unsigned int numThreads,
+                                                size_t* found) {
+  std::vector<std::thread> threads;
+  std::vector<size_t> hits(numThreads, 0);
+  HipPerfTimer timer;
+  timer.Start();
+  for (unsigned int t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&map, &hits, t]() {
+      // A cheap pseudo random walk over the ranges and the gaps between them
+      uint32_t state = 0x9e3779b9u * (t + 1);
+      size_t count = 0;
+      for (unsigned int i = 0; i < Lookups; ++i) {
+        state = state * 1664525u + 1013904223u;
+        uintptr_t key = RangeBase + (state % NumRanges) * RangeStride + (state >> 20);
+        count += map.floor(key, size_t(0), [key](uintptr_t start, size_t size) {
+          return (key < start + size) ? size_t(1) : size_t(0);
+        });
+      }
+      hits[t] = count;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  timer.Stop();
+  *found = 0;
+  for (auto count : hits) {
+    *found += count;
+  }
+  return timer.GetElapsedTime();
+}
+
+HipPerfRangeMap::HipPerfRangeMap() : numThreads_(1) {
+  // Every thread count runs against the locked map and the runtime's ConcurrentRangeMap
+  _numSubTests = NumThreadCounts * 2;
+  _higherIsBetter = true;
+}
+
+HipPerfRangeMap::~HipPerfRangeMap() {}
+
+void HipPerfRangeMap::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  numThreads_ = Threads[_openTest % NumThreadCounts];
+}
+
+void HipPerfRangeMap::run(void) {
+  const bool concurrent = (_openTest >= NumThreadCounts);
+  size_t found = 0;
+  double elapsed = 0.0;
+
+  if (concurrent) {
+    auto* map = new amd::ConcurrentRangeMap<size_t>();
+    map->modify([](amd::ConcurrentRangeMap<size_t>::Map& ranges) {
+      for (unsigned int r = 0; r < NumRanges; ++r) {
+        ranges[RangeBase + r * RangeStride] = RangeStride / 2;
+      }
+      return true;
+    });
+    elapsed = lookupAll(*map, numThreads_, &found);
+    delete map;
+  } else {
+    LockedRangeMap map;
+    for (unsigned int r = 0; r < NumRanges; ++r) {
+      map.map()[RangeBase + r * RangeStride] = RangeStride / 2;
+    }
+    elapsed = lookupAll(map, numThreads_, &found);
+  }
+  CHECK_RESULT(found == 0, "No lookup hit a range");
+
+  std::stringstream stream;
+  stream << "Range lookups, " << numThreads_ << " threads, "
+         << (concurrent ? "ConcurrentRangeMap" : "mutex and std::map") << " (M/s)";
+  testDescString = stream.str();
+  _perfInfo = static_cast<float>(static_cast<double>(Lookups) * numThreads_ / elapsed / 1e6);
+}
+
+unsigned int HipPerfRangeMap::close(void) { return HipPerfTest::close(); }
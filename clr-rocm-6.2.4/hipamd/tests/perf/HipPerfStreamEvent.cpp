@@ -0,0 +1,139 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipPerfStreamEvent.h"
+
+#include <sstream>
+#include <vector>
+
+static const unsigned int CreateIterations = 10000;
+static const unsigned int RecordIterations = 100000;
+static const unsigned int WaitIterations = 10000;
+
+//! The number of events a consumer stream waits for in a row
+static const unsigned int WaitEvents = 4;
+
+static const char* TestNames[] = {
+    "Stream create+destroy time (us)",
+    "Event create+destroy time (us)",
+    "Event record time (us)",
+    "Cross-stream event waits and launch time (us)",
+};
+static const unsigned int NumTests = sizeof(TestNames) / sizeof(TestNames[0]);
+
+HipPerfStreamEvent::HipPerfStreamEvent()
+    : stream_(nullptr), producer_(nullptr), function_(nullptr) {
+  _numSubTests = NumTests;
+}
+
+HipPerfStreamEvent::~HipPerfStreamEvent() {}
+
+void HipPerfStreamEvent::open(unsigned int test, HipPerfBackend* backend) {
+  HipPerfTest::open(test, backend);
+  CHECK_BACKEND(backend_->streamCreate(&stream_));
+  CHECK_BACKEND(backend_->streamCreate(&producer_));
+  CHECK_BACKEND(backend_->getKernel(0, &function_));
+}
+
+void HipPerfStreamEvent::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  HipPerfTimer timer;
+  unsigned int iterations = 0;
+
+  switch (_openTest) {
+    case 0:
+      iterations = CreateIterations;
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        HipPerfBackend::Stream stream = nullptr;
+        CHECK_BACKEND(backend_->streamCreate(&stream));
+        CHECK_BACKEND(backend_->streamDestroy(stream));
+      }
+      timer.Stop();
+      break;
+    case 1:
+      iterations = CreateIterations;
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        HipPerfBackend::Event event = nullptr;
+        CHECK_BACKEND(backend_->eventCreate(&event));
+        CHECK_BACKEND(backend_->eventDestroy(event));
+      }
+      timer.Stop();
+      break;
+    case 2: {
+      iterations = RecordIterations;
+      HipPerfBackend::Event event = nullptr;
+      CHECK_BACKEND(backend_->eventCreate(&event));
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        CHECK_BACKEND(backend_->eventRecord(event, stream_));
+      }
+      CHECK_BACKEND(backend_->streamSynchronize(stream_));
+      timer.Stop();
+      CHECK_BACKEND(backend_->eventDestroy(event));
+      break;
+    }
+    case 3: {
+      iterations = WaitIterations;
+      std::vector<HipPerfBackend::Event> events(WaitEvents);
+      for (auto& event : events) {
+        CHECK_BACKEND(backend_->eventCreate(&event));
+      }
+      // The waits of a consumer stream on back-to-back events can share barrier packets
+      timer.Start();
+      for (unsigned int i = 0; i < iterations; ++i) {
+        for (auto event : events) {
+          CHECK_BACKEND(backend_->launchKernel(function_, nullptr, producer_));
+          CHECK_BACKEND(backend_->eventRecord(event, producer_));
+        }
+        for (auto event : events) {
+          CHECK_BACKEND(backend_->streamWaitEvent(stream_, event));
+        }
+        CHECK_BACKEND(backend_->launchKernel(function_, nullptr, stream_));
+      }
+      CHECK_BACKEND(backend_->streamSynchronize(stream_));
+      timer.Stop();
+      for (auto event : events) {
+        CHECK_BACKEND(backend_->eventDestroy(event));
+      }
+      break;
+    }
+  }
+
+  testDescString = TestNames[_openTest];
+  _perfInfo = static_cast<float>(timer.GetElapsedTime() * 1e6 / iterations);
+}
+
+unsigned int HipPerfStreamEvent::close(void) {
+  if (producer_ != nullptr) {
+    backend_->streamSynchronize(producer_);
+    backend_->streamDestroy(producer_);
+    producer_ = nullptr;
+  }
+  if (stream_ != nullptr) {
+    backend_->streamDestroy(stream_);
+    stream_ = nullptr;
+  }
+  return HipPerfTest::close();
+}
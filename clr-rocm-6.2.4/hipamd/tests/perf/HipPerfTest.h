@@ -0,0 +1,114 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#ifndef _HIP_PERF_TEST_H_
+#define _HIP_PERF_TEST_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "HipPerfBackend.h"
+
+#define CHECK_RESULT(test, msg, ...)                             \
+  if ((test)) {                                                  \
+    char buf[4096];                                              \
+    snprintf(buf, sizeof(buf), msg, ##__VA_ARGS__);              \
+    printf("%s:%d - %s\n", __FILE__, __LINE__, buf);             \
+    _errorFlag = true;                                           \
+    _errorMsg = buf;                                             \
+    return;                                                      \
+  }
+
+//! Checks a backend call, the backend provides the message
+#define CHECK_BACKEND(call) \
+  CHECK_RESULT(!(call), "%s failed: %s", #call, backend_->error().c_str())
+
+//! Wall clock timer with the interface of the ocltst CPerfCounter
+class HipPerfTimer {
+ public:
+  HipPerfTimer() { Reset(); }
+
+  void Reset() { elapsed_ = std::chrono::steady_clock::duration::zero(); }
+  void Start() { start_ = std::chrono::steady_clock::now(); }
+  void Stop() { elapsed_ += std::chrono::steady_clock::now() - start_; }
+
+  //! Returns the accumulated time in seconds
+  double GetElapsedTime() const { return std::chrono::duration<double>(elapsed_).count(); }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::duration elapsed_;
+};
+
+/*! \brief A benchmark with a number of subtests, modeled after the ocltst perf modules
+ *
+ *  The driver calls open(), run() and close() for every subtest. run() leaves the result in
+ *  _perfInfo and describes it in testDescString, the unit included.
+ */
+class HipPerfTest {
+ public:
+  HipPerfTest()
+      : _numSubTests(1), _openTest(0), _perfInfo(0.0f), _higherIsBetter(false),
+        _errorFlag(false), backend_(nullptr) {}
+  virtual ~HipPerfTest() {}
+
+  unsigned int getNumSubTests() const { return _numSubTests; }
+
+  virtual void open(unsigned int test, HipPerfBackend* backend) {
+    _openTest = test;
+    _perfInfo = 0.0f;
+    _errorFlag = false;
+    _errorMsg.clear();
+    testDescString.clear();
+    backend_ = backend;
+  }
+  virtual void run(void) = 0;
+  virtual unsigned int close(void) { return _errorFlag ? 1 : 0; }
+
+  float getPerfInfo() const { return _perfInfo; }
+  //! Returns true if larger results are better, e.g. for rates
+  bool higherIsBetter() const { return _higherIsBetter; }
+  bool hasErrorOccured() const { return _errorFlag; }
+  const std::string& getErrorMsg() const { return _errorMsg; }
+
+  std::string testDescString;
+
+ protected:
+  unsigned int _numSubTests;
+  unsigned int _openTest;
+  float _perfInfo;
+  bool _higherIsBetter;
+  bool _errorFlag;
+  std::string _errorMsg;
+  HipPerfBackend* backend_;
+};
+
+//! An entry of the test list
+struct TestEntry {
+  const char* name;
+  HipPerfTest* (*create)(void);
+};
+
+extern TestEntry TestList[];
+extern unsigned int TestListCount;
+
+#endif  // _HIP_PERF_TEST_H_
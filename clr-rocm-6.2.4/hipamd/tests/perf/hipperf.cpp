@@ -0,0 +1,240 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "HipPerfTest.h"
+#include "os/os.hpp"
+#include "utils/flags.hpp"
+
+HipPerfBackend* HipPerfCreateBackend(const char* name) {
+  if (strcmp(name, "hip") == 0) {
+    return HipPerfCreateHipBackend();
+  }
+  if (strcmp(name, "null") == 0) {
+    return HipPerfCreateNullBackend();
+  }
+  // Anything else is a backend library
+#ifdef _WIN32
+  HMODULE library = LoadLibraryA(name);
+  void* create = (library != NULL) ? GetProcAddress(library, "HipPerfCreateBackend") : nullptr;
+#else
+  void* library = dlopen(name, RTLD_NOW | RTLD_LOCAL);
+  void* create = (library != nullptr) ? dlsym(library, "HipPerfCreateBackend") : nullptr;
+#endif
+  if (create == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<HipPerfCreateBackendFunc>(create)();
+}
+
+static void usage(const char* program) {
+  printf(
+      "Usage: %s [options]\n"
+      "  -b <backend>    hip, null or the path of a backend library (default: $HIPPERF_BACKEND "
+      "or hip)\n"
+      "                  null only runs the ROCm queue helpers, not the HIP host path\n"
+      "  -d <device>     Device index (default: 0)\n"
+      "  -t <test>       Run only this test, may be repeated\n"
+      "  -s <subtest>    Run only this subtest\n"
+      "  -i <count>      Run every subtest count times and keep the best result (default: 1)\n"
+      "  -A <file>       Skip the tests listed in the file\n"
+      "  -o <file>       Write the results as CSV\n"
+      "  -r <file>       Compare against the CSV results of an earlier run\n"
+      "  -T <percent>    Tolerated regression against the earlier run (default: 10)\n"
+      "  -l              List the tests\n",
+      program);
+}
+
+//! Reads the test names of an exclude file, one per line, # starts a comment
+static void readExcludes(const char* path, std::set<std::string>* excludes) {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (!line.empty()) {
+      excludes->insert(line);
+    }
+  }
+}
+
+//! Reads the results of an earlier run, keyed by "test:subtest"
+static void readBaseline(const char* path, std::map<std::string, float>* baseline) {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::stringstream fields(line);
+    std::string test, subtest, value;
+    if (std::getline(fields, test, ',') && std::getline(fields, subtest, ',') &&
+        std::getline(fields, value, ',')) {
+      (*baseline)[test + ":" + subtest] = static_cast<float>(atof(value.c_str()));
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* backendName = getenv("HIPPERF_BACKEND");
+  unsigned int deviceId = 0;
+  std::set<std::string> tests;
+  int subtest = -1;
+  unsigned int repeat = 1;
+  std::set<std::string> excludes;
+  const char* outputPath = nullptr;
+  std::map<std::string, float> baseline;
+  float tolerance = 10.0f;
+
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (strcmp(arg, "-l") == 0) {
+      for (unsigned int t = 0; t < TestListCount; ++t) {
+        printf("%s\n", TestList[t].name);
+      }
+      return 0;
+    }
+    if ((arg[0] != '-') || (arg[1] == '\0') || (arg[2] != '\0') || (value == nullptr)) {
+      usage(argv[0]);
+      return 1;
+    }
+    switch (arg[1]) {
+      case 'b':
+        backendName = value;
+        break;
+      case 'd':
+        deviceId = static_cast<unsigned int>(atoi(value));
+        break;
+      case 't':
+        tests.insert(value);
+        break;
+      case 's':
+        subtest = atoi(value);
+        break;
+      case 'i':
+        repeat = std::max(atoi(value), 1);
+        break;
+      case 'A':
+        readExcludes(value, &excludes);
+        break;
+      case 'o':
+        outputPath = value;
+        break;
+      case 'r':
+        readBaseline(value, &baseline);
+        break;
+      case 'T':
+        tolerance = static_cast<float>(atof(value));
+        break;
+      default:
+        usage(argv[0]);
+        return 1;
+    }
+    ++i;
+  }
+  if (backendName == nullptr) {
+    backendName = "hip";
+  }
+
+  // The host tests call into the runtime's OS layer directly
+  amd::Flag::init();
+  amd::Os::init();
+
+  HipPerfBackend* backend = HipPerfCreateBackend(backendName);
+  if (backend == nullptr) {
+    printf("Backend %s not found\n", backendName);
+    return 1;
+  }
+  if (!backend->init(deviceId)) {
+    printf("Backend %s failed to initialize: %s\n", backendName, backend->error().c_str());
+    delete backend;
+    return 1;
+  }
+  printf("Backend: %s, device %u\n", backend->name(), deviceId);
+
+  FILE* output = (outputPath != nullptr) ? fopen(outputPath, "w") : nullptr;
+  unsigned int failures = 0;
+  for (unsigned int t = 0; t < TestListCount; ++t) {
+    const char* name = TestList[t].name;
+    if ((!tests.empty() && (tests.count(name) == 0)) || (excludes.count(name) != 0)) {
+      continue;
+    }
+    HipPerfTest* test = TestList[t].create();
+    for (unsigned int s = 0; s < test->getNumSubTests(); ++s) {
+      if ((subtest >= 0) && (static_cast<unsigned int>(subtest) != s)) {
+        continue;
+      }
+      float best = 0.0f;
+      bool failed = false;
+      for (unsigned int r = 0; (r < repeat) && !failed; ++r) {
+        test->open(s, backend);
+        test->run();
+        failed = (test->close() != 0);
+        float perf = test->getPerfInfo();
+        if ((r == 0) || (test->higherIsBetter() ? (perf > best) : (perf < best))) {
+          best = perf;
+        }
+      }
+      if (failed) {
+        printf("%-22s %3u: FAILED %s\n", name, s, test->getErrorMsg().c_str());
+        failures++;
+        continue;
+      }
+      printf("%-22s %3u: %-70s %12.3f", name, s, test->testDescString.c_str(), best);
+      auto it = baseline.find(std::string(name) + ":" + std::to_string(s));
+      if ((it != baseline.end()) && (it->second > 0.0f)) {
+        float change = (best - it->second) * 100.0f / it->second;
+        bool regressed = test->higherIsBetter() ? (-change > tolerance) : (change > tolerance);
+        printf(" %+7.1f%%%s", change, regressed ? " REGRESSION" : "");
+        failures += regressed ? 1 : 0;
+      }
+      printf("\n");
+      if (output != nullptr) {
+        fprintf(output, "%s,%u,%f,%s\n", name, s, best, test->testDescString.c_str());
+      }
+    }
+    std::string stats = backend->stats();
+    if (!stats.empty()) {
+      printf("%-22s      %s\n", name, stats.c_str());
+    }
+    delete test;
+  }
+
+  if (output != nullptr) {
+    fclose(output);
+  }
+  delete backend;
+  return (failures != 0) ? 1 : 0;
+}
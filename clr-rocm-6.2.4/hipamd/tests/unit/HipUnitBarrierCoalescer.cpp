@@ -0,0 +1,147 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipUnitBarrierCoalescer.h"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "device/rocm/rocbarrier.hpp"
+
+//! A signal handle like hsa_signal_t, 0 is the null signal
+struct MockSignal {
+  uint64_t handle;
+};
+
+//! A barrier-AND packet written by the coalescer
+struct MockPacket {
+  uint16_t header_;
+  std::vector<uint64_t> deps_;  //!< The non-null dependencies
+  uint64_t completion_;
+};
+
+//! Records the packets instead of writing them into an AQL queue
+struct MockQueue {
+  std::set<uint64_t> satisfied_;
+  std::vector<MockPacket> packets_;
+
+  bool IsSatisfied(MockSignal signal) const { return satisfied_.count(signal.handle) != 0; }
+  void Emit(uint16_t header, const MockSignal* deps, MockSignal completion) {
+    MockPacket packet = {header, {}, completion.handle};
+    for (size_t i = 0; i < amd::roc::BarrierCoalescer<MockSignal>::kMaxDeps; ++i) {
+      if (deps[i].handle != 0) {
+        packet.deps_.push_back(deps[i].handle);
+      }
+    }
+    packets_.push_back(packet);
+  }
+};
+
+static constexpr uint16_t kWaitHeader = 1;
+static constexpr uint16_t kBarrierHeader = 2;
+
+/*! \brief The barrier-AND packet assembly of the ROCm virtual GPU
+ *
+ *  Unneeded dependencies are dropped, a wait-only barrier with nothing left isn't written, and
+ *  the remaining dependencies are packed into full packets.
+ */
+HipUnitBarrierCoalescer::HipUnitBarrierCoalescer() { _numSubTests = 4; }
+
+HipUnitBarrierCoalescer::~HipUnitBarrierCoalescer() {}
+
+void HipUnitBarrierCoalescer::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitBarrierCoalescer::run(void) {
+  amd::roc::BarrierCoalescer<MockSignal> coalescer(kWaitHeader);
+  MockQueue queue;
+  auto completion = [&queue]() { return MockSignal{100 + queue.packets_.size()}; };
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Null, duplicate and satisfied dependencies are dropped";
+      queue.satisfied_.insert(3);
+      const MockSignal deps[] = {{0}, {1}, {1}, {3}};
+      coalescer.Wait(queue, deps, 4);
+      CHECK_RESULT(queue.packets_.size() != 1, "%zu packets for one wait", queue.packets_.size());
+      CHECK_RESULT(queue.packets_[0].header_ != kWaitHeader || queue.packets_[0].completion_ != 0,
+                   "The wait isn't a wait-only barrier");
+      CHECK_RESULT(queue.packets_[0].deps_ != std::vector<uint64_t>({1}),
+                   "Unneeded dependencies were kept");
+      queue.satisfied_.insert(1);
+      coalescer.Wait(queue, deps, 4);
+      CHECK_RESULT(queue.packets_.size() != 1, "A wait-only barrier without dependencies stayed");
+      CHECK_RESULT(coalescer.Requested() != 2 || coalescer.Saved() != 1,
+                   "Statistics %llu requested, %llu emitted",
+                   static_cast<unsigned long long>(coalescer.Requested()),
+                   static_cast<unsigned long long>(coalescer.Emitted()));
+      break;
+    }
+    case 1: {
+      testDescString = "Waits ahead of kernel dispatches are written before they return";
+      const MockSignal wait0[] = {{1}, {2}};
+      const MockSignal wait1[] = {{2}, {3}};
+      coalescer.Wait(queue, wait0, 2);
+      CHECK_RESULT(queue.packets_.size() != 1, "The first wait wasn't written");
+      // A kernel dispatch goes into the queue here, so the next wait can't share the packet
+      coalescer.Wait(queue, wait1, 2);
+      CHECK_RESULT(queue.packets_.size() != 2, "%zu packets for two waits",
+                   queue.packets_.size());
+      CHECK_RESULT(queue.packets_[1].deps_ != std::vector<uint64_t>({2, 3}),
+                   "The second wait lost a dependency of the first one");
+      const MockSignal deps[] = {{4}};
+      coalescer.Barrier(queue, kBarrierHeader, deps, 1, completion);
+      CHECK_RESULT(queue.packets_.size() != 3 || queue.packets_[2].header_ != kBarrierHeader ||
+                       queue.packets_[2].deps_ != std::vector<uint64_t>({4}),
+                   "The barrier picked up dependencies of earlier waits");
+      break;
+    }
+    case 2: {
+      testDescString = "A full packet is written before more dependencies are staged";
+      const MockSignal deps[] = {{1}, {2}, {3}, {4}, {5}, {6}, {7}};
+      coalescer.Barrier(queue, kBarrierHeader, deps, 7, completion);
+      CHECK_RESULT(queue.packets_.size() != 2, "%zu packets for 7 dependencies",
+                   queue.packets_.size());
+      CHECK_RESULT(queue.packets_[0].header_ != kWaitHeader || queue.packets_[0].completion_ != 0 ||
+                       queue.packets_[0].deps_ != std::vector<uint64_t>({1, 2, 3, 4, 5}),
+                   "The overflow packet isn't a full wait-only barrier");
+      // The completion is requested after the overflow packet was written
+      CHECK_RESULT(queue.packets_[1].header_ != kBarrierHeader ||
+                       queue.packets_[1].completion_ != 101 ||
+                       queue.packets_[1].deps_ != std::vector<uint64_t>({6, 7}),
+                   "The barrier packet doesn't carry the remaining dependencies");
+      CHECK_RESULT(coalescer.Saved() != 0, "Saved packets without any merge");
+      break;
+    }
+    case 3: {
+      testDescString = "A barrier without dependencies still writes its packet";
+      coalescer.Barrier(queue, kBarrierHeader, nullptr, 0, completion);
+      CHECK_RESULT(queue.packets_.size() != 1 || !queue.packets_[0].deps_.empty() ||
+                       queue.packets_[0].completion_ != 100,
+                   "The completion only barrier wasn't written as is");
+      CHECK_RESULT(coalescer.Requested() != 1 || coalescer.Emitted() != 1,
+                   "An empty barrier counts as one packet");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitBarrierCoalescer::close(void) { return HipUnitTest::close(); }
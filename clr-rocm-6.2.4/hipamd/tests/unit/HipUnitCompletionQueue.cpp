@@ -0,0 +1,121 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+
+#include "HipUnitCompletionQueue.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "device/rocm/roccompletion.hpp"
+
+//! A command with a mock completion signal, done once the signal drops below its threshold
+struct MockEntry {
+  int id_;
+  const int64_t* signal_;
+  int64_t threshold_;
+};
+
+//! Probes the mock signal of an entry like the reaper probes an HSA signal
+static bool probe(const MockEntry& entry) { return *entry.signal_ < entry.threshold_; }
+
+static std::vector<int> ids(const std::vector<MockEntry>& entries) {
+  std::vector<int> result;
+  for (const auto& entry : entries) {
+    result.push_back(entry.id_);
+  }
+  return result;
+}
+
+/*! \brief The per queue ordering of the completion reaper
+ *
+ *  Commands complete strictly in submission order, their latency is kept in power of two
+ *  microsecond buckets, and a queue removed from the reaper thread drains its entries.
+ */
+HipUnitCompletionQueue::HipUnitCompletionQueue() { _numSubTests = 4; }
+
+HipUnitCompletionQueue::~HipUnitCompletionQueue() {}
+
+void HipUnitCompletionQueue::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitCompletionQueue::run(void) {
+  amd::roc::CompletionQueue<MockEntry> queue;
+  std::vector<MockEntry> done;
+  int64_t signals[4] = {1, 1, 1, 1};
+  for (int i = 0; i < 4; ++i) {
+    queue.Push({i, &signals[i], 1}, 0);
+  }
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "A completed command behind a pending one waits for it";
+      signals[1] = 0;
+      signals[2] = 0;
+      CHECK_RESULT(queue.Reap(probe, 0, &done) != 0, "Reaped past the pending first command");
+      signals[0] = 0;
+      CHECK_RESULT(queue.Reap(probe, 0, &done) != 3, "Completed prefix wasn't reaped");
+      CHECK_RESULT(ids(done) != std::vector<int>({0, 1, 2}), "Commands reaped out of order");
+      CHECK_RESULT(queue.Size() != 1 || queue.Front().id_ != 3, "Pending command was lost");
+      break;
+    }
+    case 1: {
+      testDescString = "Reaping stops after the requested number of commands";
+      for (auto& signal : signals) {
+        signal = 0;
+      }
+      CHECK_RESULT(queue.Reap(probe, 0, &done, 2) != 2, "maxCount wasn't respected");
+      CHECK_RESULT(queue.Reap(probe, 0, &done) != 2 || !queue.Empty(),
+                   "Remaining commands weren't reaped");
+      CHECK_RESULT(ids(done) != std::vector<int>({0, 1, 2, 3}), "Commands reaped out of order");
+      break;
+    }
+    case 2: {
+      testDescString = "Latencies land in power of two microsecond buckets";
+      const uint64_t us = 1000;
+      CHECK_RESULT(queue.Bucket(0) != 0 || queue.Bucket(999) != 0, "Sub microsecond bucket");
+      CHECK_RESULT(queue.Bucket(us) != 1 || queue.Bucket(2 * us - 1) != 1, "[1, 2) us bucket");
+      CHECK_RESULT(queue.Bucket(2 * us) != 2 || queue.Bucket(1000 * us) != 10,
+                   "Bucket of 2 us or 1 ms");
+      CHECK_RESULT(queue.Bucket(UINT64_MAX) != queue.kHistogramBuckets - 1,
+                   "Latency past the last bucket");
+      signals[0] = 0;
+      signals[1] = 0;
+      queue.Reap(probe, 5 * us, &done);
+      const amd::roc::CompletionHistogram& histogram = queue.GetHistogram();
+      CHECK_RESULT(histogram[3] != 2, "%llu commands in the [4, 8) us bucket",
+                   static_cast<unsigned long long>(histogram[3]));
+      break;
+    }
+    case 3: {
+      testDescString = "Draining hands over all commands in order without latencies";
+      signals[2] = 0;
+      queue.Drain(&done);
+      CHECK_RESULT(!queue.Empty(), "%zu commands left after the drain", queue.Size());
+      CHECK_RESULT(ids(done) != std::vector<int>({0, 1, 2, 3}), "Commands drained out of order");
+      for (auto count : queue.GetHistogram()) {
+        CHECK_RESULT(count != 0, "Drained commands were counted in the histogram");
+      }
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitCompletionQueue::close(void) { return HipUnitTest::close(); }
@@ -0,0 +1,131 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipUnitConcurrentRangeMap.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "utils/concurrent.hpp"
+
+typedef amd::ConcurrentRangeMap<uintptr_t> RangeMap;
+
+//! Returns the end of the range that contains key, 0 if none does
+static uintptr_t rangeEnd(const RangeMap& ranges, uintptr_t key) {
+  return ranges.floor(key, uintptr_t(0), [key](uintptr_t, uintptr_t end) {
+    return (key < end) ? end : 0;
+  });
+}
+
+/*! \brief The left-right map behind the memory object lookups
+ *
+ *  Updates run on both copies of the map and readers only see complete updates, without ever
+ *  waiting for a writer.
+ */
+HipUnitConcurrentRangeMap::HipUnitConcurrentRangeMap() { _numSubTests = 3; }
+
+HipUnitConcurrentRangeMap::~HipUnitConcurrentRangeMap() {}
+
+void HipUnitConcurrentRangeMap::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitConcurrentRangeMap::run(void) {
+  RangeMap ranges;
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Floor lookups find the range, which contains the key";
+      ranges.modify([](auto& map) {
+        map[100] = 200;
+        map[300] = 400;
+      });
+      CHECK_RESULT(rangeEnd(ranges, 99) != 0, "A key below all ranges was found");
+      CHECK_RESULT(rangeEnd(ranges, 100) != 200 || rangeEnd(ranges, 199) != 200,
+                   "A key inside the first range wasn't found");
+      CHECK_RESULT(rangeEnd(ranges, 200) != 0, "A key between the ranges was found");
+      CHECK_RESULT(rangeEnd(ranges, 350) != 400, "A key inside the last range wasn't found");
+      break;
+    }
+    case 1: {
+      testDescString = "Updates change both copies and return the result of the first run";
+      int runs = 0;
+      for (uintptr_t i = 0; i < 4; ++i) {
+        bool inserted = ranges.modify([&](auto& map) {
+          ++runs;
+          return map.insert({i * 10, i * 10 + 5}).second;
+        });
+        CHECK_RESULT(!inserted, "Insert %lu reported as a duplicate",
+                     static_cast<unsigned long>(i));
+      }
+      CHECK_RESULT(runs != 8, "%d runs for 4 updates", runs);
+      // Consecutive reads alternate with the updates, so each copy is read at least once
+      for (int i = 0; i < 2; ++i) {
+        size_t size = ranges.read([](const auto& map) { return map.size(); });
+        CHECK_RESULT(size != 4, "A copy has %zu ranges", size);
+        ranges.modify([](auto& map) { map.erase(1000); });
+      }
+      bool duplicate = !ranges.modify([](auto& map) { return map.insert({0, 1}).second; });
+      CHECK_RESULT(!duplicate || rangeEnd(ranges, 0) != 5, "A duplicate insert changed the map");
+      break;
+    }
+    case 2: {
+      testDescString = "Readers never see a partial update while writers run";
+      constexpr int kReaders = 4;
+      std::atomic<bool> done(false);
+      std::atomic<int> torn(0);
+      std::atomic<uint64_t> reads(0);
+      std::vector<std::thread> readers;
+      for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&]() {
+          while (!done.load(std::memory_order_relaxed)) {
+            // Each update adds or removes a pair of ranges, so the size is always even
+            size_t size = ranges.read([](const auto& map) { return map.size(); });
+            if ((size % 2) != 0) {
+              torn++;
+            }
+            reads++;
+          }
+        });
+      }
+      for (uintptr_t i = 0; i < 20000; ++i) {
+        uintptr_t key = (i % 64) * 16;
+        ranges.modify([key](auto& map) {
+          if (map.erase(key) == 0) {
+            map[key] = key + 4;
+            map[key + 8] = key + 12;
+          } else {
+            map.erase(key + 8);
+          }
+        });
+      }
+      done = true;
+      for (auto& reader : readers) {
+        reader.join();
+      }
+      CHECK_RESULT(torn != 0, "%d reads saw a partial update", torn.load());
+      CHECK_RESULT(reads == 0, "No read completed");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitConcurrentRangeMap::close(void) { return HipUnitTest::close(); }
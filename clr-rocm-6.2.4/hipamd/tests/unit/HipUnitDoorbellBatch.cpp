@@ -0,0 +1,151 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipUnitDoorbellBatch.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "device/rocm/rocdoorbell.hpp"
+
+//! Size of the mock AQL queue
+static const uint32_t QueueSize = 64;
+
+/*! \brief The doorbell path of roc::VirtualGPU over a mock AQL queue
+ *
+ *  hipExtLaunchKernelBatch() opens a dispatch batch on the virtual device, enqueues all kernels
+ *  and closes the batch. Kernel dispatches defer the doorbell while the batch is open, barriers
+ *  ring it, and a batch never defers more than half the queue.
+ */
+class MockVirtualDevice {
+ public:
+  //! Records the doorbell writes and the open batch
+  struct Queue {
+    std::vector<uint64_t> doorbells_;
+    int openBatches_ = 0;
+    int batches_ = 0;
+    void WriteDoorbell(uint64_t index) { doorbells_.push_back(index); }
+    void BatchOpened() {
+      openBatches_++;
+      batches_++;
+    }
+    void BatchClosed() { openBatches_--; }
+  };
+
+  void beginDispatchBatch() { deferDoorbell_ = true; }
+  void endDispatchBatch() {
+    batch_.Flush(queue_, std::numeric_limits<uint64_t>::max());
+    deferDoorbell_ = false;
+  }
+  void dispatchKernel() { submit(true); }
+  void dispatchBarrier() { submit(false); }
+
+  const Queue& queue() const { return queue_; }
+  uint64_t lastIndex() const { return index_ - 1; }
+
+ private:
+  void submit(bool deferrable) {
+    batch_.Submit(queue_, index_++, deferrable && deferDoorbell_, 0, QueueSize >> 1,
+                  std::numeric_limits<uint64_t>::max());
+  }
+
+  amd::roc::DoorbellBatch batch_;
+  Queue queue_;
+  uint64_t index_ = 0;
+  bool deferDoorbell_ = false;
+};
+
+HipUnitDoorbellBatch::HipUnitDoorbellBatch() { _numSubTests = 4; }
+
+HipUnitDoorbellBatch::~HipUnitDoorbellBatch() {}
+
+void HipUnitDoorbellBatch::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitDoorbellBatch::run(void) {
+  MockVirtualDevice device;
+  const auto& queue = device.queue();
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "A batch of kernels rings the doorbell once, at its end";
+      device.beginDispatchBatch();
+      for (int i = 0; i < 16; ++i) {
+        device.dispatchKernel();
+      }
+      CHECK_RESULT(!queue.doorbells_.empty(), "Doorbell written inside the batch");
+      device.endDispatchBatch();
+      CHECK_RESULT(queue.doorbells_.size() != 1, "%zu doorbell writes for the batch",
+                   queue.doorbells_.size());
+      CHECK_RESULT(queue.doorbells_[0] != device.lastIndex(),
+                   "Doorbell index %llu doesn't cover the last kernel",
+                   static_cast<unsigned long long>(queue.doorbells_[0]));
+      break;
+    }
+    case 1: {
+      testDescString = "A barrier inside a batch rings the doorbell for the deferred kernels";
+      device.beginDispatchBatch();
+      for (int i = 0; i < 4; ++i) {
+        device.dispatchKernel();
+      }
+      device.dispatchBarrier();
+      CHECK_RESULT(queue.doorbells_.size() != 1 || queue.doorbells_[0] != 4,
+                   "The barrier didn't ring the doorbell for the kernels before it");
+      device.dispatchKernel();
+      device.endDispatchBatch();
+      CHECK_RESULT(queue.doorbells_.size() != 2 || queue.doorbells_[1] != device.lastIndex(),
+                   "The kernel after the barrier wasn't rung at the end of the batch");
+      break;
+    }
+    case 2: {
+      testDescString = "A batch longer than half the queue rings every half queue";
+      device.beginDispatchBatch();
+      for (uint32_t i = 0; i < QueueSize * 2; ++i) {
+        device.dispatchKernel();
+      }
+      device.endDispatchBatch();
+      CHECK_RESULT(queue.doorbells_.size() != 4, "%zu doorbell writes for 4 half queues",
+                   queue.doorbells_.size());
+      for (size_t i = 0; i < queue.doorbells_.size(); ++i) {
+        CHECK_RESULT(queue.doorbells_[i] != (i + 1) * (QueueSize >> 1) - 1,
+                     "Doorbell %zu at index %llu", i,
+                     static_cast<unsigned long long>(queue.doorbells_[i]));
+      }
+      CHECK_RESULT(queue.batches_ != 4 || queue.openBatches_ != 0,
+                   "%d batches opened, %d still open", queue.batches_, queue.openBatches_);
+      break;
+    }
+    case 3: {
+      testDescString = "Kernels outside a batch ring the doorbell one by one";
+      for (int i = 0; i < 8; ++i) {
+        device.dispatchKernel();
+      }
+      device.beginDispatchBatch();
+      device.endDispatchBatch();
+      CHECK_RESULT(queue.doorbells_.size() != 8, "%zu doorbell writes for 8 kernels",
+                   queue.doorbells_.size());
+      CHECK_RESULT(queue.batches_ != 0, "An empty batch was reported");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitDoorbellBatch::close(void) { return HipUnitTest::close(); }
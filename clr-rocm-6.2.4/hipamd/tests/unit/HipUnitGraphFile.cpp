@@ -0,0 +1,127 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+
+#include "HipUnitGraphFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hip_graph_file.hpp"
+
+/*! \brief The graph file encoding of hipExtGraphSave() and hipExtGraphLoad()
+ *
+ *  Pointers into the allocations of saved memory allocation nodes are written as relocations and
+ *  fixed up with the allocations of the loading process, everything else round trips unchanged.
+ */
+HipUnitGraphFile::HipUnitGraphFile() { _numSubTests = 4; }
+
+HipUnitGraphFile::~HipUnitGraphFile() {}
+
+void HipUnitGraphFile::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitGraphFile::run(void) {
+  // Stand-ins for the allocations of the saving and the loading process
+  static char savedAlloc[2][256];
+  static char loadedAlloc[2][256];
+  hip::GraphFileWriter writer;
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Pointers into saved allocations are relocated on load";
+      writer.AddAllocation(savedAlloc[0], sizeof(savedAlloc[0]));
+      writer.AddAllocation(savedAlloc[1], sizeof(savedAlloc[1]));
+      writer.WritePointer(savedAlloc[1] + 16);
+      writer.WritePointer(savedAlloc[0]);
+      writer.WritePointer(savedAlloc[0] + sizeof(savedAlloc[0]) - 1);
+
+      hip::GraphFileReader reader(writer.Buffer());
+      reader.AddAllocation(loadedAlloc[0]);
+      reader.AddAllocation(loadedAlloc[1]);
+      void* ptr[3] = {};
+      for (auto& p : ptr) {
+        CHECK_RESULT(!reader.ReadPointer(&p), "Can't read back a relocated pointer");
+      }
+      CHECK_RESULT(ptr[0] != loadedAlloc[1] + 16, "Pointer with an offset wasn't relocated");
+      CHECK_RESULT(ptr[1] != loadedAlloc[0], "Allocation base wasn't relocated");
+      CHECK_RESULT(ptr[2] != loadedAlloc[0] + sizeof(loadedAlloc[0]) - 1,
+                   "Last byte of an allocation wasn't relocated");
+      break;
+    }
+    case 1: {
+      testDescString = "Only pointers inside the saved allocations are reported as relocatable";
+      writer.AddAllocation(savedAlloc[0], sizeof(savedAlloc[0]));
+      CHECK_RESULT(!writer.IsAllocation(savedAlloc[0] + 8), "Pointer inside the allocation");
+      CHECK_RESULT(writer.IsAllocation(savedAlloc[0] + sizeof(savedAlloc[0])),
+                   "Pointer past the end of the allocation");
+      CHECK_RESULT(writer.IsAllocation(loadedAlloc[0]), "Pointer to an unrelated buffer");
+      CHECK_RESULT(writer.IsAllocation(nullptr), "Null pointer");
+      break;
+    }
+    case 2: {
+      testDescString = "Values, strings and raw pointers round trip unchanged";
+      const uint64_t value = 0x0123456789abcdefULL;
+      int hostValue = 0;
+      writer.Write(value);
+      writer.WriteString("kernel_name");
+      writer.WritePointer(&hostValue);
+      writer.WritePointer(nullptr);
+
+      hip::GraphFileReader reader(writer.Buffer());
+      uint64_t readValue = 0;
+      std::string name;
+      void* ptr[2] = {loadedAlloc[0], loadedAlloc[0]};
+      CHECK_RESULT(!reader.Read(&readValue) || readValue != value, "Value didn't round trip");
+      CHECK_RESULT(!reader.ReadString(&name) || name != "kernel_name",
+                   "String didn't round trip");
+      CHECK_RESULT(!reader.ReadPointer(&ptr[0]) || ptr[0] != &hostValue,
+                   "Raw pointer didn't round trip");
+      CHECK_RESULT(!reader.ReadPointer(&ptr[1]) || ptr[1] != nullptr,
+                   "Null pointer didn't round trip");
+      CHECK_RESULT(reader.Readable(1), "Bytes left after the last value");
+      break;
+    }
+    case 3: {
+      testDescString = "Truncated files and unknown allocations are rejected";
+      writer.AddAllocation(savedAlloc[0], sizeof(savedAlloc[0]));
+      writer.AddAllocation(savedAlloc[1], sizeof(savedAlloc[1]));
+      writer.WritePointer(savedAlloc[1]);
+      writer.WriteString("kernel_name");
+
+      hip::GraphFileReader reader(writer.Buffer());
+      reader.AddAllocation(loadedAlloc[0]);
+      void* ptr = nullptr;
+      CHECK_RESULT(reader.ReadPointer(&ptr), "Pointer into a missing allocation was read");
+
+      std::vector<char> truncated(writer.Buffer().begin(), writer.Buffer().end() - 1);
+      hip::GraphFileReader truncatedReader(truncated);
+      std::string name;
+      truncatedReader.AddAllocation(loadedAlloc[0]);
+      truncatedReader.AddAllocation(loadedAlloc[1]);
+      CHECK_RESULT(!truncatedReader.ReadPointer(&ptr), "Can't read the complete pointer");
+      CHECK_RESULT(truncatedReader.ReadString(&name), "Truncated string was read");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitGraphFile::close(void) { return HipUnitTest::close(); }
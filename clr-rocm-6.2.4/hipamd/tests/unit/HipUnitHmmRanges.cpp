@@ -0,0 +1,132 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+
+#include "HipUnitHmmRanges.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hip_hmm_ranges.hpp"
+
+using hip::HmmRangeState;
+using hip::RangeMap;
+
+//! Size of the tracked allocation
+static const size_t AllocSize = 1024;
+
+//! Collects the segments of [begin, end) as (begin, end, value) triples
+template <typename T>
+static std::vector<size_t> segments(const RangeMap<T>& ranges, size_t begin, size_t end) {
+  std::vector<size_t> result;
+  ranges.ForEach(begin, end, [&](size_t segBegin, size_t segEnd, const T& value) {
+    result.push_back(segBegin);
+    result.push_back(segEnd);
+    result.push_back(static_cast<size_t>(value));
+  });
+  return result;
+}
+
+/*! \brief The interval logic of the managed memory range tracking
+ *
+ *  A RangeMap keeps an allocation covered by non-overlapping segments and merges equal
+ *  neighbours. HmmNarrowPrefetch() drops a prefetch that is already in effect and narrows it to
+ *  the span that still needs it.
+ */
+HipUnitHmmRanges::HipUnitHmmRanges() { _numSubTests = 4; }
+
+HipUnitHmmRanges::~HipUnitHmmRanges() {}
+
+void HipUnitHmmRanges::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitHmmRanges::run(void) {
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Updates split the segments on their boundaries and clip to the range";
+      RangeMap<int> ranges(AllocSize);
+      ranges.Update(100, 200, [](int& value) { value = 1; });
+      ranges.Update(900, 2 * AllocSize, [](int& value) { value = 2; });
+      std::vector<size_t> expected = {0,   100, 0, 100, 200,       1, 200, 900, 0,
+                                      900, AllocSize, 2};
+      CHECK_RESULT(segments(ranges, 0, AllocSize) != expected, "Unexpected segments");
+      CHECK_RESULT(ranges.NumSegments() != 4, "%zu segments", ranges.NumSegments());
+      expected = {150, 200, 1, 200, 250, 0};
+      CHECK_RESULT(segments(ranges, 150, 250) != expected, "Segments aren't clipped to the query");
+      ranges.Update(AllocSize, AllocSize + 10, [](int& value) { value = 3; });
+      ranges.Update(300, 300, [](int& value) { value = 3; });
+      CHECK_RESULT(ranges.NumSegments() != 4, "Empty update changed the segments");
+      break;
+    }
+    case 1: {
+      testDescString = "Equal neighbours are merged after an update";
+      RangeMap<int> ranges(AllocSize);
+      ranges.Update(100, 200, [](int& value) { value = 1; });
+      ranges.Update(300, 400, [](int& value) { value = 1; });
+      CHECK_RESULT(ranges.NumSegments() != 5, "%zu segments", ranges.NumSegments());
+      ranges.Update(200, 300, [](int& value) { value = 1; });
+      std::vector<size_t> expected = {0, 100, 0, 100, 400, 1, 400, AllocSize, 0};
+      CHECK_RESULT(segments(ranges, 0, AllocSize) != expected, "Neighbours weren't merged");
+      ranges.Update(0, AllocSize, [](int& value) { value = 0; });
+      CHECK_RESULT(ranges.NumSegments() != 1, "%zu segments after resetting the range",
+                   ranges.NumSegments());
+      break;
+    }
+    case 2: {
+      testDescString = "A prefetch to where the whole range already is gets dropped";
+      RangeMap<HmmRangeState> ranges(AllocSize);
+      size_t begin = 0;
+      size_t end = AllocSize;
+      CHECK_RESULT(!hip::HmmNarrowPrefetch(ranges, 0, &begin, &end),
+                   "Prefetch of an unknown range was dropped");
+      ranges.Update(0, AllocSize, [](HmmRangeState& state) { state.prefetchLocation_ = 0; });
+      begin = 128;
+      end = 256;
+      CHECK_RESULT(hip::HmmNarrowPrefetch(ranges, 0, &begin, &end),
+                   "Prefetch to the same device wasn't dropped");
+      CHECK_RESULT(!hip::HmmNarrowPrefetch(ranges, 1, &begin, &end) || begin != 128 ||
+                   end != 256, "Prefetch to another device was changed");
+      break;
+    }
+    case 3: {
+      testDescString = "A prefetch is narrowed to one span covering every gap";
+      RangeMap<HmmRangeState> ranges(AllocSize);
+      ranges.Update(0, AllocSize, [](HmmRangeState& state) { state.prefetchLocation_ = 0; });
+      // Two gaps, forgotten by copies into the allocation
+      for (size_t gap : {300, 600}) {
+        ranges.Update(gap, gap + 100, [](HmmRangeState& state) {
+          state.prefetchLocation_ = HmmRangeState::kUnknown;
+        });
+      }
+      size_t begin = 0;
+      size_t end = AllocSize;
+      CHECK_RESULT(!hip::HmmNarrowPrefetch(ranges, 0, &begin, &end), "Prefetch was dropped");
+      CHECK_RESULT(begin != 300 || end != 700, "Prefetch narrowed to [%zu, %zu)", begin, end);
+      begin = 350;
+      end = 650;
+      CHECK_RESULT(!hip::HmmNarrowPrefetch(ranges, 0, &begin, &end) || begin != 350 ||
+                   end != 650, "Prefetch inside the gaps narrowed to [%zu, %zu)", begin, end);
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitHmmRanges::close(void) { return HipUnitTest::close(); }
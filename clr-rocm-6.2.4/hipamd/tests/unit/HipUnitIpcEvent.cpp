@@ -0,0 +1,149 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+
+#include "HipUnitIpcEvent.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "hip_event_ipc.hpp"
+
+//! Block bound of the waiters, long enough that only a wakeup ends a wait in time
+static const uint64_t LongBlockNs = 10ull * 1000 * 1000 * 1000;
+//! Time the waiting process may take to observe a wakeup
+static const uint64_t WakeupBudgetNs = 2ull * 1000 * 1000 * 1000;
+
+/*! \brief The cross-process wait protocol of IPC events
+ *
+ *  The recording process clears a signal slot and bumps the completion futex of the shared
+ *  block, a waiting process blocks on the futex until its slot is cleared.
+ */
+HipUnitIpcEvent::HipUnitIpcEvent() : shmem_(nullptr) { _numSubTests = 3; }
+
+HipUnitIpcEvent::~HipUnitIpcEvent() {}
+
+void HipUnitIpcEvent::open(unsigned int test) {
+  HipUnitTest::open(test);
+  void* ptr = mmap(nullptr, sizeof(hip::ihipIpcEventShmem_t), PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  CHECK_RESULT(ptr == MAP_FAILED, "Can't map the shared block");
+  shmem_ = new (ptr) hip::ihipIpcEventShmem_t;
+  hip::ihipIpcEventShmemInit(shmem_);
+}
+
+/*! Forks a process, which waits for signal slot 0 with the given block bound, and returns its
+ *  pid. The process exits with 0 if the slot was cleared within the wakeup budget, 2 if it took
+ *  longer and 3 if the wait never blocked.
+ */
+static pid_t forkWaiter(hip::ihipIpcEventShmem_t* shmem, uint64_t maxBlockNs) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    const uint64_t start = amd::Os::timeNanos();
+    bool blocked = hip::ihipIpcEventWaitFor(shmem, 0, maxBlockNs,
+                                            [shmem]() { return shmem->signal[0] == 0; });
+    const uint64_t elapsed = amd::Os::timeNanos() - start;
+    _exit(!blocked ? 3 : (elapsed > WakeupBudgetNs) ? 2 : 0);
+  }
+  return pid;
+}
+
+//! Waits until the forked process blocks on the futex of the shared block
+static bool waitForBlockedWaiter(hip::ihipIpcEventShmem_t* shmem) {
+  for (int i = 0; i < 5000; ++i) {
+    if (shmem->waiters.load() != 0) {
+      return true;
+    }
+    amd::Os::sleep(1);
+  }
+  return false;
+}
+
+static int waiterStatus(pid_t pid) {
+  int status = 0;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+void HipUnitIpcEvent::run(void) {
+  if (_errorFlag) {
+    return;
+  }
+  switch (_openTest) {
+    case 0: {
+      testDescString = "A waiter in another process wakes up on the completion notify";
+      shmem_->signal[0] = 1;
+      pid_t pid = forkWaiter(shmem_, LongBlockNs);
+      CHECK_RESULT(pid < 0, "Can't fork the waiting process");
+      bool blocked = waitForBlockedWaiter(shmem_);
+      const uint32_t seq = shmem_->completion_seq.load();
+      shmem_->signal[0] = 0;
+      hip::ihipIpcEventNotify(shmem_);
+      int status = waiterStatus(pid);
+      CHECK_RESULT(!blocked, "Waiting process didn't block");
+      CHECK_RESULT(status != 0, "Waiting process exited with %d", status);
+      CHECK_RESULT(shmem_->completion_seq.load() != seq + 1, "Completion sequence wasn't bumped");
+      CHECK_RESULT(shmem_->waiters.load() != 0, "%u waiters left", shmem_->waiters.load());
+      break;
+    }
+    case 1: {
+      testDescString = "A waiter makes progress without a notify after its block bound";
+      shmem_->signal[0] = 1;
+      pid_t pid = forkWaiter(shmem_, 1000 * 1000);
+      CHECK_RESULT(pid < 0, "Can't fork the waiting process");
+      bool blocked = waitForBlockedWaiter(shmem_);
+      // The recorder exits before its completion callback runs
+      shmem_->signal[0] = 0;
+      int status = waiterStatus(pid);
+      CHECK_RESULT(!blocked, "Waiting process didn't block");
+      CHECK_RESULT(status != 0, "Waiting process exited with %d", status);
+      break;
+    }
+    case 2: {
+      testDescString = "Shared blocks of another layout are rejected";
+      CHECK_RESULT(!hip::ihipIpcEventShmemCompatible(shmem_), "Initialized block rejected");
+      hip::ihipIpcEventShmem_t other = {};
+      // The unversioned layout started with the owner count
+      const int owners = 2;
+      ::memcpy(static_cast<void*>(&other), &owners, sizeof(owners));
+      CHECK_RESULT(hip::ihipIpcEventShmemCompatible(&other), "Unversioned block accepted");
+      other.version = hip::kIpcEventShmemVersion;
+      other.size = sizeof(hip::ihipIpcEventShmem_t) - sizeof(uint32_t);
+      CHECK_RESULT(hip::ihipIpcEventShmemCompatible(&other), "Block of another size accepted");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitIpcEvent::close(void) {
+  if (shmem_ != nullptr) {
+    munmap(shmem_, sizeof(hip::ihipIpcEventShmem_t));
+    shmem_ = nullptr;
+  }
+  return HipUnitTest::close();
+}
@@ -0,0 +1,156 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipUnitKernArgCache.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "device/rocm/rockernargcache.hpp"
+
+/*! \brief A kernarg pool in chunks, which invalidates the cache like VirtualGPU
+ *
+ *  Moving to the next chunk may overwrite its blocks, as VirtualGPU::allocKernArg() does on a
+ *  rollover, and a reset reuses the pool from the start, as VirtualGPU::resetKernArgPool() does.
+ */
+struct MockKernArgPool {
+  static constexpr size_t kChunkSize = 256;
+  static constexpr size_t kChunks = 2;
+
+  explicit MockKernArgPool(size_t entries) : cache_(entries), pool_(kChunkSize * kChunks) {}
+
+  //! Returns the kernarg block of a launch, reused from the cache when possible
+  void* Launch(uint64_t kernel, const void* args, size_t size) {
+    uint64_t hash = 0;
+    void* block = cache_.Find(kernel, args, size, &hash);
+    if (block != nullptr) {
+      return block;
+    }
+    if (offset_ + size > kChunkSize) {
+      cache_.Invalidate();
+      chunk_ = (chunk_ + 1) % kChunks;
+      offset_ = 0;
+    }
+    block = &pool_[chunk_ * kChunkSize + offset_];
+    offset_ += size;
+    memcpy(block, args, size);
+    cache_.Insert(kernel, args, size, hash, block);
+    return block;
+  }
+
+  void Reset() {
+    cache_.Invalidate();
+    chunk_ = 0;
+    offset_ = 0;
+  }
+
+  amd::roc::KernArgCache cache_;
+  std::vector<uint8_t> pool_;
+  size_t chunk_ = 0;
+  size_t offset_ = 0;
+};
+
+/*! \brief The kernel argument cache of the ROCm virtual GPU
+ *
+ *  A launch reuses a block only for the same kernel and identical argument bytes, hash collisions
+ *  are rejected by the argument copy, and every point where blocks may be overwritten drops all
+ *  entries.
+ */
+HipUnitKernArgCache::HipUnitKernArgCache() { _numSubTests = 4; }
+
+HipUnitKernArgCache::~HipUnitKernArgCache() {}
+
+void HipUnitKernArgCache::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitKernArgCache::run(void) {
+  MockKernArgPool pool(16);
+  uint64_t args[4] = {1, 2, 3, 4};
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Only the same kernel with identical argument bytes hits";
+      void* block = pool.Launch(10, args, sizeof(args));
+      CHECK_RESULT(pool.Launch(10, args, sizeof(args)) != block, "Identical launch missed");
+      CHECK_RESULT(pool.Launch(11, args, sizeof(args)) == block, "Other kernel got the block");
+      CHECK_RESULT(pool.Launch(10, args, sizeof(args) - 8) == block,
+                   "Shorter arguments got the block");
+      args[3] = 5;
+      CHECK_RESULT(pool.Launch(10, args, sizeof(args)) == block, "Changed argument got the block");
+      break;
+    }
+    case 1: {
+      testDescString = "A hash collision is rejected by the argument comparison";
+      amd::roc::KernArgCache& cache = pool.cache_;
+      uint64_t other[4] = {9, 9, 9, 9};
+      uint64_t hash = 0;
+      CHECK_RESULT(cache.Find(10, args, sizeof(args), &hash) != nullptr, "Empty cache hit");
+      // Record different arguments under the hash of args, as if both hashed the same
+      cache.Insert(10, other, sizeof(other), hash, &pool.pool_[0]);
+      uint64_t probe = 0;
+      CHECK_RESULT(cache.Find(10, args, sizeof(args), &probe) != nullptr,
+                   "Colliding arguments returned the block of other arguments");
+      CHECK_RESULT(probe != hash, "The hash of the same arguments changed");
+      CHECK_RESULT(cache.Find(10, other, sizeof(other), &probe) != nullptr,
+                   "Block found under a hash its arguments don't have");
+      break;
+    }
+    case 2: {
+      testDescString = "Chunk rollover and pool reset drop every entry";
+      void* block = pool.Launch(10, args, sizeof(args));
+      uint64_t filler[8] = {};
+      for (uint64_t i = 0; pool.chunk_ == 0; ++i) {
+        filler[0] = i;
+        pool.Launch(20, filler, sizeof(filler));
+      }
+      CHECK_RESULT(pool.Launch(10, args, sizeof(args)) == block,
+                   "A block of the overwritten chunk was reused after the rollover");
+      pool.Launch(10, args, sizeof(args));
+      pool.Reset();
+      // The reset pool hands out the same address again, so check the cache didn't hit
+      const uint64_t hits = pool.cache_.Hits();
+      pool.Launch(10, args, sizeof(args));
+      CHECK_RESULT(pool.cache_.Hits() != hits, "A block was reused after the pool reset");
+      CHECK_RESULT(pool.cache_.Invalidations() != 2, "%llu invalidations instead of 2",
+                   static_cast<unsigned long long>(pool.cache_.Invalidations()));
+      break;
+    }
+    case 3: {
+      testDescString = "Hits, misses and invalidations are counted";
+      for (int i = 0; i < 3; ++i) {
+        pool.Launch(10, args, sizeof(args));
+      }
+      pool.Launch(11, args, sizeof(args));
+      pool.Reset();
+      pool.Launch(10, args, sizeof(args));
+      CHECK_RESULT(pool.cache_.Hits() != 2 || pool.cache_.Misses() != 3 ||
+                       pool.cache_.Invalidations() != 1,
+                   "%llu hits, %llu misses, %llu invalidations",
+                   static_cast<unsigned long long>(pool.cache_.Hits()),
+                   static_cast<unsigned long long>(pool.cache_.Misses()),
+                   static_cast<unsigned long long>(pool.cache_.Invalidations()));
+      amd::roc::KernArgCache disabled;
+      CHECK_RESULT(disabled.Enabled(), "A cache without slots is enabled");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitKernArgCache::close(void) { return HipUnitTest::close(); }
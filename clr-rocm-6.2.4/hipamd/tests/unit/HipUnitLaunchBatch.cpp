@@ -0,0 +1,125 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include "HipUnitLaunchBatch.h"
+
+#include <vector>
+
+#include "hip_launch_batch.hpp"
+
+/*! \brief The batch checks of hipExtLaunchKernelBatch() and its capture
+ *
+ *  The arguments of a batch are checked before the first kernel is launched, and a captured batch
+ *  adds its kernel nodes only once every entry is valid.
+ */
+HipUnitLaunchBatch::HipUnitLaunchBatch() { _numSubTests = 3; }
+
+HipUnitLaunchBatch::~HipUnitLaunchBatch() {}
+
+void HipUnitLaunchBatch::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitLaunchBatch::run(void) {
+  // The checks only compare the handles, they are never dereferenced
+  int function;
+  int stream;
+  hipStream_t hStream = reinterpret_cast<hipStream_t>(&stream);
+  std::vector<hipFunctionLaunchParams> batch(4);
+  for (auto& launch : batch) {
+    launch = hipFunctionLaunchParams{};
+    launch.function = reinterpret_cast<hipFunction_t>(&function);
+    launch.gridDimX = launch.gridDimY = launch.gridDimZ = 1;
+    launch.blockDimX = launch.blockDimY = launch.blockDimZ = 1;
+    launch.hStream = hStream;
+  }
+  const unsigned int numKernels = static_cast<unsigned int>(batch.size());
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Invalid batch arguments are rejected before any launch";
+      hipError_t status = hip::ValidateLaunchBatch(batch.data(), numKernels, hStream,
+                                                   hipExtAnyOrderLaunch);
+      CHECK_RESULT(status != hipSuccess, "A valid batch failed with %d", status);
+      status = hip::ValidateLaunchBatch(nullptr, 0, hStream, 0);
+      CHECK_RESULT(status != hipSuccess, "An empty batch failed with %d", status);
+      status = hip::ValidateLaunchBatch(nullptr, numKernels, hStream, 0);
+      CHECK_RESULT(status != hipErrorInvalidValue, "A null list returned %d", status);
+      status = hip::ValidateLaunchBatch(batch.data(), numKernels, hStream, 0x2);
+      CHECK_RESULT(status != hipErrorInvalidValue, "An unknown flag returned %d", status);
+      batch[2].hStream = nullptr;
+      status = hip::ValidateLaunchBatch(batch.data(), numKernels, hStream, 0);
+      CHECK_RESULT(status != hipErrorInvalidValue, "An entry on another stream returned %d",
+                   status);
+      batch[2].hStream = hStream;
+      batch[3].function = nullptr;
+      status = hip::ValidateLaunchBatch(batch.data(), numKernels, hStream, 0);
+      CHECK_RESULT(status != hipErrorInvalidResourceHandle, "A null function returned %d",
+                   status);
+      break;
+    }
+    case 1: {
+      testDescString = "An invalid entry of a captured batch adds no nodes";
+      for (unsigned int invalid = 0; invalid < numKernels; ++invalid) {
+        std::vector<unsigned int> nodes;
+        hipError_t status = hip::CaptureLaunchBatch(
+            numKernels,
+            [&](unsigned int i) {
+              return (i == invalid) ? hipErrorInvalidConfiguration : hipSuccess;
+            },
+            [&](unsigned int i) {
+              nodes.push_back(i);
+              return hipSuccess;
+            });
+        CHECK_RESULT(status != hipErrorInvalidConfiguration,
+                     "Entry %u invalid, the capture returned %d", invalid, status);
+        CHECK_RESULT(!nodes.empty(), "Entry %u invalid, %zu nodes were added", invalid,
+                     nodes.size());
+      }
+      break;
+    }
+    case 2: {
+      testDescString = "A valid captured batch adds its nodes in order";
+      std::vector<unsigned int> validated;
+      std::vector<unsigned int> nodes;
+      bool addedEarly = false;
+      hipError_t status = hip::CaptureLaunchBatch(
+          numKernels,
+          [&](unsigned int i) {
+            addedEarly |= !nodes.empty();
+            validated.push_back(i);
+            return hipSuccess;
+          },
+          [&](unsigned int i) {
+            nodes.push_back(i);
+            return hipSuccess;
+          });
+      CHECK_RESULT(status != hipSuccess, "The capture failed with %d", status);
+      CHECK_RESULT(validated.size() != numKernels, "%zu entries validated", validated.size());
+      CHECK_RESULT(addedEarly, "A node was added before all entries were validated");
+      CHECK_RESULT(nodes.size() != numKernels, "%zu nodes added", nodes.size());
+      for (unsigned int i = 0; i < numKernels; ++i) {
+        CHECK_RESULT(nodes[i] != i, "Node %u is entry %u", i, nodes[i]);
+      }
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitLaunchBatch::close(void) { return HipUnitTest::close(); }
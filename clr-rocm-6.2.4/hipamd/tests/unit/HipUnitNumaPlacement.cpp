@@ -0,0 +1,134 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+
+#include "HipUnitNumaPlacement.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "os/numa.hpp"
+
+/*! \brief A host with a fixed NUMA layout
+ *
+ *  Node n owns the CPUs [n * CpusPerNode, (n + 1) * CpusPerNode), the process may only run on
+ *  the CPUs in allowed.
+ */
+class FakeNumaTopology : public amd::NumaTopology {
+ public:
+  static const uint CpusPerNode = 4;
+
+  FakeNumaTopology(uint32_t numNodes, const std::vector<uint>& allowed)
+      : numNodes_(numNodes), allowed_(allowed) {}
+
+  uint32_t numNodes() const { return numNodes_; }
+
+  bool nodeCpus(uint32_t node, amd::Os::ThreadAffinityMask* mask) const {
+    if (node >= numNodes_) {
+      return false;
+    }
+    mask->init();
+    for (uint cpu = node * CpusPerNode; cpu < (node + 1) * CpusPerNode; ++cpu) {
+      mask->set(cpu);
+    }
+    return true;
+  }
+
+  bool allowedCpus(amd::Os::ThreadAffinityMask* mask) const {
+    mask->init();
+    for (uint cpu : allowed_) {
+      mask->set(cpu);
+    }
+    return true;
+  }
+
+ private:
+  uint32_t numNodes_;
+  std::vector<uint> allowed_;
+};
+
+/*! \brief The NUMA placement policy of the device host resources and threads
+ *
+ *  ROC_NUMA_NODE_MAP names nodes by the rocclr device index, thread masks are limited to the
+ *  CPUs the process may use.
+ */
+HipUnitNumaPlacement::HipUnitNumaPlacement() { _numSubTests = 4; }
+
+HipUnitNumaPlacement::~HipUnitNumaPlacement() {}
+
+void HipUnitNumaPlacement::open(unsigned int test) { HipUnitTest::open(test); }
+
+void HipUnitNumaPlacement::run(void) {
+  FakeNumaTopology topology(4, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15});
+
+  switch (_openTest) {
+    case 0: {
+      testDescString = "Without an override every device uses its nearest node";
+      for (uint32_t ordinal = 0; ordinal < 4; ++ordinal) {
+        uint32_t node = amd::NumaPlacement::resolveNode(topology, ordinal, 3 - ordinal, "");
+        CHECK_RESULT(node != 3 - ordinal, "Device %u placed on node %u", ordinal, node);
+      }
+      CHECK_RESULT(amd::NumaPlacement::resolveNode(topology, 0, 2, nullptr) != 2,
+                   "Missing override changed the node");
+      break;
+    }
+    case 1: {
+      testDescString = "A single node applies to every device";
+      for (uint32_t ordinal = 0; ordinal < 4; ++ordinal) {
+        uint32_t node = amd::NumaPlacement::resolveNode(topology, ordinal, 0, "2");
+        CHECK_RESULT(node != 2, "Device %u placed on node %u", ordinal, node);
+      }
+      break;
+    }
+    case 2: {
+      testDescString = "Index pairs map devices, bad entries keep the nearest node";
+      // Two registered rocclr devices have the indices 0 and 1
+      const char* nodeMap = "0:3,1:1,2:9,x:0";
+      CHECK_RESULT(amd::NumaPlacement::resolveNode(topology, 0, 0, nodeMap) != 3,
+                   "Device 0 not placed on node 3");
+      CHECK_RESULT(amd::NumaPlacement::resolveNode(topology, 1, 0, nodeMap) != 1,
+                   "Device 1 not placed on node 1");
+      CHECK_RESULT(amd::NumaPlacement::resolveNode(topology, 2, 0, nodeMap) != 0,
+                   "Node past the topology was used");
+      CHECK_RESULT(amd::NumaPlacement::resolveNode(topology, 3, 2, nodeMap) != 2,
+                   "Unlisted device left its nearest node");
+      break;
+    }
+    case 3: {
+      testDescString = "Thread masks are limited to the CPUs the process may use";
+      FakeNumaTopology restricted(4, {1, 2, 9});
+      amd::Os::ThreadAffinityMask mask;
+      CHECK_RESULT(!amd::NumaPlacement::threadMask(restricted, 0, &mask),
+                   "No mask for node 0");
+      CHECK_RESULT(mask.countSet() != 2 || !mask.isSet(1) || !mask.isSet(2),
+                   "Node 0 mask has %u CPUs", mask.countSet());
+      CHECK_RESULT(!amd::NumaPlacement::threadMask(restricted, 2, &mask) ||
+                   mask.countSet() != 1 || !mask.isSet(9), "Node 2 mask isn't CPU 9 alone");
+      CHECK_RESULT(amd::NumaPlacement::threadMask(restricted, 1, &mask),
+                   "Mask for node 1, which has no allowed CPUs");
+      CHECK_RESULT(amd::NumaPlacement::threadMask(restricted, 4, &mask),
+                   "Mask for a node past the topology");
+      break;
+    }
+  }
+}
+
+unsigned int HipUnitNumaPlacement::close(void) { return HipUnitTest::close(); }
@@ -0,0 +1,80 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#ifndef _HIP_UNIT_TEST_H_
+#define _HIP_UNIT_TEST_H_
+
+#include <cstdio>
+#include <string>
+
+#define CHECK_RESULT(test, msg, ...)                             \
+  if ((test)) {                                                  \
+    char buf[4096];                                              \
+    snprintf(buf, sizeof(buf), msg, ##__VA_ARGS__);              \
+    printf("%s:%d - %s\n", __FILE__, __LINE__, buf);             \
+    _errorFlag = true;                                           \
+    _errorMsg = buf;                                             \
+    return;                                                      \
+  }
+
+/*! \brief A host unit test with a number of subtests, modeled after the ocltst runtime modules
+ *
+ *  The driver calls open(), run() and close() for every subtest. The tests need no GPU, they
+ *  exercise runtime logic against mock queues, signals and topologies.
+ */
+class HipUnitTest {
+ public:
+  HipUnitTest() : _numSubTests(1), _openTest(0), _errorFlag(false) {}
+  virtual ~HipUnitTest() {}
+
+  unsigned int getNumSubTests() const { return _numSubTests; }
+
+  virtual void open(unsigned int test) {
+    _openTest = test;
+    _errorFlag = false;
+    _errorMsg.clear();
+    testDescString.clear();
+  }
+  virtual void run(void) = 0;
+  virtual unsigned int close(void) { return _errorFlag ? 1 : 0; }
+
+  bool hasErrorOccured() const { return _errorFlag; }
+  const std::string& getErrorMsg() const { return _errorMsg; }
+
+  std::string testDescString;
+
+ protected:
+  unsigned int _numSubTests;
+  unsigned int _openTest;
+  bool _errorFlag;
+  std::string _errorMsg;
+};
+
+//! An entry of the test list
+struct TestEntry {
+  const char* name;
+  HipUnitTest* (*create)(void);
+};
+
+extern TestEntry TestList[];
+extern unsigned int TestListCount;
+
+#endif  // _HIP_UNIT_TEST_H_
@@ -0,0 +1,98 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+
+#include "HipUnitTest.h"
+
+static void usage(const char* program) {
+  printf(
+      "Usage: %s [options]\n"
+      "  -t <test>       Run only this test, may be repeated\n"
+      "  -s <subtest>    Run only this subtest\n"
+      "  -l              List the tests\n",
+      program);
+}
+
+int main(int argc, char** argv) {
+  std::set<std::string> tests;
+  int subtest = -1;
+
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (strcmp(arg, "-l") == 0) {
+      for (unsigned int t = 0; t < TestListCount; ++t) {
+        printf("%s\n", TestList[t].name);
+      }
+      return 0;
+    }
+    if ((arg[0] != '-') || (arg[1] == '\0') || (arg[2] != '\0') || (value == nullptr)) {
+      usage(argv[0]);
+      return 1;
+    }
+    switch (arg[1]) {
+      case 't':
+        tests.insert(value);
+        break;
+      case 's':
+        subtest = atoi(value);
+        break;
+      default:
+        usage(argv[0]);
+        return 1;
+    }
+    ++i;
+  }
+
+  unsigned int failures = 0;
+  unsigned int passes = 0;
+  for (unsigned int t = 0; t < TestListCount; ++t) {
+    const char* name = TestList[t].name;
+    if (!tests.empty() && (tests.count(name) == 0)) {
+      continue;
+    }
+    HipUnitTest* test = TestList[t].create();
+    for (unsigned int s = 0; s < test->getNumSubTests(); ++s) {
+      if ((subtest >= 0) && (static_cast<unsigned int>(subtest) != s)) {
+        continue;
+      }
+      test->open(s);
+      test->run();
+      if (test->close() != 0) {
+        printf("%-24s %3u: %-72s FAILED %s\n", name, s, test->testDescString.c_str(),
+               test->getErrorMsg().c_str());
+        failures++;
+      } else {
+        printf("%-24s %3u: %-72s PASSED\n", name, s, test->testDescString.c_str());
+        passes++;
+      }
+    }
+    delete test;
+  }
+
+  printf("%u passed, %u failed\n", passes, failures);
+  return (failures != 0) ? 1 : 0;
+}
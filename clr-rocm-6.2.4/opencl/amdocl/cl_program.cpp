@@ -25,6 +25,7 @@
 #include "platform/kernel.hpp"
 #include "platform/sampler.hpp"
 #include "cl_semaphore_amd.h"
+#include "cl_program_info_amd.h"
 
 #include <vector>
 
@@ -1154,6 +1155,10 @@ RUNTIME_ENTRY(cl_int, clGetProgramBuildInfo,
       size_t size = devProgram->globalVariableTotalSize();
       return amd::clGetInfo(size, param_value_size, param_value, param_value_size_ret);
     }
+    case CL_PROGRAM_BUILD_TIME_AMD: {
+      cl_ulong buildTime = devProgram->buildTime();
+      return amd::clGetInfo(buildTime, param_value_size, param_value, param_value_size_ret);
+    }
     default:
       break;
   }
@@ -0,0 +1,43 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef __CL_PROGRAM_INFO_AMD_H
+#define __CL_PROGRAM_INFO_AMD_H
+/*******************************************
+ * AMD Extension cl_amd_program_build_time
+ *******************************************/
+#define cl_amd_program_build_time 1
+
+#if cl_amd_program_build_time
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* cl_program_build_info, cl_ulong duration of the last build in nanoseconds */
+#define CL_PROGRAM_BUILD_TIME_AMD 0xF060
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* cl_amd_program_build_time */
+
+#endif /* __CL_PROGRAM_INFO_AMD_H */
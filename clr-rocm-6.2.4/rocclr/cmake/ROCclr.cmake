@@ -74,9 +74,11 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/device/device.cpp
   ${ROCCLR_SRC_DIR}/device/devkernel.cpp
   ${ROCCLR_SRC_DIR}/device/devprogram.cpp
+  ${ROCCLR_SRC_DIR}/device/devprogramcache.cpp
   ${ROCCLR_SRC_DIR}/device/hsailctx.cpp
   ${ROCCLR_SRC_DIR}/elf/elf.cpp
   ${ROCCLR_SRC_DIR}/os/alloc.cpp
+  ${ROCCLR_SRC_DIR}/os/numa.cpp
   ${ROCCLR_SRC_DIR}/os/os_posix.cpp
   ${ROCCLR_SRC_DIR}/os/os_win32.cpp
   ${ROCCLR_SRC_DIR}/os/os.cpp
@@ -94,6 +96,7 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/thread/monitor.cpp
   ${ROCCLR_SRC_DIR}/thread/semaphore.cpp
   ${ROCCLR_SRC_DIR}/thread/thread.cpp
+  ${ROCCLR_SRC_DIR}/thread/threadpool.cpp
   ${ROCCLR_SRC_DIR}/utils/debug.cpp
   ${ROCCLR_SRC_DIR}/utils/flags.cpp)
 
@@ -60,19 +60,10 @@ bool HostBlitManager::readBufferRect(device::Memory& srcMemory, void* dstHost,
     return false;
   }
 
-  size_t srcOffset;
-  size_t dstOffset;
-
-  for (size_t z = 0; z < size[2]; ++z) {
-    for (size_t y = 0; y < size[1]; ++y) {
-      srcOffset = bufRect.offset(0, y, z);
-      dstOffset = hostRect.offset(0, y, z);
-
-      // Copy memory line by line
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dstHost) + dstOffset),
-                          (reinterpret_cast<const_address>(src) + srcOffset), size[0]);
-    }
-  }
+  // Copy the rows, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dstHost) + hostRect.start_, hostRect.rowPitch_,
+                        hostRect.slicePitch_, reinterpret_cast<const_address>(src) + bufRect.start_,
+                        bufRect.rowPitch_, bufRect.slicePitch_, size[0], size[1], size[2]);
 
   // Unmap source memory
   srcMemory.cpuUnmap(vDev_);
@@ -106,8 +97,6 @@ bool HostBlitManager::readImage(device::Memory& srcMemory, void* dstHost,
   size_t elementSize = srcMemory.owner()->asImage()->getImageFormat().getElementSize();
   size_t srcOffsBase = origin[0] * elementSize;
   size_t copySize = size[0] * elementSize;
-  size_t srcOffs;
-  size_t dstOffs = 0;
 
   // Make sure we use the right pitch if it's not specified
   if (rowPitch == 0) {
@@ -125,21 +114,10 @@ bool HostBlitManager::readImage(device::Memory& srcMemory, void* dstHost,
   // Adjust the destination offset with Z dimension
   srcOffsBase += srcSlicePitch * origin[2];
 
-  // Copy memory line by line
-  for (size_t slice = 0; slice < size[2]; ++slice) {
-    srcOffs = srcOffsBase + slice * srcSlicePitch;
-    dstOffs = slice * slicePitch;
-
-    // Copy memory line by line
-    for (size_t row = 0; row < size[1]; ++row) {
-      // Copy memory
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dstHost) + dstOffs),
-                          (reinterpret_cast<const_address>(src) + srcOffs), copySize);
-
-      srcOffs += srcRowPitch;
-      dstOffs += rowPitch;
-    }
-  }
+  // Copy memory line by line, contiguous rows are merged
+  amd::Os::fastMemcpy3D(dstHost, rowPitch, slicePitch,
+                        reinterpret_cast<const_address>(src) + srcOffsBase, srcRowPitch,
+                        srcSlicePitch, copySize, size[1], size[2]);
 
   // Unmap the device memory
   srcMemory.cpuUnmap(vDev_);
@@ -182,19 +160,11 @@ bool HostBlitManager::writeBufferRect(const void* srcHost, device::Memory& dstMe
     return false;
   }
 
-  size_t srcOffset;
-  size_t dstOffset;
-
-  for (size_t z = 0; z < size[2]; ++z) {
-    for (size_t y = 0; y < size[1]; ++y) {
-      srcOffset = hostRect.offset(0, y, z);
-      dstOffset = bufRect.offset(0, y, z);
-
-      // Copy memory line by line
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dst) + dstOffset),
-                          (reinterpret_cast<const_address>(srcHost) + srcOffset), size[0]);
-    }
-  }
+  // Copy the rows, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dst) + bufRect.start_, bufRect.rowPitch_,
+                        bufRect.slicePitch_,
+                        reinterpret_cast<const_address>(srcHost) + hostRect.start_,
+                        hostRect.rowPitch_, hostRect.slicePitch_, size[0], size[1], size[2]);
 
   // Unmap destination memory
   dstMemory.cpuUnmap(vDev_);
@@ -229,10 +199,8 @@ bool HostBlitManager::writeImage(const void* srcHost, device::Memory& dstMemory,
   }
 
   size_t elementSize = dstMemory.owner()->asImage()->getImageFormat().getElementSize();
-  size_t srcOffs = 0;
   size_t copySize = size[0] * elementSize;
   size_t dstOffsBase = origin[0] * elementSize;
-  size_t dstOffs;
 
   // Make sure we use the right pitch if it's not specified
   if (rowPitch == 0) {
@@ -250,21 +218,9 @@ bool HostBlitManager::writeImage(const void* srcHost, device::Memory& dstMemory,
   // Adjust the destination offset with Z dimension
   dstOffsBase += dstSlicePitch * origin[2];
 
-  // Copy memory slice by slice
-  for (size_t slice = 0; slice < size[2]; ++slice) {
-    dstOffs = dstOffsBase + slice * dstSlicePitch;
-    srcOffs = slice * slicePitch;
-
-    // Copy memory line by line
-    for (size_t row = 0; row < size[1]; ++row) {
-      // Copy memory
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dst) + dstOffs),
-                          (reinterpret_cast<const_address>(srcHost) + srcOffs), copySize);
-
-      dstOffs += dstRowPitch;
-      srcOffs += rowPitch;
-    }
-  }
+  // Copy memory line by line, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dst) + dstOffsBase, dstRowPitch, dstSlicePitch,
+                        srcHost, rowPitch, slicePitch, copySize, size[1], size[2]);
 
   // Unmap the device memory
   dstMemory.cpuUnmap(vDev_);
@@ -323,16 +279,10 @@ bool HostBlitManager::copyBufferRect(device::Memory& srcMemory, device::Memory&
     return false;
   }
 
-  for (size_t z = 0; z < size[2]; ++z) {
-    for (size_t y = 0; y < size[1]; ++y) {
-      size_t srcOffset = srcRect.offset(0, y, z);
-      size_t dstOffset = dstRect.offset(0, y, z);
-
-      // Copy memory line by line
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dst) + dstOffset),
-                          (reinterpret_cast<const_address>(src) + srcOffset), size[0]);
-    }
-  }
+  // Copy the rows, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dst) + dstRect.start_, dstRect.rowPitch_,
+                        dstRect.slicePitch_, reinterpret_cast<const_address>(src) + srcRect.start_,
+                        srcRect.rowPitch_, srcRect.slicePitch_, size[0], size[1], size[2]);
 
   // Unmap source and destination memory
   dstMemory.cpuUnmap(vDev_);
@@ -373,7 +323,6 @@ bool HostBlitManager::copyImageToBuffer(device::Memory& srcMemory, device::Memor
 
   size_t srcOffs = srcOrigin[0];
   size_t dstOffs = dstOrigin[0];
-  size_t srcOffsOrg;
   size_t copySize = size[0];
 
   // Calculate the offset in bytes
@@ -384,21 +333,10 @@ bool HostBlitManager::copyImageToBuffer(device::Memory& srcMemory, device::Memor
   srcOffs += srcRowPitch * srcOrigin[1];
   srcOffs += srcSlicePitch * srcOrigin[2];
 
-  srcOffsOrg = srcOffs;
-
-  // Copy memory slice by slice
-  for (size_t slice = 0; slice < size[2]; ++slice) {
-    srcOffs = srcOffsOrg + slice * srcSlicePitch;
-
-    // Copy memory line by line
-    for (size_t rows = 0; rows < size[1]; ++rows) {
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dst) + dstOffs),
-                          (reinterpret_cast<const_address>(src) + srcOffs), copySize);
-
-      srcOffs += srcRowPitch;
-      dstOffs += copySize;
-    }
-  }
+  // Copy memory line by line into the packed buffer, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dst) + dstOffs, copySize, copySize * size[1],
+                        reinterpret_cast<const_address>(src) + srcOffs, srcRowPitch,
+                        srcSlicePitch, copySize, size[1], size[2]);
 
   // Unmap source and destination memory
   srcMemory.cpuUnmap(vDev_);
@@ -439,7 +377,6 @@ bool HostBlitManager::copyBufferToImage(device::Memory& srcMemory, device::Memor
   size_t elementSize = dstMemory.owner()->asImage()->getImageFormat().getElementSize();
   size_t srcOffs = srcOrigin[0];
   size_t dstOffs = dstOrigin[0];
-  size_t dstOffsOrg;
   size_t copySize = size[0];
 
   // Calculate the offset in bytes
@@ -450,21 +387,10 @@ bool HostBlitManager::copyBufferToImage(device::Memory& srcMemory, device::Memor
   dstOffs += dstRowPitch * dstOrigin[1];
   dstOffs += dstSlicePitch * dstOrigin[2];
 
-  dstOffsOrg = dstOffs;
-
-  // Copy memory slice by slice
-  for (size_t slice = 0; slice < size[2]; ++slice) {
-    dstOffs = dstOffsOrg + slice * dstSlicePitch;
-
-    // Copy memory line by line
-    for (size_t rows = 0; rows < size[1]; ++rows) {
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dst) + dstOffs),
-                          (reinterpret_cast<const_address>(src) + srcOffs), copySize);
-
-      srcOffs += copySize;
-      dstOffs += dstRowPitch;
-    }
-  }
+  // Copy memory line by line from the packed buffer, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dst) + dstOffs, dstRowPitch, dstSlicePitch,
+                        reinterpret_cast<const_address>(src) + srcOffs, copySize,
+                        copySize * size[1], copySize, size[1], size[2]);
 
   // Unmap source and destination memory
   srcMemory.cpuUnmap(vDev_);
@@ -517,8 +443,6 @@ bool HostBlitManager::copyImage(device::Memory& srcMemory, device::Memory& dstMe
 
   size_t srcOffs = srcOrigin[0];
   size_t dstOffs = dstOrigin[0];
-  size_t srcOffsOrg;
-  size_t dstOffsOrg;
   size_t copySize = size[0];
 
   // Calculate the offsets in bytes
@@ -534,23 +458,10 @@ bool HostBlitManager::copyImage(device::Memory& srcMemory, device::Memory& dstMe
   srcOffs += srcSlicePitch * srcOrigin[2];
   dstOffs += dstSlicePitch * dstOrigin[2];
 
-  srcOffsOrg = srcOffs;
-  dstOffsOrg = dstOffs;
-
-  // Copy memory slice by slice
-  for (size_t slice = 0; slice < size[2]; ++slice) {
-    srcOffs = srcOffsOrg + slice * srcSlicePitch;
-    dstOffs = dstOffsOrg + slice * dstSlicePitch;
-
-    // Copy memory line by line
-    for (size_t rows = 0; rows < size[1]; ++rows) {
-      amd::Os::fastMemcpy((reinterpret_cast<address>(dst) + dstOffs),
-                          (reinterpret_cast<const_address>(src) + srcOffs), copySize);
-
-      srcOffs += srcRowPitch;
-      dstOffs += dstRowPitch;
-    }
-  }
+  // Copy memory line by line, contiguous rows are merged
+  amd::Os::fastMemcpy3D(reinterpret_cast<address>(dst) + dstOffs, dstRowPitch, dstSlicePitch,
+                        reinterpret_cast<const_address>(src) + srcOffs, srcRowPitch,
+                        srcSlicePitch, copySize, size[1], size[2]);
 
   // Unmap source and destination memory
   srcMemory.cpuUnmap(vDev_);
@@ -577,11 +488,8 @@ bool HostBlitManager::fillBuffer(device::Memory& memory, const void* pattern, si
   }
 
   // Fill the buffer memory with a pattern
-  for (size_t i = 0; i < (fillSize / patternSize); i++) {
-    memcpy((reinterpret_cast<address>(fillMem) + offset),
-           (reinterpret_cast<const_address>(pattern)), patternSize);
-    offset += patternSize;
-  }
+  amd::Os::fastMemFill(reinterpret_cast<address>(fillMem) + offset, pattern, patternSize,
+                       fillSize / patternSize);
 
   // Unmap source and destination memory
   memory.cpuUnmap(vDev_);
@@ -640,20 +548,21 @@ bool HostBlitManager::fillImage(device::Memory& memory, const void* pattern,
 
   offsetOrg = offset;
 
+  // Fill whole slices at once, if the rows are contiguous
+  size_t rowPixels = size[0];
+  size_t rows = size[1];
+  if (devRowPitch == size[0] * elementSize) {
+    rowPixels *= rows;
+    rows = 1;
+  }
+
   // Fill the image memory with a pattern
   for (size_t slice = 0; slice < size[2]; ++slice) {
     offset = offsetOrg + slice * devSlicePitch;
 
-    for (size_t rows = 0; rows < size[1]; ++rows) {
-      size_t pixOffset = offset;
-
-      // Copy memory pixel by pixel
-      for (size_t column = 0; column < size[0]; ++column) {
-        memcpy((reinterpret_cast<address>(fillMem) + pixOffset),
-               (reinterpret_cast<const_address>(fillValue)), elementSize);
-        pixOffset += elementSize;
-      }
-
+    for (size_t row = 0; row < rows; ++row) {
+      amd::Os::fastMemFill(reinterpret_cast<address>(fillMem) + offset, fillValue, elementSize,
+                           rowPixels);
       offset += devRowPitch;
     }
   }
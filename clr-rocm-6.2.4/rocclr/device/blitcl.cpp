@@ -175,6 +175,27 @@ const char* HipExtraSourceCode = BLIT_KERNELS(
     __amd_streamOpsWait(ptrInt, ptrUlong, value, flags, mask);
   }
 
+  __kernel void __amd_rocclr_streamOpsBatch(ulong8 ptrs, ulong8 values, ulong8 masks,
+                                            uint8 flags, uint count) {
+    ulong ptr[8];
+    ulong value[8];
+    ulong mask[8];
+    uint flag[8];
+    vstore8(ptrs, 0, ptr);
+    vstore8(values, 0, value);
+    vstore8(masks, 0, mask);
+    vstore8(flags, 0, flag);
+    for (uint i = 0; i < count; ++i) {
+      __global uint* ptrInt = (flag[i] & 0x1) ? 0 : (__global uint*)ptr[i];
+      __global ulong* ptrUlong = (flag[i] & 0x1) ? (__global ulong*)ptr[i] : 0;
+      if (flag[i] & 0x2) {
+        __amd_streamOpsWait(ptrInt, ptrUlong, value[i], flag[i] >> 4, mask[i]);
+      } else {
+        __amd_streamOpsWrite(ptrInt, ptrUlong, value[i]);
+      }
+    }
+  }
+
   __kernel void __amd_rocclr_initHeap(ulong heap_to_initialize, ulong initial_blocks,
                                       uint heap_size, uint number_of_initial_blocks) {
     __ockl_dm_init_v1(heap_to_initialize, initial_blocks, heap_size, number_of_initial_blocks);
@@ -196,6 +217,27 @@ const char* HipExtraSourceCodeNoGWS = BLIT_KERNELS(
     __amd_streamOpsWait(ptrInt, ptrUlong, value, flags, mask);
   }
 
+  __kernel void __amd_rocclr_streamOpsBatch(ulong8 ptrs, ulong8 values, ulong8 masks,
+                                            uint8 flags, uint count) {
+    ulong ptr[8];
+    ulong value[8];
+    ulong mask[8];
+    uint flag[8];
+    vstore8(ptrs, 0, ptr);
+    vstore8(values, 0, value);
+    vstore8(masks, 0, mask);
+    vstore8(flags, 0, flag);
+    for (uint i = 0; i < count; ++i) {
+      __global uint* ptrInt = (flag[i] & 0x1) ? 0 : (__global uint*)ptr[i];
+      __global ulong* ptrUlong = (flag[i] & 0x1) ? (__global ulong*)ptr[i] : 0;
+      if (flag[i] & 0x2) {
+        __amd_streamOpsWait(ptrInt, ptrUlong, value[i], flag[i] >> 4, mask[i]);
+      } else {
+        __amd_streamOpsWrite(ptrInt, ptrUlong, value[i]);
+      }
+    }
+  }
+
   __kernel void __amd_rocclr_initHeap(ulong heap_to_initialize, ulong initial_blocks,
                                       uint heap_size, uint number_of_initial_blocks) {
     __ockl_dm_init_v1(heap_to_initialize, initial_blocks, heap_size, number_of_initial_blocks);
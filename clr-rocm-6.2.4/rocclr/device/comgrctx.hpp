@@ -159,6 +159,10 @@ public:
   static void get_version(size_t *major, size_t *minor) {
     COMGR_DYN(amd_comgr_get_version)(major, minor);
   }
+  //! Returns an address inside the loaded COMGR library, to identify the library file
+  static const void* library_address() {
+    return reinterpret_cast<const void*>(COMGR_DYN(amd_comgr_get_version));
+  }
   static amd_comgr_status_t status_string(amd_comgr_status_t status, const char ** status_string) {
     return COMGR_DYN(amd_comgr_status_string)(status, status_string);
   }
@@ -27,6 +27,7 @@
 #include "device/devsignal.hpp"
 
 #include "os/os.hpp"
+#include "os/numa.hpp"
 #include "thread/monitor.hpp"
 #include "utils/util.hpp"
 #include "utils/debug.hpp"
@@ -389,6 +390,8 @@ bool HostcallListener::initSignal(const amd::Device &dev) {
 #endif
     return false;
   }
+  // One listener serves all devices, keep it next to the device that created it
+  amd::NumaPlacement::bindThread(thread_, dev.getPreferredNumaNode());
   thread_.start(this);
   return true;
 }
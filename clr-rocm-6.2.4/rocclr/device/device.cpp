@@ -299,83 +299,148 @@ Context* Device::glb_ctx_ = nullptr;
 Monitor Device::p2p_stage_ops_("P2P Staging Lock", true);
 Memory* Device::p2p_stage_ = nullptr;
 
-Monitor MemObjMap::AllocatedLock_ ROCCLR_INIT_PRIORITY(101) ("Guards MemObjMap allocation list");
-std::map<uintptr_t, amd::Memory*> MemObjMap::MemObjMap_ ROCCLR_INIT_PRIORITY(101);
-std::map<uintptr_t, amd::Memory*> MemObjMap::VirtualMemObjMap_ ROCCLR_INIT_PRIORITY(101);
+ConcurrentRangeMap<MemObjMap::Entry> MemObjMap::MemObjMap_ ROCCLR_INIT_PRIORITY(101);
+ConcurrentRangeMap<amd::Memory*> MemObjMap::VirtualMemObjMap_ ROCCLR_INIT_PRIORITY(101);
+std::atomic<size_t> MemObjMap::MemObjCount_(0);
 
 size_t MemObjMap::size() {
-  amd::ScopedLock lock(AllocatedLock_);
-  return MemObjMap_.size();
+  return MemObjCount_.load(std::memory_order_relaxed);
+}
+
+MemObjMap::Entry& MemObjMap::GetEntry(std::map<uintptr_t, Entry>& map, uintptr_t start) {
+  auto it = map.lower_bound(start);
+  if ((it != map.end()) && (it->first == start)) {
+    return it->second;
+  }
+  Entry entry;
+  if (it != map.begin()) {
+    const Entry& prev = std::prev(it)->second;
+    entry.svmCover_ = (start < prev.svmCover_) ? prev.svmCover_ : 0;
+  }
+  return map.emplace_hint(it, start, entry)->second;
 }
 
 void MemObjMap::AddMemObj(const void* k, amd::Memory* v) {
-  amd::ScopedLock lock(AllocatedLock_);
-  auto rval = MemObjMap_.insert({ reinterpret_cast<uintptr_t>(k), v });
-  if (!rval.second) {
+  uintptr_t start = reinterpret_cast<uintptr_t>(k);
+  bool added = MemObjMap_.modify([&](auto& map) {
+    Entry& entry = GetEntry(map, start);
+    if (entry.memObj_ != nullptr) {
+      return false;
+    }
+    entry.memObj_ = v;
+    return true;
+  });
+  if (added) {
+    MemObjCount_.fetch_add(1, std::memory_order_relaxed);
+  } else {
     DevLogPrintfError("Memobj map already has an entry for ptr: 0x%x",
                       reinterpret_cast<uintptr_t>(k));
   }
 }
 
 void MemObjMap::RemoveMemObj(const void* k) {
-  amd::ScopedLock lock(AllocatedLock_);
-  auto rval = MemObjMap_.erase(reinterpret_cast<uintptr_t>(k));
-  guarantee(rval == 1, "Memobj map does not have ptr: 0x%x",
-                        reinterpret_cast<uintptr_t>(k));
+  uintptr_t start = reinterpret_cast<uintptr_t>(k);
+  bool removed = MemObjMap_.modify([&](auto& map) {
+    auto it = map.find(start);
+    if ((it == map.end()) || (it->second.memObj_ == nullptr)) {
+      return false;
+    }
+    it->second.memObj_ = nullptr;
+    if (it->second.svmEnd_ == 0) {
+      map.erase(it);
+    }
+    return true;
+  });
+  guarantee(removed, "Memobj map does not have ptr: 0x%x",
+                     reinterpret_cast<uintptr_t>(k));
+  MemObjCount_.fetch_sub(1, std::memory_order_relaxed);
 }
 
 amd::Memory* MemObjMap::FindMemObj(const void* k, size_t* offset) {
-  amd::ScopedLock lock(AllocatedLock_);
   uintptr_t key = reinterpret_cast<uintptr_t>(k);
-  auto it = MemObjMap_.upper_bound(key);
-  if (it == MemObjMap_.begin()) {
+  return MemObjMap_.read([&](const auto& map) -> amd::Memory* {
+    auto it = map.upper_bound(key);
+    // Skip the SVM ranges without an object, the closest object decides
+    while (it != map.begin()) {
+      --it;
+      amd::Memory* mem = it->second.memObj_;
+      if (mem == nullptr) {
+        continue;
+      }
+      if (key < (it->first + mem->getSize())) {
+        if (offset != nullptr) {
+          *offset = key - it->first;
+        }
+        // the k is in the range
+        return mem;
+      }
+      break;
+    }
     return nullptr;
-  }
+  });
+}
 
-  --it;
-  amd::Memory* mem = it->second;
-  if (key >= it->first && key < (it->first + mem->getSize())) {
-    if (offset != nullptr) {
-      *offset = key - it->first;
+void MemObjMap::AddSvmRange(const void* k, size_t size) {
+  uintptr_t start = reinterpret_cast<uintptr_t>(k);
+  uintptr_t end = start + size;
+  MemObjMap_.modify([&](auto& map) {
+    GetEntry(map, start).svmEnd_ = end;
+    for (auto it = map.lower_bound(start); (it != map.end()) && (it->first < end); ++it) {
+      it->second.svmCover_ = end;
     }
-    // the k is in the range
-    return mem;
-  } else {
-    return nullptr;
-  }
+  });
 }
+
+void MemObjMap::RemoveSvmRange(const void* k) {
+  uintptr_t start = reinterpret_cast<uintptr_t>(k);
+  MemObjMap_.modify([&](auto& map) {
+    auto it = map.find(start);
+    if ((it == map.end()) || (it->second.svmEnd_ == 0)) {
+      return;
+    }
+    uintptr_t end = it->second.svmEnd_;
+    it->second.svmEnd_ = 0;
+    for (auto cover = it; (cover != map.end()) && (cover->first < end); ++cover) {
+      cover->second.svmCover_ = 0;
+    }
+    if (it->second.memObj_ == nullptr) {
+      map.erase(it);
+    }
+  });
+}
+
+bool MemObjMap::IsSvmRange(const void* k) {
+  uintptr_t key = reinterpret_cast<uintptr_t>(k);
+  return MemObjMap_.floor(key, false, [&](uintptr_t, const Entry& entry) {
+    return key < entry.svmCover_;
+  });
+}
+
 void MemObjMap::AddVirtualMemObj(const void* k, amd::Memory* v) {
-  amd::ScopedLock lock(AllocatedLock_);
-  auto rval = VirtualMemObjMap_.insert({ reinterpret_cast<uintptr_t>(k), v });
-  if (!rval.second) {
+  bool added = VirtualMemObjMap_.modify([&](auto& map) {
+    return map.insert({ reinterpret_cast<uintptr_t>(k), v }).second;
+  });
+  if (!added) {
     DevLogPrintfError("Virtual Memobj map already has an entry for ptr: 0x%x",
                       reinterpret_cast<uintptr_t>(k));
   }
 }
 
 void MemObjMap::RemoveVirtualMemObj(const void* k) {
-  amd::ScopedLock lock(AllocatedLock_);
-  auto rval = VirtualMemObjMap_.erase(reinterpret_cast<uintptr_t>(k));
+  auto rval = VirtualMemObjMap_.modify([&](auto& map) {
+    return map.erase(reinterpret_cast<uintptr_t>(k));
+  });
   guarantee(rval == 1, "Virtual Memobj map does not have ptr: 0x%x",
                        reinterpret_cast<uintptr_t>(k));
 }
 
 amd::Memory* MemObjMap::FindVirtualMemObj(const void* k) {
-  amd::ScopedLock lock(AllocatedLock_);
   uintptr_t key = reinterpret_cast<uintptr_t>(k);
-  auto it = VirtualMemObjMap_.upper_bound(key);
-  if (it == VirtualMemObjMap_.begin()) {
-    return nullptr;
-  }
-
-  --it;
-  amd::Memory* mem = it->second;
-  if (key >= it->first && key < (it->first + mem->getSize())) {
+  return VirtualMemObjMap_.floor(key, static_cast<amd::Memory*>(nullptr),
+                                 [&](uintptr_t start, amd::Memory* mem) -> amd::Memory* {
     // the k is in the range
-    return mem;
-  } else {
-    return nullptr;
-  }
+    return (key < (start + mem->getSize())) ? mem : nullptr;
+  });
 }
 
 //==================================================================================================
@@ -497,33 +562,52 @@ void MemObjMap::UpdateAccess(amd::Device *peerDev) {
 
   // Provides access to all memory allocated on peerDev but
   // hsa_amd_agents_allow_access was not called because there was no peer
-  amd::ScopedLock lock(AllocatedLock_);
-  for (auto it : MemObjMap_) {
-    const std::vector<Device*>& devices = it.second->getContext().devices();
-    if (devices.size() == 1 && devices[0] == peerDev) {
-      device::Memory* devMem = it.second->getDeviceMemory(*devices[0]);
-      if (!devMem->getAllowedPeerAccess()) {
-        peerDev->deviceAllowAccess(reinterpret_cast<void*>(it.first));
-        devMem->setAllowedPeerAccess(true);
+  MemObjMap_.read([&](const auto& map) {
+    for (const auto& it : map) {
+      amd::Memory* memObj = it.second.memObj_;
+      if (memObj == nullptr) {
+        continue;
+      }
+      const std::vector<Device*>& devices = memObj->getContext().devices();
+      if (devices.size() == 1 && devices[0] == peerDev) {
+        device::Memory* devMem = memObj->getDeviceMemory(*devices[0]);
+        if (!devMem->getAllowedPeerAccess()) {
+          peerDev->deviceAllowAccess(reinterpret_cast<void*>(it.first));
+          devMem->setAllowedPeerAccess(true);
+        }
       }
     }
-  }
+  });
 }
 
 void MemObjMap::Purge(amd::Device* dev) {
   assert(dev != nullptr);
 
-  amd::ScopedLock lock(AllocatedLock_);
-  for (auto it = MemObjMap_.cbegin(); it != MemObjMap_.cend(); ) {
-    amd::Memory* memObj = it->second;
-    unsigned int flags = memObj->getMemFlags();
-    const std::vector<Device*>& devices = memObj->getContext().devices();
-    if (devices.size() == 1 && devices[0] == dev && !(flags & ROCCLR_MEM_INTERNAL_MEMORY)) {
-      memObj->release();
-      it = MemObjMap_.erase(it);
-    } else {
-      ++it;
+  // Runs on both copies of the map, only the returned list of objects is acted on
+  std::vector<amd::Memory*> purged = MemObjMap_.modify([&](auto& map) {
+    std::vector<amd::Memory*> erased;
+    for (auto it = map.begin(); it != map.end(); ) {
+      amd::Memory* memObj = it->second.memObj_;
+      if (memObj == nullptr) {
+        ++it;
+        continue;
+      }
+      unsigned int flags = memObj->getMemFlags();
+      const std::vector<Device*>& devices = memObj->getContext().devices();
+      if (devices.size() == 1 && devices[0] == dev && !(flags & ROCCLR_MEM_INTERNAL_MEMORY)) {
+        erased.push_back(memObj);
+        it->second.memObj_ = nullptr;
+        it = (it->second.svmEnd_ == 0) ? map.erase(it) : std::next(it);
+      } else {
+        ++it;
+      }
     }
+    return erased;
+  });
+  MemObjCount_.fetch_sub(purged.size(), std::memory_order_relaxed);
+  // Release outside of the map update, the destructors may look up the map
+  for (auto memObj : purged) {
+    memObj->release();
   }
 }
 
@@ -28,6 +28,7 @@
 #include "platform/object.hpp"
 #include "platform/memory.hpp"
 #include "utils/util.hpp"
+#include "utils/concurrent.hpp"
 #include "amdocl/cl_kernel.h"
 #include "elf/elf.hpp"
 #include "appprofile.hpp"
@@ -91,6 +92,7 @@ class SvmMapMemoryCommand;
 class SvmUnmapMemoryCommand;
 class SvmPrefetchAsyncCommand;
 class StreamOperationCommand;
+class StreamBatchOperationCommand;
 class VirtualMapCommand;
 class ExternalSemaphoreCmd;
 class Isa;
@@ -1289,10 +1291,20 @@ class VirtualDevice : public amd::HeapObject {
     ShouldNotReachHere();
   }
   virtual void submitStreamOperation(amd::StreamOperationCommand& cmd) { ShouldNotReachHere(); }
+  virtual void submitStreamBatchOperation(amd::StreamBatchOperationCommand& cmd) {
+    ShouldNotReachHere();
+  }
   virtual void submitVirtualMap(amd::VirtualMapCommand& cmd) { ShouldNotReachHere(); }
 
   virtual address allocKernelArguments(size_t size, size_t alignment) { return nullptr; }
 
+  //! Starts a dispatch batch. Kernel dispatches submitted until endDispatchBatch() may share
+  //! a single doorbell write. The caller must hold the execution lock for the whole batch
+  virtual void beginDispatchBatch() {}
+
+  //! Ends the dispatch batch and makes all deferred dispatches visible to the HW
+  virtual void endDispatchBatch() {}
+
   //! Get the blit manager object
   device::BlitManager& blitMgr() const { return *blitMgr_; }
 
@@ -1337,7 +1349,12 @@ class VirtualDevice : public amd::HeapObject {
 
 namespace amd {
 
-//! MemoryObject map lookup  class
+/*! \brief MemoryObject map lookup  class
+ *
+ *  Memory objects and the SVM ranges of SvmBuffer::malloc share one index keyed by start address.
+ *  Each entry also records the end of the SVM range its start falls into, so an object inside an
+ *  SVM range doesn't hide the range and both lookups are answered from the floor entry.
+ */
 class MemObjMap : public AllStatic {
  public:
   static size_t size();  //!< obtain the size of the container
@@ -1355,12 +1372,26 @@ class MemObjMap : public AllStatic {
   static void RemoveVirtualMemObj(const void* k);  //!< Same as RemoveMemObj but for virtual addressing
   static amd::Memory* FindVirtualMemObj(
       const void* k);  //!< Same as FindMemObj but for virtual addressing
+
+  static void AddSvmRange(const void* k, size_t size);  //!< Add an SVM range at k
+  static void RemoveSvmRange(const void* k);  //!< Remove the SVM range, which starts at k
+  static bool IsSvmRange(const void* k);  //!< Return true if k is inside an SVM range
  private:
-  static std::map<uintptr_t, amd::Memory*>
+  //! An entry of the shared index
+  struct Entry {
+    amd::Memory* memObj_ = nullptr;  //!< Memory object starting here, nullptr if none
+    uintptr_t svmEnd_ = 0;           //!< End of the SVM range starting here, 0 if none
+    uintptr_t svmCover_ = 0;         //!< End of the SVM range this start falls into, 0 if none
+  };
+
+  //! Return the entry at start, a new entry takes over the SVM range of its predecessor
+  static Entry& GetEntry(std::map<uintptr_t, Entry>& map, uintptr_t start);
+
+  static amd::ConcurrentRangeMap<Entry>
       MemObjMap_;                      //!< the mem object<->hostptr information container
-  static std::map<uintptr_t, amd::Memory*>
+  static amd::ConcurrentRangeMap<amd::Memory*>
       VirtualMemObjMap_;               //!< the virtual mem object<->hostptr information container
-  static amd::Monitor AllocatedLock_;  //!< amd monitor locker
+  static std::atomic<size_t> MemObjCount_;  //!< Number of entries in MemObjMap_
 };
 
 /// @brief Instruction Set Architecture properties.
@@ -25,6 +25,7 @@
 #include "platform/ndrange.hpp"
 #include "devprogram.hpp"
 #include "devkernel.hpp"
+#include "devprogramcache.hpp"
 #include "utils/macros.hpp"
 #include "utils/options.hpp"
 #if defined(WITH_COMPILER_LIB)
@@ -1730,6 +1731,114 @@ bool Program::trySubstObjFile(const char *SubstCfgFile,
   return true;
 }
 
+// ================================================================================================
+// Returns true if text includes a file, which isn't one of the embedded headers
+static bool hasExternalInclude(const std::string& text, const std::vector<std::string>& names) {
+  for (size_t pos = text.find('#'); pos != std::string::npos; pos = text.find('#', pos + 1)) {
+    size_t directive = text.find_first_not_of(" \t", pos + 1);
+    if ((directive == std::string::npos) || (text.compare(directive, 7, "include") != 0)) {
+      continue;
+    }
+    size_t open = text.find_first_not_of(" \t", directive + 7);
+    if ((open == std::string::npos) || ((text[open] != '"') && (text[open] != '<'))) {
+      // A macro include can't be resolved here
+      return true;
+    }
+    size_t close = text.find((text[open] == '"') ? '"' : '>', open + 1);
+    if ((close == std::string::npos) ||
+        (std::find(names.begin(), names.end(), text.substr(open + 1, close - open - 1)) ==
+         names.end())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ================================================================================================
+bool Program::programCacheKey(const std::string& sourceCode, const amd::option::Options* options,
+                              const std::vector<std::string>& preCompiledHeaders,
+                              std::string* key) const {
+#if defined(USE_COMGR_LIBRARY)
+  // Dumps and HIP builds always go to the compiler
+  if (!isLC() || isHIP() || (options->oVariables->DumpFlags > 0)) {
+    return false;
+  }
+
+  // Files included from disk aren't part of the key, so such programs are never cached
+  const std::vector<std::string>& headerNames = owner()->headerNames();
+  const std::vector<std::string>& headers = owner()->headers();
+  if (hasExternalInclude(sourceCode, headerNames)) {
+    return false;
+  }
+  for (const auto& header : headers) {
+    if (hasExternalInclude(header, headerNames)) {
+      return false;
+    }
+  }
+
+  // The interface version doesn't change with every compiler build, the library file does
+  static const std::string comgrIdentity =
+      ProgramCache::FileIdentity(amd::Comgr::library_address());
+  if (comgrIdentity.empty()) {
+    return false;
+  }
+  size_t major = 0;
+  size_t minor = 0;
+  amd::Comgr::get_version(&major, &minor);
+  std::string appName;
+  std::string appPathAndName;
+  amd::Os::getAppPathAndFileName(appName, appPathAndName);
+
+  // Every field is length prefixed, so different splits of the same bytes can't collide
+  std::ostringstream material;
+  auto add = [&material](const std::string& field) {
+    material << field.size() << ':' << field;
+  };
+  add(device().isa().isaName());
+  add(std::to_string(major) + "." + std::to_string(minor));
+  add(comgrIdentity);
+  add(device().info().driverVersion_);
+  add(device().settings().lcWavefrontSize64_ ? "wave64" : "wave32");
+  add(device().settings().enableWgpMode_ ? "wgp" : "cu");
+  add(appName);
+  add(options->origOptionStr);
+  add(options->llvmOptions);
+  for (const auto& option : options->clangOptions) {
+    add(option);
+  }
+  for (size_t i = 0; i < headers.size(); ++i) {
+    add(headerNames[i]);
+    add(headers[i]);
+  }
+  for (const auto& header : preCompiledHeaders) {
+    add(header);
+  }
+  add(sourceCode);
+  *key = material.str();
+  return true;
+#else   // !defined(USE_COMGR_LIBRARY)
+  return false;
+#endif  // !defined(USE_COMGR_LIBRARY)
+}
+
+// ================================================================================================
+void Program::discardKernels() {
+  clear();
+#if defined(USE_COMGR_LIBRARY)
+  if (isLC()) {
+    for (auto const& kernelMeta : kernelMetadataMap_) {
+      amd::Comgr::destroy_metadata(kernelMeta.second);
+    }
+    kernelMetadataMap_.clear();
+    amd::Comgr::destroy_metadata(metadata_);
+    metadata_ = {};
+  }
+#endif  // defined(USE_COMGR_LIBRARY)
+  setGlobalVariableTotalSize(0);
+  hasGlobalStores_ = false;
+}
+
+// ================================================================================================
 int32_t Program::build(const std::string& sourceCode, const char* origOptions,
                        amd::option::Options* options,
                        const std::vector<std::string>& preCompiledHeaders) {
@@ -1773,9 +1882,34 @@ int32_t Program::build(const std::string& sourceCode, const char* origOptions,
     headers.push_back(&tmpHeaders[i]);
     headerIncludeNames.push_back(tmpHeaderNames[i].c_str());
   }
+  // Reuse the code object of an identical earlier build
+  ProgramCache* cache = nullptr;
+  std::string cacheKey;
+  bool cacheHit = false;
+  if ((buildStatus_ == CL_BUILD_IN_PROGRESS) && !sourceCode.empty() &&
+      ((cache = ProgramCache::Instance()) != nullptr) &&
+      programCacheKey(sourceCode, options, preCompiledHeaders, &cacheKey)) {
+    std::string codeObject;
+    if (cache->Load(cacheKey, &codeObject)) {
+      internal_ = (compileOptions_.find("-cl-internal-kernel") != std::string::npos);
+      clBinary()->saveBIFBinary(codeObject.data(), codeObject.size());
+      if (createKernels(const_cast<void*>(clBinary()->data().first), clBinary()->data().second,
+                        options->oVariables->UniformWorkGroupSize, internal_)) {
+        cache->Accept(cacheKey);
+        cacheHit = true;
+        setType(TYPE_EXECUTABLE);
+      } else {
+        // Drop the entry and build from source, the link stores a fresh code object
+        cache->Reject(cacheKey);
+        discardKernels();
+        buildLog_ += "Warning: Cannot create kernels from the cached code object, rebuilding.\n";
+      }
+    }
+  }
+
   // Compile the source code if any
   bool compileStatus = true;
-  if ((buildStatus_ == CL_BUILD_IN_PROGRESS) && !sourceCode.empty()) {
+  if ((buildStatus_ == CL_BUILD_IN_PROGRESS) && !cacheHit && !sourceCode.empty()) {
     if (!headerIncludeNames.empty()) {
       compileStatus =
           compileImpl(sourceCode, headers, &headerIncludeNames[0], options, preCompiledHeaders);
@@ -1789,7 +1923,7 @@ int32_t Program::build(const std::string& sourceCode, const char* origOptions,
       buildLog_ = "Internal error: Compilation failed.";
     }
   }
-  if ((buildStatus_ == CL_BUILD_IN_PROGRESS) && !linkImpl(options)) {
+  if ((buildStatus_ == CL_BUILD_IN_PROGRESS) && !cacheHit && !linkImpl(options)) {
     buildStatus_ = CL_BUILD_ERROR;
     if (buildLog_.empty()) {
       buildLog_ += "Internal error: Link failed.\n";
@@ -1797,6 +1931,14 @@ int32_t Program::build(const std::string& sourceCode, const char* origOptions,
     }
   }
 
+  if (!cacheKey.empty()) {
+    if ((buildStatus_ == CL_BUILD_IN_PROGRESS) && !cacheHit && (type() == TYPE_EXECUTABLE)) {
+      cache->Store(cacheKey, clBinary()->data().first, clBinary()->data().second);
+    }
+    buildLog_ += cacheHit ? "Program cache hit, compilation skipped.\n" : "Program cache miss.\n";
+    buildLog_ += cache->Stats();
+  }
+
   if (!finiBuild(buildStatus_ == CL_BUILD_IN_PROGRESS)) {
     buildStatus_ = CL_BUILD_ERROR;
     if (buildLog_.empty()) {
@@ -1816,6 +1958,18 @@ int32_t Program::build(const std::string& sourceCode, const char* origOptions,
     buildLog_ += tmp_ss.str();
   }
 
+  return buildError();
+}
+
+// ================================================================================================
+void Program::setBuildTime(uint64_t waitTime, uint64_t buildTime) {
+  buildTime_ = buildTime;
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Program %p built for %s in %llu us, waited %llu us",
+          this, device().isa().targetId(), buildTime / 1000ULL, waitTime / 1000ULL);
+}
+
+// ================================================================================================
+void Program::printBuildLog(amd::option::Options* options) const {
   if (options->oVariables->BuildLog && !buildLog_.empty()) {
     if (strcmp(options->oVariables->BuildLog, "stderr") == 0) {
       fprintf(stderr, "%s\n", options->optionsLog().c_str());
@@ -1837,8 +1991,6 @@ int32_t Program::build(const std::string& sourceCode, const char* origOptions,
   if (!buildLog_.empty()) {
     LogError(buildLog_.c_str());
   }
-
-  return buildError();
 }
 
 // ================================================================================================
@@ -152,6 +152,7 @@ class Program : public amd::HeapObject {
   mutable std::string buildLog_;    //!< build log.
   int32_t buildStatus_;              //!< build status.
   int32_t buildError_;               //!< build error
+  uint64_t buildTime_ = 0;           //!< duration of the last build in nanoseconds
 
 #if defined(WITH_COMPILER_LIB)
   aclTargetInfo info_;              //!< The info target for this binary.
@@ -192,10 +193,16 @@ class Program : public amd::HeapObject {
   int32_t link(const std::vector<Program*>& inputPrograms, const char* origLinkOptions,
     amd::option::Options* linkOptions);
 
-  //! Build the device program.
+  //! Build the device program. The build log is kept for printBuildLog().
   int32_t build(const std::string& sourceCode, const char* origOptions,
                 amd::option::Options* options, const std::vector<std::string>& preCompiledHeaders);
 
+  //! Write the build log to the target of the BuildLog option and to the runtime log
+  void printBuildLog(amd::option::Options* options) const;
+
+  //! Record and log the time the last build waited for a build thread and spent building
+  void setBuildTime(uint64_t waitTime, uint64_t buildTime);
+
   //! Load the device program.
   bool load();
 
@@ -220,6 +227,9 @@ class Program : public amd::HeapObject {
   //! Return the build error.
   int32_t buildError() const { return buildError_; }
 
+  //! Return the duration of the last build in nanoseconds
+  uint64_t buildTime() const { return buildTime_; }
+
   //! Return the symbols vector.
   const kernels_t& kernels() const { return kernels_; }
   kernels_t& kernels() { return kernels_; }
@@ -481,6 +491,14 @@ class Program : public amd::HeapObject {
                        const std::string& sourceCode,
                        const amd::option::Options* options);
 
+  //! Builds the program cache key of a build from source, returns false if it can't be cached
+  bool programCacheKey(const std::string& sourceCode, const amd::option::Options* options,
+                       const std::vector<std::string>& preCompiledHeaders,
+                       std::string* key) const;
+
+  //! Drops the kernels and kernel metadata created from a rejected code object
+  void discardKernels();
+
   //! Disable default copy constructor
   Program(const Program&);
 
@@ -0,0 +1,346 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "device/devprogramcache.hpp"
+#include "os/os.hpp"
+#include "utils/flags.hpp"
+#include "utils/debug.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif  // _WIN32
+
+namespace amd::device {
+
+namespace fs = std::filesystem;
+
+constexpr char ProgramCache::kMagic[8];
+
+// ================================================================================================
+ProgramCache* ProgramCache::Instance() {
+  static ProgramCache* cache = []() -> ProgramCache* {
+    if (!AMD_OCL_PROGRAM_CACHE || (AMD_OCL_PROGRAM_CACHE_SIZE == 0)) {
+      return nullptr;
+    }
+    std::string path = (AMD_OCL_PROGRAM_CACHE_PATH != nullptr) ? AMD_OCL_PROGRAM_CACHE_PATH : "";
+    if (path.empty()) {
+#if defined(_WIN32)
+      path = Os::getEnvironment("LOCALAPPDATA");
+      if (path.empty()) {
+        return nullptr;
+      }
+      path += "\\AMD\\OclProgramCache";
+#else   // !_WIN32
+      path = Os::getEnvironment("XDG_CACHE_HOME");
+      if (path.empty()) {
+        path = Os::getEnvironment("HOME");
+        if (path.empty()) {
+          return nullptr;
+        }
+        path += "/.cache";
+      }
+      path += "/amd/ocl_program_cache";
+#endif  // !_WIN32
+    }
+    std::error_code ec;
+    fs::create_directories(path, ec);
+    if (!fs::is_directory(path, ec)) {
+      ClPrint(amd::LOG_WARNING, amd::LOG_CODE, "Program cache disabled, can't use %s",
+              path.c_str());
+      return nullptr;
+    }
+    ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Program cache in %s, cap %zu MB", path.c_str(),
+            AMD_OCL_PROGRAM_CACHE_SIZE);
+    // Never destroyed, programs may still be built during process teardown
+    return new ProgramCache(path, AMD_OCL_PROGRAM_CACHE_SIZE * Mi);
+  }();
+  return cache;
+}
+
+// ================================================================================================
+ProgramCache::ProgramCache(const std::string& path, size_t capacity)
+    : path_(path),
+      capacity_(capacity),
+      lock_("Program cache lock"),
+      usedBytes_(0),
+      hits_(0),
+      misses_(0),
+      stores_(0),
+      evictions_(0) {
+  // Establishes the size estimate and trims a cache left over with a larger cap
+  amd::ScopedLock lock(lock_);
+  Evict(capacity_);
+}
+
+// ================================================================================================
+uint64_t ProgramCache::Hash(const void* data, size_t size, uint64_t seed) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  uint64_t hash = seed;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// ================================================================================================
+std::string ProgramCache::FileIdentity(const void* address) {
+  std::string fileName;
+#if defined(_WIN32)
+  HMODULE module = nullptr;
+  char buffer[MAX_PATH] = {};
+  if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                          GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                          reinterpret_cast<LPCSTR>(address), &module) ||
+      (GetModuleFileNameA(module, buffer, sizeof(buffer)) == 0)) {
+    return "";
+  }
+  fileName = buffer;
+#else   // !_WIN32
+  size_t offset = 0;
+  if (!Os::FindFileNameFromAddress(address, &fileName, &offset)) {
+    return "";
+  }
+#endif  // !_WIN32
+  std::error_code ec;
+  uintmax_t size = fs::file_size(fileName, ec);
+  if (ec) {
+    return "";
+  }
+  fs::file_time_type time = fs::last_write_time(fileName, ec);
+  if (ec) {
+    return "";
+  }
+  std::stringstream identity;
+  identity << fileName << ':' << size << ':' << time.time_since_epoch().count();
+  return identity.str();
+}
+
+// ================================================================================================
+bool ProgramCache::IsEntryName(const std::string& name, bool* temporary) {
+  // 16 hex digits of the key hash, ".co", then ".tmp<pid>_<counter>" for a store in flight
+  constexpr size_t kHashDigits = 16;
+  static const std::string kExtension = ".co";
+  static const std::string kTemporary = ".tmp";
+  if ((name.size() < kHashDigits + kExtension.size()) ||
+      !std::all_of(name.begin(), name.begin() + kHashDigits,
+                   [](char c) { return isxdigit(static_cast<unsigned char>(c)) != 0; }) ||
+      (name.compare(kHashDigits, kExtension.size(), kExtension) != 0)) {
+    return false;
+  }
+  size_t pos = kHashDigits + kExtension.size();
+  *temporary = (pos != name.size());
+  if (!*temporary) {
+    return true;
+  }
+  if (name.compare(pos, kTemporary.size(), kTemporary) != 0) {
+    return false;
+  }
+  pos += kTemporary.size();
+  size_t separator = name.find('_', pos);
+  auto isDigits = [&name](size_t begin, size_t end) {
+    return (begin < end) &&
+           std::all_of(name.begin() + begin, name.begin() + end,
+                       [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; });
+  };
+  return (separator != std::string::npos) && isDigits(pos, separator) &&
+         isDigits(separator + 1, name.size());
+}
+
+// ================================================================================================
+std::string ProgramCache::EntryPath(const std::string& key) const {
+  std::stringstream name;
+  name << path_ << Os::fileSeparator() << std::hex << std::setfill('0') << std::setw(16)
+       << Hash(key.data(), key.size(), kFnvOffset) << ".co";
+  return name.str();
+}
+
+// ================================================================================================
+bool ProgramCache::Load(const std::string& key, std::string* codeObject) {
+  std::string entry = EntryPath(key);
+  std::ifstream file(entry, std::ios::binary);
+  if (!file.is_open()) {
+    misses_++;
+    return false;
+  }
+
+  Header header = {};
+  bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header))) &&
+               (memcmp(header.magic_, kMagic, sizeof(kMagic)) == 0) &&
+               (header.version_ == kVersion) &&
+               (header.keyHash_ == Hash(key.data(), key.size(), kKeySeed)) &&
+               (header.keySize_ == key.size()) && (header.payloadSize_ != 0);
+  if (valid) {
+    // The hashes only filter, the stored key must match byte for byte
+    std::string storedKey(header.keySize_, '\0');
+    valid = static_cast<bool>(file.read(&storedKey[0], storedKey.size())) && (storedKey == key);
+  }
+  if (valid) {
+    codeObject->resize(header.payloadSize_);
+    valid = static_cast<bool>(file.read(&(*codeObject)[0], codeObject->size())) &&
+            (file.peek() == std::ifstream::traits_type::eof()) &&
+            (header.payloadHash_ == Hash(codeObject->data(), codeObject->size(), kFnvOffset));
+  }
+  file.close();
+
+  if (!valid) {
+    // A truncated or foreign entry, the next store replaces it
+    ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Program cache entry %s is invalid", entry.c_str());
+    codeObject->clear();
+    misses_++;
+    return false;
+  }
+  return true;
+}
+
+// ================================================================================================
+void ProgramCache::Accept(const std::string& key) {
+  // Mark the entry as recently used for the eviction order
+  std::error_code ec;
+  fs::last_write_time(EntryPath(key), fs::file_time_type::clock::now(), ec);
+  hits_++;
+}
+
+// ================================================================================================
+void ProgramCache::Reject(const std::string& key) {
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Program cache entry %s was rejected",
+          EntryPath(key).c_str());
+  std::error_code ec;
+  fs::remove(EntryPath(key), ec);
+  misses_++;
+}
+
+// ================================================================================================
+void ProgramCache::Store(const std::string& key, const void* codeObject, size_t size) {
+  Header header = {};
+  memcpy(header.magic_, kMagic, sizeof(kMagic));
+  header.version_ = kVersion;
+  header.keyHash_ = Hash(key.data(), key.size(), kKeySeed);
+  header.keySize_ = key.size();
+  header.payloadSize_ = size;
+  header.payloadHash_ = Hash(codeObject, size, kFnvOffset);
+
+  // Write under a name unique to this process and store, then publish with one rename
+  static std::atomic<uint64_t> counter(0);
+  std::string entry = EntryPath(key);
+  std::stringstream temp;
+  temp << entry << ".tmp" << Os::getProcessId() << "_" << counter++;
+
+  std::ofstream file(temp.str(), std::ios::binary | std::ios::trunc);
+  bool written = file.is_open() &&
+                 file.write(reinterpret_cast<const char*>(&header), sizeof(header)) &&
+                 file.write(key.data(), key.size()) &&
+                 file.write(reinterpret_cast<const char*>(codeObject), size);
+  file.close();
+
+  std::error_code ec;
+  if (written && !file.fail()) {
+    fs::rename(temp.str(), entry, ec);
+  } else {
+    ec = std::make_error_code(std::errc::io_error);
+  }
+  if (ec) {
+    ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Program cache can't store %s: %s", entry.c_str(),
+            ec.message().c_str());
+    fs::remove(temp.str(), ec);
+    return;
+  }
+  stores_++;
+
+  amd::ScopedLock lock(lock_);
+  usedBytes_ += sizeof(header) + key.size() + size;
+  if (usedBytes_ > capacity_) {
+    // Trim with some slack, so the next few stores don't rescan the directory
+    Evict(capacity_ - capacity_ / 4);
+  }
+}
+
+// ================================================================================================
+void ProgramCache::Evict(size_t target) {
+  struct Entry {
+    fs::path path_;
+    fs::file_time_type time_;
+    uintmax_t size_;
+  };
+  std::vector<Entry> entries;
+  size_t total = 0;
+
+  std::error_code ec;
+  for (fs::directory_iterator it(path_, ec), end; !ec && (it != end); it.increment(ec)) {
+    std::error_code entryEc;
+    bool temporary = false;
+    if (!it->is_regular_file(entryEc) ||
+        !IsEntryName(it->path().filename().string(), &temporary)) {
+      continue;
+    }
+    Entry entry = {it->path(), it->last_write_time(entryEc), it->file_size(entryEc)};
+    if (entryEc) {
+      // Another process evicted it in the meantime
+      continue;
+    }
+    if (temporary) {
+      // Temporary files of stores in flight, or left behind by a process that died
+      if (entry.time_ + std::chrono::hours(1) < fs::file_time_type::clock::now()) {
+        fs::remove(entry.path_, entryEc);
+      }
+      continue;
+    }
+    total += entry.size_;
+    entries.push_back(entry);
+  }
+
+  if (total > target) {
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.time_ < b.time_; });
+    for (const auto& entry : entries) {
+      if (total <= target) {
+        break;
+      }
+      if (fs::remove(entry.path_, ec)) {
+        evictions_++;
+      }
+      // Gone either way, possibly removed by another process
+      total -= entry.size_;
+    }
+  }
+  usedBytes_ = total;
+}
+
+// ================================================================================================
+std::string ProgramCache::Stats() const {
+  amd::ScopedLock lock(lock_);
+  std::stringstream stats;
+  stats << "Program cache: " << hits_ << " hits, " << misses_ << " misses, " << stores_
+        << " stores, " << evictions_ << " evictions, about " << (usedBytes_ / Ki) << " of "
+        << (capacity_ / Ki) << " KB used\n";
+  return stats.str();
+}
+
+}  // namespace amd::device
@@ -0,0 +1,105 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+
+#include <atomic>
+#include <string>
+
+namespace amd::device {
+
+/*! \brief Persistent cache of code objects built from program source
+ *
+ *  Entries live in one file per key in the cache directory, named after a hash of the key. A file
+ *  starts with a header followed by the full key and the code object. A load compares the stored
+ *  key with the requested one, so a name collision is detected as a miss. Files are written under
+ *  a unique temporary name and renamed into place, which keeps concurrent processes from seeing
+ *  partial entries. An accepted entry refreshes its file time, so eviction drops the least
+ *  recently used entries once the directory grows over its size cap. Eviction only touches files
+ *  named like entries or their temporaries, anything else in the directory is left alone.
+ */
+class ProgramCache : public amd::HeapObject {
+ public:
+  //! Returns the process wide cache, nullptr if the cache is disabled or unusable
+  static ProgramCache* Instance();
+
+  //! Looks up the code object built for key, the caller reports a found entry with Accept/Reject
+  bool Load(const std::string& key, std::string* codeObject);
+
+  //! Counts a hit on the loaded entry of key and marks it as recently used
+  void Accept(const std::string& key);
+
+  //! Counts a miss on the loaded entry of key, which was unusable, and drops it
+  void Reject(const std::string& key);
+
+  //! Stores the code object built for key
+  void Store(const std::string& key, const void* codeObject, size_t size);
+
+  //! Returns a summary of the cache statistics for build logs
+  std::string Stats() const;
+
+  //! Returns the 64 bit FNV-1a hash of data, starting from seed
+  static uint64_t Hash(const void* data, size_t size, uint64_t seed);
+
+  //! Returns the path, size and time of the file mapped at address, empty if it's unknown
+  static std::string FileIdentity(const void* address);
+
+ private:
+  //! Entry file header
+  struct Header {
+    char magic_[8];         //!< kMagic
+    uint32_t version_;      //!< kVersion
+    uint32_t reserved_;     //!< Zero
+    uint64_t keyHash_;      //!< Hash of the key with kKeySeed
+    uint64_t keySize_;      //!< Size of the key that follows the header
+    uint64_t payloadSize_;  //!< Size of the code object that follows the key
+    uint64_t payloadHash_;  //!< Hash of the code object
+  };
+
+  static constexpr char kMagic[8] = {'A', 'M', 'D', 'P', 'R', 'G', 'C', 'O'};
+  static constexpr uint32_t kVersion = 2;
+  static constexpr uint64_t kFnvOffset = 0xcbf29ce484222325ull;
+  static constexpr uint64_t kKeySeed = 0x9e3779b97f4a7c15ull;
+
+  ProgramCache(const std::string& path, size_t capacity);
+
+  //! Returns true if name is an entry file, or a temporary file of one if temporary is set
+  static bool IsEntryName(const std::string& name, bool* temporary);
+
+  //! Returns the file name of the entry for key
+  std::string EntryPath(const std::string& key) const;
+
+  //! Scans the directory, removes the oldest entries until the cache fits in target bytes
+  void Evict(size_t target);
+
+  const std::string path_;          //!< Cache directory
+  const size_t capacity_;           //!< Size cap in bytes
+  mutable amd::Monitor lock_;       //!< Serializes eviction and the size estimate
+  size_t usedBytes_;                //!< Estimated size of the directory
+  std::atomic<uint64_t> hits_;      //!< Lookups that found a valid entry
+  std::atomic<uint64_t> misses_;    //!< Lookups that didn't
+  std::atomic<uint64_t> stores_;    //!< Entries written
+  std::atomic<uint64_t> evictions_; //!< Entries removed by eviction
+};
+
+}  // namespace amd::device
@@ -2188,6 +2188,26 @@ void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
   profilingEnd(cmd);
 }
 
+// ================================================================================================
+void VirtualGPU::submitStreamBatchOperation(amd::StreamBatchOperationCommand& cmd) {
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+  profilingBegin(cmd);
+
+  // The batch shares one command, but each operation still runs its own blit kernel
+  KernelBlitManager& blit = static_cast<KernelBlitManager&>(blitMgr());
+  for (const auto& op : cmd.ops()) {
+    Memory* memory = dev().getGpuMemory(op.memory_);
+    bool result = (op.type_ == ROCCLR_COMMAND_STREAM_WAIT_VALUE) ?
+        blit.streamOpsWait(*memory, op.value_, op.offset_, op.sizeBytes_, op.flags_, op.mask_) :
+        blit.streamOpsWrite(*memory, op.value_, op.offset_, op.sizeBytes_);
+    if (!result) {
+      LogError("submitStreamBatchOperation: Operation failed!");
+    }
+  }
+  profilingEnd(cmd);
+}
+
 // ================================================================================================
 void VirtualGPU::submitVirtualMap(amd::VirtualMapCommand& vcmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
@@ -0,0 +1,127 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Only the standard library is used here, so the packet assembly can be built and tested on the
+// host with a mock queue.
+namespace amd::roc {
+
+/*! \brief Assembles barrier-AND packets before they are written into an AQL queue
+ *
+ *  Null and duplicate dependencies and the ones already satisfied are dropped, and the rest is
+ *  packed into as few packets as the dependency limit allows. A wait-only barrier, which has no
+ *  completion signal, vanishes when nothing is left to wait for. Dependencies aren't carried
+ *  across calls: a wait-only barrier always precedes a kernel dispatch, which can't absorb them,
+ *  so Wait() writes its packets right away.
+ *
+ *  Signal is a handle with a \a handle member, 0 is the null signal. Queue provides:
+ *    bool IsSatisfied(Signal signal)  returns true if the dependency is met already
+ *    void Emit(uint16_t header, const Signal* deps, Signal completion)  writes a barrier-AND
+ *      packet with kMaxDeps dependencies, the unused ones are null
+ */
+template <typename Signal> class BarrierCoalescer {
+ public:
+  //! The number of dependent signals in a barrier-AND packet
+  static constexpr size_t kMaxDeps = 5;
+
+  //! \a waitHeader is the header of the wait-only packets
+  explicit BarrierCoalescer(uint16_t waitHeader) : waitHeader_(waitHeader) {}
+
+  //! Writes the dependencies, which are still pending, as wait-only barriers
+  template <typename Queue> void Wait(Queue& queue, const Signal* deps, size_t count) {
+    requested_ += (count + kMaxDeps - 1) / kMaxDeps;
+    Stage(queue, deps, count);
+    Flush(queue);
+  }
+
+  /*! \brief Writes a barrier-AND packet, which waits for \a deps
+   *
+   *  completion() returns the completion signal of the packet. It's called after the
+   *  dependencies, which don't fit into the packet, were written.
+   */
+  template <typename Queue, typename Completion>
+  void Barrier(Queue& queue, uint16_t header, const Signal* deps, size_t count,
+               Completion completion) {
+    requested_ += std::max<size_t>((count + kMaxDeps - 1) / kMaxDeps, 1);
+    Stage(queue, deps, count);
+    Emit(queue, header, completion());
+  }
+
+  //! Returns the number of packets the barriers would take with all their dependencies
+  uint64_t Requested() const { return requested_; }
+
+  //! Returns the number of written packets
+  uint64_t Emitted() const { return emitted_; }
+
+  //! Returns the number of packets saved by dropping dependencies
+  uint64_t Saved() const { return requested_ - std::min(requested_, emitted_); }
+
+ private:
+  //! Writes the staged dependencies as a wait-only barrier
+  template <typename Queue> void Flush(Queue& queue) {
+    if (count_ != 0) {
+      Emit(queue, waitHeader_, Signal{});
+    }
+  }
+
+  template <typename Queue> void Stage(Queue& queue, const Signal* deps, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      const Signal& dep = deps[i];
+      if ((dep.handle == 0) || IsStaged(dep) || queue.IsSatisfied(dep)) {
+        continue;
+      }
+      if (count_ == kMaxDeps) {
+        Flush(queue);
+      }
+      deps_[count_++] = dep;
+    }
+  }
+
+  bool IsStaged(const Signal& dep) const {
+    for (size_t i = 0; i < count_; ++i) {
+      if (deps_[i].handle == dep.handle) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Queue> void Emit(Queue& queue, uint16_t header, Signal completion) {
+    queue.Emit(header, deps_, completion);
+    for (size_t i = 0; i < kMaxDeps; ++i) {
+      deps_[i] = Signal{};
+    }
+    count_ = 0;
+    emitted_++;
+  }
+
+  const uint16_t waitHeader_;   //!< Header of the wait-only packets
+  Signal deps_[kMaxDeps] = {};  //!< Staged dependencies
+  size_t count_ = 0;            //!< The number of staged dependencies
+  uint64_t requested_ = 0;      //!< Packets the barriers would take without coalescing
+  uint64_t emitted_ = 0;        //!< Written packets
+};
+
+}  // namespace amd::roc
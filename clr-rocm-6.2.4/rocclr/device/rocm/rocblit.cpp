@@ -2597,6 +2597,56 @@ bool KernelBlitManager::streamOpsWait(device::Memory& memory, uint64_t value, si
   return result;
 }
 
+// ================================================================================================
+bool KernelBlitManager::streamOpsBatch(const amd::StreamBatchOperationCommand::Operation* ops,
+                                       size_t count) const {
+  assert((count > 0) && (count <= kMaxStreamOpsBatch) && "Invalid stream ops batch size");
+  amd::ScopedLock k(lockXferOps_);
+  bool result = false;
+  uint blitType = StreamOpsBatch;
+  size_t dim = 1;
+
+  size_t globalWorkOffset[1] = { 0 };
+  size_t globalWorkSize[1] = { 1 };
+  size_t localWorkSize[1] = { 1 };
+
+  // Encode the operations. Bit 0 of the op flags selects a 64 bit access, bit 1 a wait
+  // and bits 4 and above hold the wait condition.
+  uint64_t ptrs[kMaxStreamOpsBatch] = {};
+  uint64_t values[kMaxStreamOpsBatch] = {};
+  uint64_t masks[kMaxStreamOpsBatch] = {};
+  uint32_t opFlags[kMaxStreamOpsBatch] = {};
+  for (size_t i = 0; i < count; ++i) {
+    device::Memory* memory = ops[i].memory_->getDeviceMemory(dev());
+    ptrs[i] = static_cast<uint64_t>(memory->virtualAddress()) + ops[i].offset_;
+    values[i] = ops[i].value_;
+    masks[i] = ops[i].mask_;
+    opFlags[i] = (ops[i].sizeBytes_ == sizeof(uint64_t)) ? 0x1 : 0;
+    if (ops[i].type_ == ROCCLR_COMMAND_STREAM_WAIT_VALUE) {
+      opFlags[i] |= 0x2 | (ops[i].flags_ << 4);
+    }
+  }
+  uint32_t numOps = static_cast<uint32_t>(count);
+
+  // Program kernels arguments for the batch
+  setArgument(kernels_[blitType], 0, sizeof(ptrs), ptrs);
+  setArgument(kernels_[blitType], 1, sizeof(values), values);
+  setArgument(kernels_[blitType], 2, sizeof(masks), masks);
+  setArgument(kernels_[blitType], 3, sizeof(opFlags), opFlags);
+  setArgument(kernels_[blitType], 4, sizeof(numOps), &numOps);
+
+  // Create ND range object for the kernel's execution
+  amd::NDRangeContainer ndrange(dim, globalWorkOffset, globalWorkSize, localWorkSize);
+
+  // Execute the blit
+  address parameters = captureArguments(kernels_[blitType]);
+  result = gpu().submitKernelInternal(ndrange, *kernels_[blitType], parameters, nullptr);
+  releaseArguments(parameters);
+  synchronize();
+
+  return result;
+}
+
 // ================================================================================================
 bool KernelBlitManager::initHeap(device::Memory* heap_to_initialize, device::Memory* initial_blocks,
                                  uint heap_size, uint number_of_initial_blocks) const {
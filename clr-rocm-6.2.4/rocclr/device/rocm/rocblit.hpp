@@ -292,6 +292,7 @@ class KernelBlitManager : public DmaBlitManager {
     BlitCopyBufferRectAligned,
     StreamOpsWrite,
     StreamOpsWait,
+    StreamOpsBatch,
     Scheduler,
     GwsInit,
     InitHeap,
@@ -519,6 +520,15 @@ class KernelBlitManager : public DmaBlitManager {
                              uint64_t mask
   ) const;
 
+  //! Maximum number of operations a single stream ops batch dispatch can encode
+  static constexpr size_t kMaxStreamOpsBatch = 8;
+
+  //! Stream memory ops - Runs up to kMaxStreamOpsBatch wait and write operations in order
+  //! with a single dispatch
+  bool streamOpsBatch(const amd::StreamBatchOperationCommand::Operation* ops, //!< Operations
+                      size_t count                                  //!< Number of operations
+  ) const;
+
   virtual amd::Monitor* lockXfer() const { return &lockXferOps_; }
 
   virtual bool initHeap(device::Memory* heap_to_initialize,
@@ -599,7 +609,7 @@ static const char* BlitName[KernelBlitManager::BlitTotal] = {
   "__amd_rocclr_fillBufferAligned", "__amd_rocclr_fillBufferAligned2D", "__amd_rocclr_copyBuffer",
   "__amd_rocclr_copyBufferAligned", "__amd_rocclr_copyBufferRect",
   "__amd_rocclr_copyBufferRectAligned", "__amd_rocclr_streamOpsWrite", "__amd_rocclr_streamOpsWait",
-  "__amd_rocclr_scheduler", "__amd_rocclr_gwsInit", "__amd_rocclr_initHeap",
+  "__amd_rocclr_streamOpsBatch", "__amd_rocclr_scheduler", "__amd_rocclr_gwsInit", "__amd_rocclr_initHeap",
   "__amd_rocclr_fillImage", "__amd_rocclr_copyImage", "__amd_rocclr_copyImage1DA",
   "__amd_rocclr_copyImageToBuffer", "__amd_rocclr_copyBufferToImage"
 };
@@ -0,0 +1,108 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Only the standard library is used here, so the ordering logic can be built and tested on the
+// host with mock signals.
+namespace amd::roc {
+
+//! Completion latency histogram with power of two microsecond buckets
+typedef std::array<uint64_t, 24> CompletionHistogram;
+
+/*! \brief Pending completions of one queue
+ *
+ *  Entries are reaped strictly in submission order: a completed entry behind a pending one waits
+ *  until everything in front of it has completed. The time from submission to reaping is kept in
+ *  a histogram with power of two microsecond buckets.
+ */
+template <typename Entry> class CompletionQueue {
+ public:
+  static constexpr size_t kHistogramBuckets = std::tuple_size<CompletionHistogram>::value;
+
+  //! Adds an entry submitted at submitNs
+  void Push(const Entry& entry, uint64_t submitNs) { pending_.push_back({entry, submitNs}); }
+
+  //! Returns true if nothing is pending
+  bool Empty() const { return pending_.empty(); }
+
+  //! Returns the number of pending entries
+  size_t Size() const { return pending_.size(); }
+
+  //! Returns the oldest pending entry
+  const Entry& Front() const { return pending_.front().entry_; }
+
+  /*! \brief Moves the completed prefix of the queue to done
+   *
+   *  probe(entry) returns true once an entry is complete. Probing stops at the first entry that
+   *  isn't, or after maxCount entries. Returns the number of reaped entries.
+   */
+  template <typename Probe>
+  size_t Reap(Probe probe, uint64_t nowNs, std::vector<Entry>* done, size_t maxCount = SIZE_MAX) {
+    size_t count = 0;
+    while (!pending_.empty() && (count < maxCount) && probe(pending_.front().entry_)) {
+      const Pending& front = pending_.front();
+      histogram_[Bucket((nowNs > front.submitNs_) ? (nowNs - front.submitNs_) : 0)]++;
+      done->push_back(front.entry_);
+      pending_.pop_front();
+      count++;
+    }
+    return count;
+  }
+
+  //! Moves all the pending entries to done in submission order, without recording a latency
+  void Drain(std::vector<Entry>* done) {
+    for (const Pending& pending : pending_) {
+      done->push_back(pending.entry_);
+    }
+    pending_.clear();
+  }
+
+  //! Returns the completion latency histogram
+  const CompletionHistogram& GetHistogram() const { return histogram_; }
+
+  //! Returns the bucket of a latency: 0 below 1us, n for [2^(n-1), 2^n) us, the last is open
+  static size_t Bucket(uint64_t latencyNs) {
+    uint64_t us = latencyNs / 1000;
+    size_t bucket = 0;
+    while ((us != 0) && (bucket < kHistogramBuckets - 1)) {
+      us >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+ private:
+  struct Pending {
+    Entry entry_;         //!< Submitted entry
+    uint64_t submitNs_;   //!< Submission time
+  };
+
+  std::deque<Pending> pending_;         //!< Pending entries in submission order
+  CompletionHistogram histogram_ = {};  //!< Completion latency histogram
+};
+
+}  // namespace amd::roc
@@ -23,6 +23,7 @@
 #include "platform/program.hpp"
 #include "platform/kernel.hpp"
 #include "os/os.hpp"
+#include "os/numa.hpp"
 #include "utils/debug.hpp"
 #include "utils/flags.hpp"
 #include "utils/options.hpp"
@@ -40,6 +41,7 @@
 #include "device/rocm/rocmemory.hpp"
 #include "device/rocm/rocglinterop.hpp"
 #include "device/rocm/rocsignal.hpp"
+#include "device/rocm/rocreaper.hpp"
 #include "platform/sampler.hpp"
 
 #if defined(__clang__)
@@ -181,6 +183,8 @@ Device::Device(hsa_agent_t bkendDevice)
     , gpuvm_segment_max_alloc_(0)
     , alloc_granularity_(0)
     , xferQueue_(nullptr)
+    , signalPool_(nullptr)
+    , reaper_(nullptr)
     , xferRead_(nullptr)
     , xferWrite_(nullptr)
     , freeMem_(0)
@@ -224,6 +228,17 @@ void Device::setupCpuAgent() {
     isXgmi_ = (link_attrs[0].second == HSA_AMD_LINK_INFO_TYPE_XGMI);
   }
 
+  // The CPU agents are enumerated in NUMA node order, so the override names an agent index.
+  // The override names devices by their rocclr device index, i.e. the number of GPU devices
+  // registered before this one. It isn't remapped through the visible device list of HIP.
+  uint32_t ordinal = static_cast<uint32_t>(amd::Device::numDevices(CL_DEVICE_TYPE_GPU, false));
+  uint32_t nearest = index;
+  index = amd::NumaPlacement::resolveNode(amd::NumaTopology::system(), ordinal, nearest,
+                                          ROC_NUMA_NODE_MAP);
+  if (index >= size) {
+    index = nearest;
+  }
+
   preferred_numa_node_ = index;
   cpu_agent_ = cpu_agents_[index].agent;
   system_segment_ = cpu_agents_[index].fine_grain_pool;
@@ -232,6 +247,9 @@ void Device::setupCpuAgent() {
   ClPrint(amd::LOG_INFO, amd::LOG_INIT, "Numa selects cpu agent[%zu]=0x%zx(fine=0x%zx,"
           "coarse=0x%zx) for gpu agent=0x%zx CPU<->GPU XGMI=%d", index, cpu_agent_.handle,
           system_segment_.handle, system_coarse_segment_.handle, bkendDevice_.handle, isXgmi_);
+  ClPrint(amd::LOG_INFO, amd::LOG_INIT, "Device %u host memory placed on NUMA node %u "
+          "(nearest %u%s)", ordinal, index, nearest,
+          (index != nearest) ? ", ROC_NUMA_NODE_MAP override" : "");
 }
 
 void Device::checkAtomicSupport() {
@@ -308,6 +326,11 @@ Device::~Device() {
   if (0 != prefetch_signal_.handle) {
     hsa_signal_destroy(prefetch_signal_);
   }
+
+  delete reaper_;
+
+  // The queues return their signals on destruction, so the pool goes last
+  delete signalPool_;
 }
 
 bool NullDevice::initCompiler(bool isOffline) {
@@ -848,6 +871,22 @@ bool Device::create() {
     return false;
   }
 
+  // Pre-populate the completion signals for the first queue
+  signalPool_ = new ProfilingSignalPool(*this);
+  if ((signalPool_ == nullptr) || !signalPool_->Fill(ROC_SIGNAL_POOL_SIZE)) {
+    LogError("Couldn't create the profiling signal pool");
+    return false;
+  }
+
+  if (AMD_DIRECT_DISPATCH && ROC_COMPLETION_REAPER) {
+    reaper_ = new CompletionReaper(*this);
+    if ((reaper_ == nullptr) || !reaper_->Create()) {
+      LogError("Couldn't start the completion reaper, falling back to HSA async handlers");
+      delete reaper_;
+      reaper_ = nullptr;
+    }
+  }
+
   return true;
 }
 
@@ -2925,8 +2964,21 @@ bool Device::SetClockMode(const cl_set_device_clock_mode_input_amd setClockModeI
   return result;
 }
 
+// ================================================================================================
+void Device::FlushDoorbells(uint64_t startedBefore) const {
+  if ((reaper_ == nullptr) || !reaper_->HasDoorbellBatches()) {
+    return;
+  }
+  amd::ScopedLock lock(vgpusAccess());
+  for (const auto& vgpu : vgpus()) {
+    vgpu->flushDoorbell(startedBefore);
+  }
+}
+
 // ================================================================================================
 bool Device::IsHwEventReadyForcedWait(const amd::Event& event) const {
+  // A query must not wait for dispatches the HW hasn't seen yet
+  FlushDoorbells();
   void* hw_event =
       (event.NotifyEvent() != nullptr) ? event.NotifyEvent()->HwEvent() : event.HwEvent();
   if (hw_event == nullptr) {
@@ -2939,6 +2991,7 @@ bool Device::IsHwEventReadyForcedWait(const amd::Event& event) const {
 
 // ================================================================================================
 bool Device::IsHwEventReady(const amd::Event& event, bool wait) const {
+  FlushDoorbells();
   void* hw_event =
       (event.NotifyEvent() != nullptr) ? event.NotifyEvent()->HwEvent() : event.HwEvent();
   if (hw_event == nullptr) {
@@ -3586,6 +3639,96 @@ ProfilingSignal::~ProfilingSignal() {
   }
 }
 
+// ================================================================================================
+ProfilingSignalPool::ProfilingSignalPool(const Device& dev)
+    : dev_(dev), lock_("Profiling Signal Pool Lock", true),
+      maxFree_(4 * static_cast<size_t>(ROC_SIGNAL_POOL_SIZE)) {}
+
+// ================================================================================================
+ProfilingSignalPool::~ProfilingSignalPool() {
+  for (auto signal : free_) {
+    signal->release();
+  }
+  ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Signal pool: created=%zu destroyed=%zu stalls=%zu",
+          stats_.created_, stats_.destroyed_, stats_.stalls_);
+}
+
+// ================================================================================================
+ProfilingSignal* ProfilingSignalPool::CreateSignal() const {
+  hsa_agent_t agent = dev_.getBackendDevice();
+  const Settings& settings = dev_.settings();
+  hsa_agent_t* agents = (settings.system_scope_signal_) ? nullptr : &agent;
+  uint32_t num_agents = (settings.system_scope_signal_) ? 0 : 1;
+
+  std::unique_ptr<ProfilingSignal> signal(new ProfilingSignal());
+  if ((signal == nullptr) ||
+      (HSA_STATUS_SUCCESS != hsa_signal_create(0, num_agents, agents, &signal->signal_))) {
+    return nullptr;
+  }
+  return signal.release();
+}
+
+// ================================================================================================
+bool ProfilingSignalPool::Fill(size_t count) {
+  amd::ScopedLock lock(lock_);
+  while (free_.size() < count) {
+    ProfilingSignal* signal = CreateSignal();
+    if (signal == nullptr) {
+      return false;
+    }
+    free_.push_back(signal);
+    stats_.created_++;
+  }
+  return true;
+}
+
+// ================================================================================================
+ProfilingSignal* ProfilingSignalPool::Acquire() {
+  {
+    amd::ScopedLock lock(lock_);
+    if (!free_.empty()) {
+      ProfilingSignal* signal = free_.back();
+      free_.pop_back();
+      return signal;
+    }
+    stats_.stalls_++;
+    stats_.created_++;
+  }
+  ClPrint(amd::LOG_DEBUG, amd::LOG_SIG, "Signal pool is empty, creating a signal in place");
+  return CreateSignal();
+}
+
+// ================================================================================================
+void ProfilingSignalPool::Release(ProfilingSignal* signal) {
+  // A marker still owns the signal or it's busy, so it can't be handed to another queue
+  if ((signal->referenceCount() > 1) || (signal->ts_ != nullptr) ||
+      (hsa_signal_load_relaxed(signal->signal_) > 0)) {
+    signal->release();
+    return;
+  }
+  {
+    amd::ScopedLock lock(lock_);
+    if (free_.size() < maxFree_) {
+      signal->flags_.done_ = true;
+      signal->flags_.forceHostWait_ = true;
+      signal->engine_ = HwQueueEngine::Compute;
+      signal->isPacketDispatch_ = false;
+      free_.push_back(signal);
+      return;
+    }
+    stats_.destroyed_++;
+  }
+  signal->release();
+}
+
+// ================================================================================================
+ProfilingSignalPool::Stats ProfilingSignalPool::GetStats() const {
+  amd::ScopedLock lock(lock_);
+  Stats stats = stats_;
+  stats.free_ = free_.size();
+  return stats;
+}
+
 #if defined(__clang__)
 #if __has_feature(address_sanitizer)
 device::UriLocator* Device::createUriLocator() const {
@@ -65,6 +65,7 @@ namespace amd::roc {
 
 //! Forward declarations
 class Command;
+class CompletionReaper;
 class Device;
 class GpuCommand;
 class Heap;
@@ -110,6 +111,46 @@ public:
   amd::Monitor& LockSignalOps() { return lock_; }
 };
 
+/*! \brief Device wide pool of idle profiling signals
+ *
+ *  The queues of a device take their completion signals from here and return them when they
+ *  shrink or go away, so signal creation stays off the submission path.
+ */
+class ProfilingSignalPool : public amd::HeapObject {
+ public:
+  struct Stats {
+    size_t free_;       //!< Signals currently in the pool
+    size_t created_;    //!< Signals created by the pool
+    size_t destroyed_;  //!< Signals destroyed because the pool was full
+    size_t stalls_;     //!< Acquires that found the pool empty and created a signal in place
+  };
+
+  ProfilingSignalPool(const Device& dev);
+  ~ProfilingSignalPool();
+
+  //! Creates signals until the pool holds at least count of them
+  bool Fill(size_t count);
+
+  //! Takes an idle signal from the pool, creates one if the pool is empty
+  ProfilingSignal* Acquire();
+
+  //! Returns an idle signal to the pool. Signals still referenced elsewhere are only released
+  void Release(ProfilingSignal* signal);
+
+  //! Returns the pool counters
+  Stats GetStats() const;
+
+ private:
+  //! Creates a new signal for the device
+  ProfilingSignal* CreateSignal() const;
+
+  const Device& dev_;                   //!< Device the signals belong to
+  mutable amd::Monitor lock_;           //!< Guards the free list and the counters
+  std::vector<ProfilingSignal*> free_;  //!< Idle signals
+  size_t maxFree_;                      //!< Limit of idle signals, the rest is destroyed
+  Stats stats_ = {};                    //!< Pool counters
+};
+
 class Sampler : public device::Sampler {
  public:
   //! Constructor
@@ -545,6 +586,15 @@ class Device : public NullDevice {
 
   VirtualGPU* xferQueue() const;
 
+  //! Returns the pool of idle profiling signals of the device
+  ProfilingSignalPool& SignalPool() const { return *signalPool_; }
+
+  //! Returns the completion reaper of the device, nullptr if the queues use HSA async handlers
+  CompletionReaper* Reaper() const { return reaper_; }
+
+  //! Rings the doorbells of the queues for the dispatches deferred before \a startedBefore
+  void FlushDoorbells(uint64_t startedBefore = std::numeric_limits<uint64_t>::max()) const;
+
   hsa_amd_memory_pool_t SystemSegment() const { return system_segment_; }
 
   hsa_amd_memory_pool_t SystemCoarseSegment() const { return system_coarse_segment_; }
@@ -637,6 +687,8 @@ class Device : public NullDevice {
   size_t alloc_granularity_;
   static constexpr bool offlineDevice_ = false;
   VirtualGPU* xferQueue_;  //!< Transfer queue, created on demand
+  ProfilingSignalPool* signalPool_;  //!< Idle completion signals shared by the queues
+  CompletionReaper* reaper_;         //!< Completes the commands of direct dispatch queues
 
   XferBuffers* xferRead_;   //!< Transfer buffers read
   XferBuffers* xferWrite_;  //!< Transfer buffers write
@@ -0,0 +1,139 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <cstdint>
+
+// Only the standard library is used here, so the batching policy can be built and tested on the
+// host with a mock queue and clock.
+namespace amd::roc {
+
+/*! \brief Doorbell batching policy of one AQL queue
+ *
+ *  Packets written into the queue may defer the doorbell. The deferred packets form a batch, which
+ *  is closed with a single doorbell write once it reaches the packet limit, once its oldest packet
+ *  waited for the time limit, or when the batch is flushed. A doorbell write for a packet that
+ *  can't be deferred covers the open batch as well.
+ *
+ *  Submit() and Flush() drive a Queue, which provides:
+ *    void WriteDoorbell(uint64_t index)  rings the doorbell of the AQL queue with \a index
+ *    void BatchOpened()  a packet was deferred and opened a batch
+ *    void BatchClosed()  the doorbell write closed the open batch
+ */
+class DoorbellBatch {
+ public:
+  /*! \brief Writes the doorbell for the packet at \a index, unless \a deferrable allows to defer
+   *  it and the batch has room
+   */
+  template <typename Queue>
+  void Submit(Queue& queue, uint64_t index, bool deferrable, uint64_t nowNs, uint32_t maxPackets,
+              uint64_t maxDelayNs) {
+    const bool open = !Empty();
+    if (deferrable) {
+      if (Defer(index, nowNs, maxPackets, maxDelayNs)) {
+        if (!open) {
+          queue.BatchOpened();
+        }
+        return;
+      }
+    } else {
+      Ring();
+    }
+    // The doorbell write covers all packets up to the index, including the deferred ones
+    queue.WriteDoorbell(index);
+    if (open) {
+      queue.BatchClosed();
+    }
+  }
+
+  //! Writes the doorbell for the batch if it was opened before \a startedBefore
+  template <typename Queue> void Flush(Queue& queue, uint64_t startedBefore) {
+    uint64_t index = 0;
+    if (Flush(startedBefore, &index)) {
+      queue.WriteDoorbell(index);
+      queue.BatchClosed();
+    }
+  }
+
+  /*! \brief Adds the packet at \a index to the batch
+   *
+   *  Returns true if the doorbell stays deferred. Returns false if the batch is full or expired,
+   *  the caller must then ring the doorbell with \a index.
+   */
+  bool Defer(uint64_t index, uint64_t nowNs, uint32_t maxPackets, uint64_t maxDelayNs) {
+    if (count_ == 0) {
+      startNs_ = nowNs;
+    }
+    index_ = index;
+    count_++;
+    packets_++;
+    if ((count_ < maxPackets) && ((nowNs - startNs_) < maxDelayNs)) {
+      return true;
+    }
+    Close();
+    return false;
+  }
+
+  //! Records a doorbell write for a packet, which wasn't deferred. Closes the open batch
+  void Ring() {
+    packets_++;
+    Close();
+  }
+
+  /*! \brief Closes the batch if it was opened before \a startedBefore
+   *
+   *  Returns true and the index for the doorbell write if the batch was closed.
+   */
+  bool Flush(uint64_t startedBefore, uint64_t* index) {
+    if ((count_ == 0) || (startNs_ >= startedBefore)) {
+      return false;
+    }
+    *index = index_;
+    Close();
+    return true;
+  }
+
+  //! Returns true if no packets wait for the doorbell
+  bool Empty() const { return count_ == 0; }
+
+  //! Returns the number of packets written into the queue
+  uint64_t Packets() const { return packets_; }
+
+  //! Returns the number of doorbell writes
+  uint64_t Doorbells() const { return doorbells_; }
+
+  //! Returns the number of doorbell writes saved by batching
+  uint64_t Saved() const { return packets_ - doorbells_; }
+
+ private:
+  void Close() {
+    count_ = 0;
+    doorbells_++;
+  }
+
+  uint64_t index_ = 0;      //!< The last deferred packet
+  uint64_t startNs_ = 0;    //!< Time the oldest deferred packet was written
+  uint32_t count_ = 0;      //!< The number of deferred packets
+  uint64_t packets_ = 0;    //!< Written packets
+  uint64_t doorbells_ = 0;  //!< Doorbell writes
+};
+
+}  // namespace amd::roc
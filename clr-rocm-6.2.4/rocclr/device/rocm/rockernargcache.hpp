@@ -0,0 +1,126 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Only the standard library is used here, so the cache can be built and tested on the host.
+namespace amd::roc {
+
+/*! \brief Kernel argument blocks of recent launches on a queue
+ *
+ *  A launch with the same kernel and byte-identical arguments as a recent one may reuse the
+ *  kernarg block of that launch, which is already written and visible to the device. Entries
+ *  belong to an epoch. The queue starts a new epoch whenever a block of the current epoch may be
+ *  overwritten, which invalidates all entries at once.
+ *
+ *  The cache is direct mapped on the argument hash. A host copy of the arguments confirms a hit,
+ *  so a hash collision can't return a wrong block.
+ */
+class KernArgCache {
+ public:
+  //! Creates a cache with \a entries slots, 0 disables the cache
+  explicit KernArgCache(size_t entries = 0) : entries_(entries) {}
+
+  //! Returns true if the cache has slots
+  bool Enabled() const { return !entries_.empty(); }
+
+  /*! \brief Returns the block of an identical launch in the current epoch or nullptr
+   *
+   *  \a hash receives the argument hash for a following Insert()
+   */
+  void* Find(uint64_t kernel, const void* args, size_t size, uint64_t* hash) {
+    *hash = Hash(kernel, args, size);
+    const Entry& entry = entries_[*hash % entries_.size()];
+    if ((entry.block_ != nullptr) && (entry.epoch_ == epoch_) && (entry.hash_ == *hash) &&
+        (entry.kernel_ == kernel) && (entry.args_.size() == size) &&
+        (memcmp(entry.args_.data(), args, size) == 0)) {
+      hits_++;
+      return entry.block_;
+    }
+    misses_++;
+    return nullptr;
+  }
+
+  //! Records \a block as the kernarg block of a launch in the current epoch
+  void Insert(uint64_t kernel, const void* args, size_t size, uint64_t hash, void* block) {
+    Entry& entry = entries_[hash % entries_.size()];
+    entry.kernel_ = kernel;
+    entry.hash_ = hash;
+    entry.epoch_ = epoch_;
+    entry.block_ = block;
+    entry.args_.assign(static_cast<const uint8_t*>(args),
+                       static_cast<const uint8_t*>(args) + size);
+  }
+
+  //! Invalidates all entries, the blocks of the current epoch may be overwritten
+  void Invalidate() {
+    epoch_++;
+    invalidations_++;
+  }
+
+  //! Returns the number of launches, which reused a block
+  uint64_t Hits() const { return hits_; }
+
+  //! Returns the number of launches, which needed a new block
+  uint64_t Misses() const { return misses_; }
+
+  //! Returns the number of invalidations
+  uint64_t Invalidations() const { return invalidations_; }
+
+  //! Hashes the kernel and its arguments, 8 bytes at a time
+  static uint64_t Hash(uint64_t kernel, const void* args, size_t size) {
+    constexpr uint64_t kPrime = 0x100000001b3ull;
+    uint64_t hash = (0xcbf29ce484222325ull ^ kernel) * kPrime;
+    const uint8_t* data = static_cast<const uint8_t*>(args);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data + i, sizeof(word));
+      hash = (hash ^ word) * kPrime;
+      hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+      hash = (hash ^ data[i]) * kPrime;
+    }
+    return hash ^ size;
+  }
+
+ private:
+  struct Entry {
+    uint64_t kernel_ = 0;        //!< Kernel code handle
+    uint64_t hash_ = 0;          //!< Hash of the kernel and the arguments
+    uint64_t epoch_ = 0;         //!< Epoch of the block
+    void* block_ = nullptr;      //!< Kernarg block in the pool
+    std::vector<uint8_t> args_;  //!< Host copy of the arguments
+  };
+
+  std::vector<Entry> entries_;   //!< Direct mapped slots
+  uint64_t epoch_ = 1;           //!< Current epoch, entries of older epochs are invalid
+  uint64_t hits_ = 0;            //!< Launches, which reused a block
+  uint64_t misses_ = 0;          //!< Launches, which needed a new block
+  uint64_t invalidations_ = 0;   //!< Started epochs
+};
+
+}  // namespace amd::roc
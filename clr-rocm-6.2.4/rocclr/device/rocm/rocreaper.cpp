@@ -0,0 +1,242 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "top.hpp"
+#include "utils/flags.hpp"
+#include "utils/debug.hpp"
+#include "device/rocm/rocreaper.hpp"
+#include "device/rocm/rocvirtual.hpp"
+#include "device/rocm/rocdevice.hpp"
+
+#include "hsa/hsa_ext_amd.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+namespace amd::roc {
+
+// ================================================================================================
+CompletionReaper::CompletionReaper(const Device& dev)
+    : dev_(dev),
+      lock_("Completion Reaper Lock", true),
+      firing_(false),
+      terminate_(false),
+      doorbellBatches_(0),
+      polling_(false) {
+  doorbell_.handle = 0;
+}
+
+// ================================================================================================
+CompletionReaper::~CompletionReaper() {
+  if (doorbell_.handle == 0) {
+    return;
+  }
+  if (thread_.state() >= Thread::INITIALIZED) {
+    terminate_ = true;
+    Ring();
+    while (thread_.state() < Thread::FINISHED) {
+      amd::Os::yield();
+    }
+  }
+  hsa_signal_destroy(doorbell_);
+}
+
+// ================================================================================================
+bool CompletionReaper::Create() {
+  if (HSA_STATUS_SUCCESS != hsa_signal_create(0, 0, nullptr, &doorbell_)) {
+    doorbell_.handle = 0;
+    return false;
+  }
+  if (thread_.state() < Thread::INITIALIZED) {
+    return false;
+  }
+  thread_.start(this);
+  return true;
+}
+
+// ================================================================================================
+void CompletionReaper::Enqueue(const VirtualGPU* gpu, Timestamp* ts, hsa_signal_t signal,
+                               hsa_signal_value_t threshold) {
+  {
+    amd::ScopedLock lock(lock_);
+    queues_[gpu].Push({ts, signal, threshold}, amd::Os::timeNanos());
+  }
+  Ring();
+}
+
+// ================================================================================================
+//! Logs the completion latency histogram of a queue, which is removed
+static void LogHistogram(const VirtualGPU* gpu, const CompletionHistogram& histogram) {
+  std::stringstream buckets;
+  for (size_t i = 0; i < histogram.size(); ++i) {
+    if (histogram[i] != 0) {
+      buckets << " <" << (1ull << i) << "us:" << histogram[i];
+    }
+  }
+  ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Completion latency of queue %p:%s", gpu,
+          buckets.str().c_str());
+}
+
+// ================================================================================================
+void CompletionReaper::RemoveQueue(const VirtualGPU* gpu) {
+  if (amd::Thread::current() == &thread_) {
+    // A callback on the reaper thread can't wait for the reaper, so it completes the pending
+    // commands of the queue itself, in submission order
+    std::vector<Entry> pending;
+    {
+      amd::ScopedLock lock(lock_);
+      auto it = queues_.find(gpu);
+      if (it == queues_.end()) {
+        return;
+      }
+      it->second.Drain(&pending);
+      LogHistogram(gpu, it->second.GetHistogram());
+      queues_.erase(it);
+    }
+    for (const auto& entry : pending) {
+      hsa_signal_t waitSignal = {};
+      hsa_signal_value_t waitValue = 0;
+      while (!Probe(entry, &waitSignal, &waitValue)) {
+        hsa_signal_wait_scacquire(waitSignal, HSA_SIGNAL_CONDITION_LT, waitValue, UINT64_MAX,
+                                  HSA_WAIT_STATE_BLOCKED);
+      }
+      HsaAmdSignalComplete(hsa_signal_load_relaxed(entry.signal_), entry.ts_);
+    }
+    return;
+  }
+
+  amd::ScopedLock lock(lock_);
+  while (true) {
+    auto it = queues_.find(gpu);
+    if (it == queues_.end()) {
+      return;
+    }
+    if (it->second.Empty() && !firing_) {
+      LogHistogram(gpu, it->second.GetHistogram());
+      queues_.erase(it);
+      return;
+    }
+    Ring();
+    lock_.wait();
+  }
+}
+
+// ================================================================================================
+bool CompletionReaper::GetHistogram(const VirtualGPU* gpu, CompletionHistogram* histogram) const {
+  amd::ScopedLock lock(lock_);
+  auto it = queues_.find(gpu);
+  if (it == queues_.end()) {
+    return false;
+  }
+  *histogram = it->second.GetHistogram();
+  return true;
+}
+
+// ================================================================================================
+bool CompletionReaper::Probe(const Entry& entry, hsa_signal_t* waitSignal,
+                             hsa_signal_value_t* waitValue) {
+  if (hsa_signal_load_scacquire(entry.signal_) >= entry.threshold_) {
+    *waitSignal = entry.signal_;
+    *waitValue = entry.threshold_;
+    return false;
+  }
+  // Profiling may need the results of other commands in the batch
+  Timestamp* busyTs = nullptr;
+  if (HsaAmdSignalBusyBatch(entry.ts_, &busyTs)) {
+    *waitSignal = busyTs->Signals()[0]->signal_;
+    *waitValue = kInitSignalValueOne;
+    return false;
+  }
+  return true;
+}
+
+// ================================================================================================
+void CompletionReaper::Loop() {
+  std::vector<hsa_signal_t> signals;
+  std::vector<hsa_signal_condition_t> conditions;
+  std::vector<hsa_signal_value_t> values;
+  std::vector<Entry> done;
+
+  // The number of periodic wakeups without doorbell batches, before the reaper stops polling
+  constexpr uint32_t kIdlePolls = 64;
+  const uint64_t batchTimeout = std::max(ROC_DOORBELL_BATCH_US, 1u) * K;
+  uint32_t idlePolls = kIdlePolls;
+
+  while (!terminate_) {
+    // Read the doorbell first, so work added during the scan wakes up the wait below
+    hsa_signal_value_t doorbell = hsa_signal_load_scacquire(doorbell_);
+
+    // Clear the polling state before the batch count is read. A queue, which opens a batch
+    // afterwards, either sees no polling and rings the doorbell or is seen by the check below
+    uint64_t timeout = UINT64_MAX;
+    polling_ = false;
+    if (HasDoorbellBatches()) {
+      idlePolls = 0;
+      dev_.FlushDoorbells(amd::Os::timeNanos() - batchTimeout);
+    }
+    if (idlePolls < kIdlePolls) {
+      // Keep polling for a while, so back-to-back batches don't have to wake up the reaper
+      polling_ = true;
+      timeout = batchTimeout;
+      idlePolls++;
+    }
+    signals.assign(1, doorbell_);
+    conditions.assign(1, HSA_SIGNAL_CONDITION_NE);
+    values.assign(1, doorbell);
+    done.clear();
+
+    {
+      amd::ScopedLock lock(lock_);
+      uint64_t now = amd::Os::timeNanos();
+      for (auto& it : queues_) {
+        hsa_signal_t waitSignal = {};
+        hsa_signal_value_t waitValue = 0;
+        it.second.Reap([&](const Entry& entry) { return Probe(entry, &waitSignal, &waitValue); },
+                       now, &done);
+        if (!it.second.Empty()) {
+          signals.push_back(waitSignal);
+          conditions.push_back(HSA_SIGNAL_CONDITION_LT);
+          values.push_back(waitValue);
+        }
+      }
+      firing_ = !done.empty();
+    }
+
+    if (!done.empty()) {
+      ClPrint(amd::LOG_DEBUG, amd::LOG_SIG, "Reaper completes %zu commands", done.size());
+      for (const auto& entry : done) {
+        HsaAmdSignalComplete(hsa_signal_load_relaxed(entry.signal_), entry.ts_);
+      }
+      amd::ScopedLock lock(lock_);
+      firing_ = false;
+      lock_.notifyAll();
+      // Rescan right away, the callbacks could have submitted more work
+      continue;
+    }
+
+    hsa_signal_value_t value = 0;
+    hsa_amd_signal_wait_any(static_cast<uint32_t>(signals.size()), signals.data(),
+                            conditions.data(), values.data(), timeout,
+                            HSA_WAIT_STATE_BLOCKED, &value);
+  }
+}
+
+}  // namespace amd::roc
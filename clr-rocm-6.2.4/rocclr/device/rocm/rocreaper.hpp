@@ -0,0 +1,119 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+#include "thread/thread.hpp"
+#include "device/rocm/roccompletion.hpp"
+
+#include "hsa/hsa.h"
+
+#include <atomic>
+#include <map>
+
+namespace amd::roc {
+
+class Device;
+class Timestamp;
+class VirtualGPU;
+
+/*! \brief Runtime owned thread, which completes the commands of direct dispatch queues
+ *
+ *  The queues of a device hand their callback and marker signals to the reaper instead of
+ *  registering an HSA async handler per command. The reaper waits on the oldest pending signal of
+ *  every queue and processes all completed commands of a queue in one batch, in submission order.
+ *  While queues hold dispatches with a deferred doorbell, the reaper also wakes up periodically and
+ *  rings the doorbells of the batches, which waited longer than ROC_DOORBELL_BATCH_US.
+ */
+class CompletionReaper : public amd::HeapObject {
+ public:
+  CompletionReaper(const Device& dev);
+  ~CompletionReaper();
+
+  //! Creates the doorbell signal and starts the reaper thread
+  bool Create();
+
+  //! Tracks ts of gpu, which completes once signal drops below threshold
+  void Enqueue(const VirtualGPU* gpu, Timestamp* ts, hsa_signal_t signal,
+               hsa_signal_value_t threshold);
+
+  /*! \brief Waits until all commands of gpu are processed and stops tracking it
+   *
+   *  On the reaper thread, e.g. from a completion callback, the pending commands of gpu are
+   *  waited for and completed by the caller, since the reaper can't process them meanwhile.
+   */
+  void RemoveQueue(const VirtualGPU* gpu);
+
+  //! Copies the completion latency histogram of gpu, returns false if gpu isn't tracked
+  bool GetHistogram(const VirtualGPU* gpu, CompletionHistogram* histogram) const;
+
+  //! A queue deferred the doorbell of a dispatch and opened a batch
+  void DoorbellBatchOpened() {
+    doorbellBatches_++;
+    if (!polling_) {
+      Ring();
+    }
+  }
+
+  //! A queue rang the doorbell for its batch
+  void DoorbellBatchClosed() { doorbellBatches_--; }
+
+  //! Returns true if any queue defers a doorbell
+  bool HasDoorbellBatches() const { return doorbellBatches_ > 0; }
+
+ private:
+  //! Pending completion of a command
+  struct Entry {
+    Timestamp* ts_;                  //!< Timestamp of the command
+    hsa_signal_t signal_;            //!< Signal of the command
+    hsa_signal_value_t threshold_;   //!< The command is done, once the signal is below
+  };
+
+  class Thread : public amd::Thread {
+   public:
+    Thread() : amd::Thread("Completion Reaper Thread", CQ_THREAD_STACK_SIZE) {}
+
+    //! The reaper thread entry point
+    void run(void* data) { reinterpret_cast<CompletionReaper*>(data)->Loop(); }
+  };
+
+  //! Reaper main loop, runs until the reaper is destroyed
+  void Loop();
+
+  //! Returns true if entry is done, otherwise the signal and value to wait for
+  static bool Probe(const Entry& entry, hsa_signal_t* waitSignal, hsa_signal_value_t* waitValue);
+
+  //! Wakes up the reaper thread
+  void Ring() { hsa_signal_add_screlease(doorbell_, 1); }
+
+  const Device& dev_;                                            //!< Device of the queues
+  mutable amd::Monitor lock_;                                    //!< Guards queues_ and firing_
+  std::map<const VirtualGPU*, CompletionQueue<Entry>> queues_;   //!< Pending commands per queue
+  bool firing_;                 //!< The reaper thread processes completed commands
+  volatile bool terminate_;     //!< The reaper thread must exit
+  hsa_signal_t doorbell_;       //!< Incremented for new work and termination
+  std::atomic<uint32_t> doorbellBatches_;  //!< The number of queues with a deferred doorbell
+  std::atomic<bool> polling_;   //!< The reaper wakes up periodically for the doorbell batches
+  Thread thread_;               //!< The reaper thread
+};
+
+}  // namespace amd::roc
@@ -25,6 +25,7 @@
 #include "device/rocm/rocmemory.hpp"
 #include "device/rocm/rocblit.hpp"
 #include "device/rocm/roccounters.hpp"
+#include "device/rocm/rocreaper.hpp"
 #include "platform/activity.hpp"
 #include "platform/kernel.hpp"
 #include "platform/context.hpp"
@@ -179,15 +180,7 @@ void Timestamp::checkGpuTime() {
 }
 
 // ================================================================================================
-bool HsaAmdSignalHandler(hsa_signal_value_t value, void* arg) {
-  Timestamp* ts = reinterpret_cast<Timestamp*>(arg);
-
-  amd::Thread* thread = amd::Thread::current();
-  if (!(thread != nullptr ||
-      ((thread = new amd::HostThread()) != nullptr && thread == amd::Thread::current()))) {
-    return false;
-  }
-
+bool HsaAmdSignalBusyBatch(Timestamp* ts, Timestamp** busyTs) {
   if (amd::activity_prof::IsEnabled(OP_ID_DISPATCH)) {
     amd::Command* head = ts->getParsedCommand();
     if (head == nullptr) {
@@ -200,18 +193,9 @@ bool HsaAmdSignalHandler(hsa_signal_value_t value, void* arg) {
           ts->setParsedCommand(head);
           for (auto it : headTs->Signals()) {
             hsa_signal_value_t complete_val = (headTs->GetCallbackSignal().handle != 0) ? 1 : 0;
-            if (int64_t val = hsa_signal_load_relaxed(it->signal_) > complete_val) {
-              hsa_status_t result = hsa_amd_signal_async_handler(headTs->Signals()[0]->signal_,
-                                  HSA_SIGNAL_CONDITION_LT, kInitSignalValueOne,
-                                  &HsaAmdSignalHandler, ts);
-              if (HSA_STATUS_SUCCESS != result) {
-                LogError("hsa_amd_signal_async_handler() failed to requeue the handler!");
-              } else {
-                ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Requeue handler : value(%d), timestamp(%p),"
-                        "handle(0x%lx)", static_cast<uint32_t>(val), headTs,
-                        headTs->HwProfiling() ? headTs->Signals()[0]->signal_.handle : 0);
-              }
-              return false;
+            if (hsa_signal_load_relaxed(it->signal_) > complete_val) {
+              *busyTs = headTs;
+              return true;
             }
           }
         }
@@ -219,8 +203,13 @@ bool HsaAmdSignalHandler(hsa_signal_value_t value, void* arg) {
       head = head->getNext();
     }
   }
+  return false;
+}
+
+// ================================================================================================
+void HsaAmdSignalComplete(hsa_signal_value_t value, Timestamp* ts) {
   ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Handler: value(%d), timestamp(%p), handle(0x%lx)",
-    static_cast<uint32_t>(value), arg, ts->HwProfiling() ? ts->Signals()[0]->signal_.handle : 0);
+    static_cast<uint32_t>(value), ts, ts->HwProfiling() ? ts->Signals()[0]->signal_.handle : 0);
 
   // Save callback signal
   hsa_signal_t callback_signal = ts->GetCallbackSignal();
@@ -235,6 +224,33 @@ bool HsaAmdSignalHandler(hsa_signal_value_t value, void* arg) {
   if (callback_signal.handle != 0) {
     hsa_signal_subtract_relaxed(callback_signal, 1);
   }
+}
+
+// ================================================================================================
+bool HsaAmdSignalHandler(hsa_signal_value_t value, void* arg) {
+  Timestamp* ts = reinterpret_cast<Timestamp*>(arg);
+
+  amd::Thread* thread = amd::Thread::current();
+  if (!(thread != nullptr ||
+      ((thread = new amd::HostThread()) != nullptr && thread == amd::Thread::current()))) {
+    return false;
+  }
+
+  Timestamp* headTs = nullptr;
+  if (HsaAmdSignalBusyBatch(ts, &headTs)) {
+    hsa_status_t result = hsa_amd_signal_async_handler(headTs->Signals()[0]->signal_,
+                        HSA_SIGNAL_CONDITION_LT, kInitSignalValueOne,
+                        &HsaAmdSignalHandler, ts);
+    if (HSA_STATUS_SUCCESS != result) {
+      LogError("hsa_amd_signal_async_handler() failed to requeue the handler!");
+    } else {
+      ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Requeue handler : timestamp(%p), handle(0x%lx)",
+              headTs, headTs->HwProfiling() ? headTs->Signals()[0]->signal_.handle : 0);
+    }
+    return false;
+  }
+
+  HsaAmdSignalComplete(value, ts);
 
   // Return false, so the callback will not be called again for this signal
   return false;
@@ -350,66 +366,124 @@ void VirtualGPU::MemoryDependency::clear(bool all) {
 
 // ================================================================================================
 VirtualGPU::HwQueueTracker::~HwQueueTracker() {
-  for (auto& signal: signal_list_) {
-    CpuWaitForSignal(signal);
-    signal->release();
+  ProfilingSignalPool& pool = gpu_.dev().SignalPool();
+  for (auto& slot : ring_) {
+    CpuWaitForSignal(slot.signal_);
+    pool.Release(slot.signal_);
   }
+  ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Signal ring: size=%zu growths=%zu shrinks=%zu stalls=%zu",
+          ring_.size(), growths_, shrinks_, stalls_);
 }
 
 // ================================================================================================
 bool VirtualGPU::HwQueueTracker::Create() {
-  uint kSignalListSize = ROC_SIGNAL_POOL_SIZE;
+  ProfilingSignalPool& pool = gpu_.dev().SignalPool();
+  minSize_ = std::max(ROC_SIGNAL_POOL_SIZE, 2U);
 
-  signal_list_.resize(kSignalListSize);
+  ring_.resize(minSize_);
+  for (auto& slot : ring_) {
+    slot.signal_ = pool.Acquire();
+    if (slot.signal_ == nullptr) {
+      return false;
+    }
+  }
+  // Refill the device pool for the next queue, while the queue isn't used yet
+  pool.Fill(minSize_);
+  return true;
+}
 
-  hsa_agent_t agent = gpu_.gpu_device();
-  const Settings& settings = gpu_.dev().settings();
-  hsa_agent_t* agents = (settings.system_scope_signal_) ? nullptr : &agent;
-  uint32_t num_agents = (settings.system_scope_signal_) ? 0 : 1;
+// ================================================================================================
+bool VirtualGPU::HwQueueTracker::Grow() {
+  ProfilingSignalPool& pool = gpu_.dev().SignalPool();
+  size_t size = ring_.size();
+  size_t count = std::max<size_t>(size / 4, 2);
 
-  for (uint i = 0; i < kSignalListSize; ++i) {
-    std::unique_ptr<ProfilingSignal> signal(new ProfilingSignal());
-    if ((signal == nullptr) ||
-        (HSA_STATUS_SUCCESS != hsa_signal_create(0, num_agents, agents, &signal->signal_))) {
-      return false;
+  // Rotate the ring, so the oldest slot is first and the current slot is last. The new slots
+  // follow the current one and the submission order of the existing slots is preserved.
+  std::vector<SignalSlot> ring;
+  ring.reserve(size + count);
+  for (size_t i = 1; i <= size; ++i) {
+    ring.push_back(ring_[(current_id_ + i) % size]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    SignalSlot slot;
+    slot.signal_ = pool.Acquire();
+    if (slot.signal_ == nullptr) {
+      break;
     }
-    signal_list_[i] = signal.release();
+    ring.push_back(slot);
+  }
+  if (ring.size() == size) {
+    return false;
   }
+  ring_.swap(ring);
+  current_id_ = size - 1;
+  lastGrowth_ = generation_;
+  growths_++;
   return true;
 }
 
+// ================================================================================================
+void VirtualGPU::HwQueueTracker::Shrink() {
+  // Number of full ring turns without a growth, before the ring is considered idle
+  constexpr uint64_t kIdleTurns = 4;
+  size_t size = ring_.size();
+  if ((size <= minSize_) || ((generation_ - lastGrowth_) < kIdleTurns * size)) {
+    return;
+  }
+  // The slots that follow the current one are the oldest and are the ones to go.
+  // Keep everything if any of them is still in use.
+  size_t extra = size - minSize_;
+  for (size_t i = 1; i <= extra; ++i) {
+    const SignalSlot& slot = ring_[(current_id_ + i) % size];
+    if (hsa_signal_load_relaxed(slot.signal_->signal_) > 0) {
+      return;
+    }
+  }
+
+  ProfilingSignalPool& pool = gpu_.dev().SignalPool();
+  std::vector<SignalSlot> ring;
+  ring.reserve(minSize_);
+  for (size_t i = 1; i <= size; ++i) {
+    SignalSlot& slot = ring_[(current_id_ + i) % size];
+    if (i <= extra) {
+      CpuWaitForSignal(slot.signal_);
+      pool.Release(slot.signal_);
+    } else {
+      ring.push_back(slot);
+    }
+  }
+  ring_.swap(ring);
+  current_id_ = minSize_ - 1;
+  lastGrowth_ = generation_;
+  shrinks_++;
+  ClPrint(amd::LOG_DEBUG, amd::LOG_SIG, "Signal ring shrinks from %zu to %zu slots", size,
+          minSize_);
+}
+
 // ================================================================================================
 hsa_signal_t VirtualGPU::HwQueueTracker::ActiveSignal(
     hsa_signal_value_t init_val, Timestamp* ts, bool forceHostWait) {
   bool new_signal = false;
+  generation_++;
+  Shrink();
 
   // Peep signal +2 ahead to see if its done
-  auto temp_id = (current_id_ + 2) % signal_list_.size();
+  auto temp_id = (current_id_ + 2) % ring_.size();
   // If GPU is still busy with processing, then add more signals to avoid more frequent stalls
-  if (hsa_signal_load_relaxed(signal_list_[temp_id]->signal_) > 0) {
-    std::unique_ptr<ProfilingSignal> signal(new ProfilingSignal());
-    if (signal != nullptr) {
-      hsa_agent_t agent = gpu_.gpu_device();
-      const Settings& settings = gpu_.dev().settings();
-      hsa_agent_t* agents = (settings.system_scope_signal_) ? nullptr : &agent;
-      uint32_t num_agents = (settings.system_scope_signal_) ? 0 : 1;
-
-      if (HSA_STATUS_SUCCESS == hsa_signal_create(0, num_agents, agents, &signal->signal_)) {
-        // Find valid new index
-        ++current_id_ %= signal_list_.size();
-        // Insert the new signal into the current slot and ignore any wait
-        signal_list_.insert(signal_list_.begin() + current_id_, signal.release());
-        new_signal = true;
-      }
-    }
+  if (hsa_signal_load_relaxed(ring_[temp_id].signal_->signal_) > 0) {
+    new_signal = Grow();
   }
 
+  // Find valid index
+  ++current_id_ %= ring_.size();
+
   // If it's the new signal, then the wait can be avoided.
   // That will allow to grow the list of signals without stalls
   if (!new_signal) {
-    // Find valid index
-    ++current_id_ %= signal_list_.size();
-
+    if (hsa_signal_load_relaxed(ring_[current_id_].signal_->signal_) > 0) {
+      stalls_++;
+    }
     // Make sure the previous operation on the current signal is done
     WaitCurrent();
 
@@ -418,27 +492,20 @@ hsa_signal_t VirtualGPU::HwQueueTracker::ActiveSignal(
     WaitNext();
   }
 
-  if (signal_list_[current_id_]->referenceCount() > 1) {
+  SignalSlot& slot = ring_[current_id_];
+  if (slot.signal_->referenceCount() > 1) {
     // The signal was assigned to the global marker's event, hence runtime can't reuse it
     // and needs a new signal
-    std::unique_ptr<ProfilingSignal> signal(new ProfilingSignal());
+    ProfilingSignal* signal = gpu_.dev().SignalPool().Acquire();
     if (signal != nullptr) {
-      hsa_agent_t agent = gpu_.gpu_device();
-      const Settings& settings = gpu_.dev().settings();
-      hsa_agent_t* agents = (settings.system_scope_signal_) ? nullptr : &agent;
-      uint32_t num_agents = (settings.system_scope_signal_) ? 0 : 1;
-
-      if (HSA_STATUS_SUCCESS == hsa_signal_create(0, num_agents, agents, &signal->signal_)) {
-        signal_list_[current_id_]->release();
-        signal_list_[current_id_] = signal.release();
-      } else {
-        assert(!"ProfilingSignal reallocation failed! Marker has a conflict with signal reuse!");
-      }
+      slot.signal_->release();
+      slot.signal_ = signal;
     } else {
       assert(!"ProfilingSignal reallocation failed! Marker has a conflict with signal reuse!");
     }
   }
-  ProfilingSignal* prof_signal = signal_list_[current_id_];
+  slot.generation_ = generation_;
+  ProfilingSignal* prof_signal = slot.signal_;
   // Reset the signal and return
   hsa_signal_silent_store_relaxed(prof_signal->signal_, init_val);
   prof_signal->flags_.done_ = false;
@@ -467,13 +534,21 @@ hsa_signal_t VirtualGPU::HwQueueTracker::ActiveSignal(
           hsa_signal_add_relaxed(prof_signal->signal_, 1);
           init_value += 1;
         }
-        hsa_status_t result = hsa_amd_signal_async_handler(prof_signal->signal_,
-            HSA_SIGNAL_CONDITION_LT, init_value, &HsaAmdSignalHandler, ts);
-        if (HSA_STATUS_SUCCESS != result) {
-          LogError("hsa_amd_signal_async_handler() failed to set the handler!");
-        } else {
-          ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Set Handler: handle(0x%lx), timestamp(%p)",
+        CompletionReaper* reaper = gpu_.dev().Reaper();
+        if (reaper != nullptr) {
+          // The runtime's reaper thread completes the command in submission order
+          reaper->Enqueue(&gpu_, ts, prof_signal->signal_, init_value);
+          ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Reaper tracks: handle(0x%lx), timestamp(%p)",
             prof_signal->signal_.handle, prof_signal);
+        } else {
+          hsa_status_t result = hsa_amd_signal_async_handler(prof_signal->signal_,
+              HSA_SIGNAL_CONDITION_LT, init_value, &HsaAmdSignalHandler, ts);
+          if (HSA_STATUS_SUCCESS != result) {
+            LogError("hsa_amd_signal_async_handler() failed to set the handler!");
+          } else {
+            ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Set Handler: handle(0x%lx), timestamp(%p)",
+              prof_signal->signal_.handle, prof_signal);
+          }
         }
         SetHandlerPending(false);
         // Update the current command/marker with HW event
@@ -522,13 +597,13 @@ std::vector<hsa_signal_t>& VirtualGPU::HwQueueTracker::WaitingSignal(HwQueueEngi
     for (uint32_t i = 0; i < external_signals_.size(); ++i) {
       // If external signal matches internal one, then skip it
       if (external_signals_[i]->signal_.handle ==
-          signal_list_[current_id_]->signal_.handle) {
+          ring_[current_id_].signal_->signal_.handle) {
         skip_internal_signal = true;
       }
     }
     // Add the oldest signal into the tracking for a wait
     if (!skip_internal_signal) {
-      external_signals_.push_back(signal_list_[current_id_]);
+      external_signals_.push_back(ring_[current_id_].signal_);
     }
 
     // Validate all signals for the wait and skip already completed
@@ -559,6 +634,10 @@ std::vector<hsa_signal_t>& VirtualGPU::HwQueueTracker::WaitingSignal(HwQueueEngi
 
 // ================================================================================================
 bool VirtualGPU::HwQueueTracker::CpuWaitForSignal(ProfilingSignal* signal) {
+  // The HW can't make progress on the packets with a deferred doorbell. The signal may belong to
+  // another queue of the device
+  gpu_.flushDoorbell();
+  gpu_.dev().FlushDoorbells();
   // Wait for the current signal
   if (signal->ts_ != nullptr) {
     // Update timestamp values if requested
@@ -582,9 +661,9 @@ bool VirtualGPU::HwQueueTracker::CpuWaitForSignal(ProfilingSignal* signal) {
 // ================================================================================================
 void VirtualGPU::HwQueueTracker::ResetCurrentSignal() {
   // Reset the signal and return
-  hsa_signal_silent_store_relaxed(signal_list_[current_id_]->signal_, 0);
+  hsa_signal_silent_store_relaxed(ring_[current_id_].signal_->signal_, 0);
   // Fallback to the previous signal
-  current_id_ = (current_id_ == 0) ? (signal_list_.size() - 1) : (current_id_ - 1);
+  current_id_ = (current_id_ == 0) ? (ring_.size() - 1) : (current_id_ - 1);
 }
 
 // ================================================================================================
@@ -925,7 +1004,7 @@ bool VirtualGPU::dispatchGenericAqlPacket(
           reinterpret_cast<hsa_kernel_dispatch_packet_t*>(packet)->reserved2, read,
           index);
 
-  hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index);
+  ringDoorbell(index, std::is_same<AqlPacket, hsa_kernel_dispatch_packet_t>::value);
 
   // Mark the flag indicating if a dispatch is outstanding.
   // We are not waiting after every dispatch.
@@ -945,19 +1024,67 @@ bool VirtualGPU::dispatchGenericAqlPacket(
 }
 
 // ================================================================================================
-void VirtualGPU::dispatchBlockingWait() {
-  auto wait_signals = Barriers().WaitingSignal();
-  // AQL dispatch doesn't support dependent signals and extra barrier packet must be generated
-  for (uint32_t i = 0; i < wait_signals.size(); ++i) {
-    uint32_t j = i % 5;
-    barrier_packet_.dep_signal[j] = wait_signals[i];
-    constexpr bool kSkipSignal = true;
-    // If runtime reached the packet limit or the count limit, then flush the barrier
-    if ((j == 4) || ((i + 1) == wait_signals.size())) {
-      dispatchBarrierPacket(kNopPacketHeader, kSkipSignal);
+void VirtualGPU::ringDoorbell(uint64_t index, bool deferrable) {
+  if (!deferDoorbell_ && !batchDoorbell_) {
+    // Nothing is deferred, so there is no batch the reaper could flush concurrently
+    hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index);
+    return;
+  }
+  amd::ScopedLock lock(doorbellLock_);
+  // Keep the number of deferred packets well below the queue size, so the slot wait
+  // in the dispatch path can't stall on packets the HW hasn't seen yet
+  uint32_t maxPackets = gpu_queue_->size >> 1;
+  uint64_t maxDelay = std::numeric_limits<uint64_t>::max();
+  if (!deferDoorbell_) {
+    maxPackets = std::min(maxPackets, ROC_DOORBELL_BATCH);
+    maxDelay = ROC_DOORBELL_BATCH_US * K;
+  }
+  DoorbellQueue queue{*this};
+  doorbellBatch_.Submit(queue, index, deferrable && (deferDoorbell_ || batchDoorbell_),
+                        amd::Os::timeNanos(), maxPackets, maxDelay);
+}
+
+// ================================================================================================
+void VirtualGPU::flushDoorbell(uint64_t startedBefore) const {
+  amd::ScopedLock lock(doorbellLock_);
+  // The reaper's timed flushes leave dispatch batches to endDispatchBatch()
+  if ((startedBefore != std::numeric_limits<uint64_t>::max()) && !doorbellBatchTracked_) {
+    return;
+  }
+  DoorbellQueue queue{*this};
+  doorbellBatch_.Flush(queue, startedBefore);
+}
+
+// ================================================================================================
+bool VirtualGPU::completionHistogram(CompletionHistogram* histogram) const {
+  CompletionReaper* reaper = roc_device_.Reaper();
+  return (reaper != nullptr) && reaper->GetHistogram(this, histogram);
+}
+
+// ================================================================================================
+void VirtualGPU::trackDoorbellBatch(bool open) const {
+  if (open) {
+    // A dispatch batch is closed by endDispatchBatch(), only ROC_DOORBELL_BATCH needs the
+    // time limit of the reaper
+    doorbellBatchTracked_ = batchDoorbell_ && !deferDoorbell_;
+    if (doorbellBatchTracked_) {
+      roc_device_.Reaper()->DoorbellBatchOpened();
     }
+  } else if (doorbellBatchTracked_) {
+    doorbellBatchTracked_ = false;
+    roc_device_.Reaper()->DoorbellBatchClosed();
   }
 }
+
+// ================================================================================================
+void VirtualGPU::dispatchBlockingWait() {
+  auto wait_signals = Barriers().WaitingSignal();
+  // AQL dispatch doesn't support dependent signals and extra barrier packet must be generated.
+  // The signals, which are done already, don't need a packet
+  BarrierQueue queue{*this};
+  barrierCoalescer_.Wait(queue, wait_signals.data(), wait_signals.size());
+}
+
 // ================================================================================================
 bool VirtualGPU::dispatchAqlPacket(hsa_kernel_dispatch_packet_t* packet, uint16_t header,
                                    uint16_t rest, bool blocking, bool capturing,
@@ -1028,37 +1155,37 @@ bool VirtualGPU::dispatchCounterAqlPacket(hsa_ext_amd_aql_pm4_packet_t* packet,
 // ================================================================================================
 void VirtualGPU::dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal,
                                        hsa_signal_t signal) {
-  const uint32_t queueSize = gpu_queue_->size;
-  const uint32_t queueMask = queueSize - 1;
-
+  BarrierQueue queue{*this};
   if (!skipSignal) {
     // Make sure the wait is issued before queue index reservation
     auto wait_signals = Barriers().WaitingSignal();
-    for (uint32_t i = 0; i < wait_signals.size(); ++i) {
-      uint32_t j = i % 5;
-      barrier_packet_.dep_signal[j] = wait_signals[i];
-      constexpr bool kSkipSignal = true;
-      // If runtime reached the packet limit and signals left, then flush the barrier
-      if ((j == 4) && ((i + 1) < wait_signals.size())) {
-        dispatchBarrierPacket(kNopPacketHeader, kSkipSignal);
-      }
-    }
+    barrierCoalescer_.Barrier(queue, packetHeader, wait_signals.data(), wait_signals.size(),
+                              [this]() {
+      // Get active signal for current dispatch if profiling is necessary
+      return Barriers().ActiveSignal(kInitSignalValueOne, timestamp_);
+    });
+  } else {
+    // Attach external signal to the packet
+    barrierCoalescer_.Barrier(queue, packetHeader, nullptr, 0, [signal]() { return signal; });
   }
+}
+
+// ================================================================================================
+void VirtualGPU::writeBarrierPacket(uint16_t packetHeader, const hsa_signal_t* deps,
+                                    hsa_signal_t completionSignal) {
+  const uint32_t queueSize = gpu_queue_->size;
+  const uint32_t queueMask = queueSize - 1;
+
+  for (uint32_t i = 0; i < BarrierCoalescer<hsa_signal_t>::kMaxDeps; ++i) {
+    barrier_packet_.dep_signal[i] = deps[i];
+  }
+  barrier_packet_.completion_signal = completionSignal;
 
   uint64_t index = hsa_queue_add_write_index_screlease(gpu_queue_, 1);
-  uint64_t read = hsa_queue_load_read_index_relaxed(gpu_queue_);
 
   fence_dirty_ = true;
   auto cache_state = extractAqlBits(packetHeader, HSA_PACKET_HEADER_SCRELEASE_FENCE_SCOPE,
                          HSA_PACKET_HEADER_WIDTH_SCRELEASE_FENCE_SCOPE);
-  if (!skipSignal) {
-    // Get active signal for current dispatch if profiling is necessary
-    barrier_packet_.completion_signal =
-      Barriers().ActiveSignal(kInitSignalValueOne, timestamp_);
-  } else {
-    // Attach external signal to the packet
-    barrier_packet_.completion_signal = signal;
-  }
 
   // Reset fence_dirty_ and addSystemScope_ flag if we submit a barrier with system scopes
   if (cache_state == amd::Device::kCacheStateSystem) {
@@ -1072,7 +1199,7 @@ void VirtualGPU::dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal,
   *aql_loc = barrier_packet_;
   __atomic_store_n(reinterpret_cast<uint32_t*>(aql_loc), packetHeader, __ATOMIC_RELEASE);
 
-  hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index);
+  ringDoorbell(index);
   ClPrint(amd::LOG_DEBUG, amd::LOG_AQL,
           "SWq=0x%zx, HWq=0x%zx, id=%d, BarrierAND Header = 0x%x (type=%d, barrier=%d, acquire=%d,"
           " release=%d), "
@@ -1089,13 +1216,6 @@ void VirtualGPU::dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal,
           barrier_packet_.dep_signal[0], barrier_packet_.dep_signal[1],
           barrier_packet_.dep_signal[2], barrier_packet_.dep_signal[3],
           barrier_packet_.dep_signal[4], barrier_packet_.completion_signal);
-
-  // Clear dependent signals for the next packet
-  barrier_packet_.dep_signal[0] = hsa_signal_t{};
-  barrier_packet_.dep_signal[1] = hsa_signal_t{};
-  barrier_packet_.dep_signal[2] = hsa_signal_t{};
-  barrier_packet_.dep_signal[3] = hsa_signal_t{};
-  barrier_packet_.dep_signal[4] = hsa_signal_t{};
 }
 
 // ================================================================================================
@@ -1150,7 +1270,7 @@ void VirtualGPU::dispatchBarrierValuePacket(uint16_t packetHeader, bool resolveD
   *aql_loc = barrier_value_packet_;
   packet_store_release(reinterpret_cast<uint32_t*>(aql_loc), packetHeader, rest);
 
-  hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index);
+  ringDoorbell(index);
 
   ClPrint(amd::LOG_DEBUG, amd::LOG_AQL,
           "SWq=0x%zx, HWq=0x%zx, id=%d, BarrierValue Header = 0x%x AmdFormat = 0x%x "
@@ -1207,7 +1327,10 @@ VirtualGPU::VirtualGPU(Device& device, bool profiling, bool cooperative,
                        amd::CommandQueue::Priority priority)
     : device::VirtualDevice(device),
       state_(0),
+      doorbellLock_("Doorbell batch lock", true),
+      doorbellBatchTracked_(false),
       gpu_queue_(nullptr),
+      barrierCoalescer_(kNopPacketHeader),
       roc_device_(device),
       virtualQueue_(nullptr),
       deviceQueueSize_(0),
@@ -1218,6 +1341,7 @@ VirtualGPU::VirtualGPU(Device& device, bool profiling, bool cooperative,
       schedulerSignal_({0}),
       barriers_(*this),
       kernarg_pool_signal_(KernelArgPoolNumSignal),
+      kernargCache_(ROC_KERNARG_CACHE),
       cuMask_(cuMask),
       priority_(priority),
       copy_command_type_(0),
@@ -1273,11 +1397,37 @@ VirtualGPU::VirtualGPU(Device& device, bool profiling, bool cooperative,
 VirtualGPU::~VirtualGPU() {
   delete blitMgr_;
 
+  // Nothing may be left for the reaper's doorbell flushes
+  flushDoorbell();
+
   if (tracking_created_) {
     // Release the resources of signal
     releaseGpuMemoryFence();
   }
 
+  if (roc_device_.Reaper() != nullptr) {
+    // Wait for the reaper to complete the remaining commands of the queue
+    roc_device_.Reaper()->RemoveQueue(this);
+  }
+
+  if (doorbellBatch_.Packets() != 0) {
+    ClPrint(amd::LOG_INFO, amd::LOG_AQL, "Queue %p doorbells: %llu packets, %llu doorbell writes,"
+            " %llu saved by batching", this, doorbellBatch_.Packets(), doorbellBatch_.Doorbells(),
+            doorbellBatch_.Saved());
+  }
+
+  if (kernargCache_.Enabled()) {
+    ClPrint(amd::LOG_INFO, amd::LOG_KERN, "Queue %p kernarg cache: %llu hits, %llu misses,"
+            " %llu invalidations", this, kernargCache_.Hits(), kernargCache_.Misses(),
+            kernargCache_.Invalidations());
+  }
+
+  if (barrierCoalescer_.Requested() != 0) {
+    ClPrint(amd::LOG_INFO, amd::LOG_AQL, "Queue %p barrier packets: %llu requested, %llu written,"
+            " %llu saved by dropping dependencies", this, barrierCoalescer_.Requested(),
+            barrierCoalescer_.Emitted(), barrierCoalescer_.Saved());
+  }
+
   destroyPool();
 
   releasePinnedMem();
@@ -1327,6 +1477,9 @@ bool VirtualGPU::create() {
   gpu_queue_ = roc_device_.acquireQueue(queue_size, cooperative_, cuMask_, priority_);
   if (!gpu_queue_) return false;
 
+  // Batches across commands rely on the reaper to ring the doorbell of idle queues
+  batchDoorbell_ = (ROC_DOORBELL_BATCH > 1) && (roc_device_.Reaper() != nullptr);
+
   if (!initPool(dev().settings().kernargPoolSize_)) {
     LogError("Couldn't allocate arguments/signals for the queue");
     return false;
@@ -1420,6 +1573,8 @@ void* VirtualGPU::allocKernArg(size_t size, size_t alignment) {
     return result;
   } else {
     //! That means the app didn't call clFlush/clFinish for very long time.
+    // The next chunk gets reused, so cached blocks can't be handed out anymore
+    kernargCache_.Invalidate();
     // Reset the signal for the barrier packet
     hsa_signal_silent_store_relaxed(kernarg_pool_signal_[active_chunk_], kInitSignalValueOne);
     // Dispatch a barrier packet into the queue
@@ -2517,38 +2672,8 @@ void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
 
   if (type == ROCCLR_COMMAND_STREAM_WAIT_VALUE) {
     if (GPU_STREAMOPS_CP_WAIT) {
-      uint16_t header = kBarrierVendorPacketHeader;
       Buffer* buff = static_cast<Buffer*>(memory);
-      hsa_signal_t signal = buff->getSignal();
-
-      // mask is always applied on value at signal before performing
-      // the comparision defiend by 'condition'
-      switch (flags) {
-        case ROCCLR_STREAM_WAIT_VALUE_GTE: {
-          dispatchBarrierValuePacket(header, false, signal, value, mask,
-                                     HSA_SIGNAL_CONDITION_GTE, true);
-          break;
-        }
-        case ROCCLR_STREAM_WAIT_VALUE_EQ: {
-          dispatchBarrierValuePacket(header,false, signal, value, mask,
-                                     HSA_SIGNAL_CONDITION_EQ, true);
-          break;
-        }
-        case ROCCLR_STREAM_WAIT_VALUE_AND: {
-          dispatchBarrierValuePacket(header, false, signal, 0, (value & mask),
-                                     HSA_SIGNAL_CONDITION_NE, true);
-          break;
-        }
-        case ROCCLR_STREAM_WAIT_VALUE_NOR: {
-          uint64_t norValue = ~value & mask;
-          dispatchBarrierValuePacket(header, false, signal, norValue, norValue,
-                                    HSA_SIGNAL_CONDITION_NE, true);
-          break;
-        }
-        default:
-          ShouldNotReachHere();
-          break;
-      }
+      dispatchStreamWaitPacket(buff->getSignal(), value, mask, flags);
     }
     // Use a blit kernel to perform the wait operation
     else {
@@ -2580,6 +2705,90 @@ void VirtualGPU::submitStreamOperation(amd::StreamOperationCommand& cmd) {
   profilingEnd(cmd);
 }
 
+// ================================================================================================
+void VirtualGPU::dispatchStreamWaitPacket(hsa_signal_t signal, uint64_t value, uint64_t mask,
+                                          unsigned int flags) {
+  uint16_t header = kBarrierVendorPacketHeader;
+  // mask is always applied on value at signal before performing
+  // the comparision defiend by 'condition'
+  switch (flags) {
+    case ROCCLR_STREAM_WAIT_VALUE_GTE: {
+      dispatchBarrierValuePacket(header, false, signal, value, mask,
+                                 HSA_SIGNAL_CONDITION_GTE, true);
+      break;
+    }
+    case ROCCLR_STREAM_WAIT_VALUE_EQ: {
+      dispatchBarrierValuePacket(header, false, signal, value, mask,
+                                 HSA_SIGNAL_CONDITION_EQ, true);
+      break;
+    }
+    case ROCCLR_STREAM_WAIT_VALUE_AND: {
+      dispatchBarrierValuePacket(header, false, signal, 0, (value & mask),
+                                 HSA_SIGNAL_CONDITION_NE, true);
+      break;
+    }
+    case ROCCLR_STREAM_WAIT_VALUE_NOR: {
+      uint64_t norValue = ~value & mask;
+      dispatchBarrierValuePacket(header, false, signal, norValue, norValue,
+                                 HSA_SIGNAL_CONDITION_NE, true);
+      break;
+    }
+    default:
+      ShouldNotReachHere();
+      break;
+  }
+}
+
+// ================================================================================================
+void VirtualGPU::submitStreamBatchOperation(amd::StreamBatchOperationCommand& cmd) {
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+  profilingBegin(cmd);
+
+  const auto& ops = cmd.ops();
+  uint packets = 0;
+  uint dispatches = 0;
+  size_t idx = 0;
+  while (idx < ops.size()) {
+    // Waits on signal memory go straight to the CP as barrier-value packets
+    if (GPU_STREAMOPS_CP_WAIT && (ops[idx].type_ == ROCCLR_COMMAND_STREAM_WAIT_VALUE)) {
+      Buffer* buff = static_cast<Buffer*>(dev().getRocMemory(ops[idx].memory_));
+      dispatchStreamWaitPacket(buff->getSignal(), ops[idx].value_, ops[idx].mask_,
+                               ops[idx].flags_);
+      ++packets;
+      ++idx;
+      continue;
+    }
+
+    // Gather the following blit kernel operations into a single dispatch
+    size_t count = 0;
+    bool hasWrite = false;
+    while ((idx + count < ops.size()) && (count < KernelBlitManager::kMaxStreamOpsBatch)) {
+      const auto& op = ops[idx + count];
+      if (GPU_STREAMOPS_CP_WAIT && (op.type_ == ROCCLR_COMMAND_STREAM_WAIT_VALUE)) {
+        break;
+      }
+      hasWrite |= (op.type_ == ROCCLR_COMMAND_STREAM_WRITE_VALUE);
+      ++count;
+    }
+    if (hasWrite) {
+      // Ensure memory ordering preceding the writes
+      dispatchBarrierPacket(kBarrierPacketReleaseHeader);
+    }
+    bool result = static_cast<KernelBlitManager&>(blitMgr()).streamOpsBatch(&ops[idx], count);
+    if (!result) {
+      LogError("submitStreamBatchOperation: Batch failed!");
+    }
+    ++dispatches;
+    idx += count;
+  }
+
+  ClPrint(amd::LOG_INFO, amd::LOG_COPY, "Stream batch of %zu ops: %u wait packets, "
+          "%u kernel dispatches, %zu ops merged", ops.size(), packets, dispatches,
+          ops.size() - packets - dispatches);
+  profilingEnd(cmd);
+}
+
 // ================================================================================================
 void VirtualGPU::submitVirtualMap(amd::VirtualMapCommand& vcmd) {
   // Make sure VirtualGPU has an exclusive access to the resources
@@ -3227,31 +3436,49 @@ bool VirtualGPU::submitKernelInternal(const amd::NDRangeContainer& sizes,
 
     // Find all parameters for the current kernel
     if (!kernel.parameters().deviceKernelArgs() || gpuKernel.isInternalKernel()) {
-      // Allocate buffer to hold kernel arguments
-      if (isGraphCapture) {
-        argBuffer = vcmd->getKernArgOffset();
+      // An identical launch may have written a block, which is still visible to the device
+      const bool cacheArgs = !isGraphCapture && kernargCache_.Enabled() && (argSize != 0);
+      uint64_t argHash = 0;
+      address cachedArgs = nullptr;
+      if (cacheArgs) {
+        cachedArgs = reinterpret_cast<address>(kernargCache_.Find(
+            gpuKernel.KernelCodeHandle(), parameters, argSize, &argHash));
+      }
+
+      if (cachedArgs != nullptr) {
+        argBuffer = cachedArgs;
       } else {
+        // Allocate buffer to hold kernel arguments
+        if (isGraphCapture) {
+          argBuffer = vcmd->getKernArgOffset();
+        } else {
 
-        argBuffer = reinterpret_cast<address>(
-            allocKernArg(gpuKernel.KernargSegmentByteSize(),
-                         gpuKernel.KernargSegmentAlignment()));
-      }
+          argBuffer = reinterpret_cast<address>(
+              allocKernArg(gpuKernel.KernargSegmentByteSize(),
+                           gpuKernel.KernargSegmentAlignment()));
+        }
+
+        nontemporalMemcpy(argBuffer, parameters, argSize);
+
+        if (roc_device_.info().largeBar_ && !isGraphCapture) {
+          const auto kernArgImpl = dev().settings().kernel_arg_impl_;
+
+          if (kernArgImpl == KernelArgImpl::DeviceKernelArgsHDP) {
+            *dev().info().hdpMemFlushCntl = 1u;
+            auto kSentinel = *reinterpret_cast<volatile int*>(dev().info().hdpMemFlushCntl);
+          } else if (kernArgImpl == KernelArgImpl::DeviceKernelArgsReadback &&
+                     argSize != 0) {
+            _mm_sfence();
+            *(argBuffer + argSize - 1) = *(parameters + argSize - 1);
+            _mm_mfence();
+            auto kSentinel = *reinterpret_cast<volatile unsigned char*>(
+                argBuffer + argSize - 1);
+          }
+        }
 
-      nontemporalMemcpy(argBuffer, parameters, argSize);
-
-      if (roc_device_.info().largeBar_ && !isGraphCapture) {
-        const auto kernArgImpl = dev().settings().kernel_arg_impl_;
-
-        if (kernArgImpl == KernelArgImpl::DeviceKernelArgsHDP) {
-          *dev().info().hdpMemFlushCntl = 1u;
-          auto kSentinel = *reinterpret_cast<volatile int*>(dev().info().hdpMemFlushCntl);
-        } else if (kernArgImpl == KernelArgImpl::DeviceKernelArgsReadback &&
-                   argSize != 0) {
-          _mm_sfence();
-          *(argBuffer + argSize - 1) = *(parameters + argSize - 1);
-          _mm_mfence();
-          auto kSentinel = *reinterpret_cast<volatile unsigned char*>(
-              argBuffer + argSize - 1);
+        if (cacheArgs) {
+          kernargCache_.Insert(gpuKernel.KernelCodeHandle(), parameters, argSize, argHash,
+                               argBuffer);
         }
       }
     }
@@ -30,6 +30,10 @@
 #include "rocprintf.hpp"
 #include "hsa/hsa_ven_amd_aqlprofile.h"
 #include "rocsched.hpp"
+#include "rocbarrier.hpp"
+#include "roccompletion.hpp"
+#include "rocdoorbell.hpp"
+#include "rockernargcache.hpp"
 
 namespace amd::roc {
 class Device;
@@ -183,6 +187,12 @@ class Timestamp : public amd::ReferenceCountedObject {
   hsa_signal_t GetCallbackSignal() const { return callback_signal_; }
 };
 
+//! Finds a profiled command in the batch of ts that is still busy
+bool HsaAmdSignalBusyBatch(Timestamp* ts, Timestamp** busyTs);
+
+//! Processes the commands of ts on the host, once its signal is done
+void HsaAmdSignalComplete(hsa_signal_value_t value, Timestamp* ts);
+
 class VirtualGPU : public device::VirtualDevice {
  public:
   class MemoryDependency : public amd::EmbeddedObject {
@@ -236,7 +246,7 @@ class VirtualGPU : public device::VirtualDevice {
 
     //! Wait for the curent active signal. Can idle the queue
     bool WaitCurrent() {
-      ProfilingSignal* signal = signal_list_[current_id_];
+      ProfilingSignal* signal = ring_[current_id_].signal_;
       return CpuWaitForSignal(signal);
     }
 
@@ -257,7 +267,7 @@ class VirtualGPU : public device::VirtualDevice {
     }
 
     //! Get the last active signal on the queue
-    ProfilingSignal* GetLastSignal() const { return signal_list_[current_id_]; }
+    ProfilingSignal* GetLastSignal() const { return ring_[current_id_].signal_; }
 
     //! Clear external signals
     void ClearExternalSignals() { external_signals_.clear(); }
@@ -277,20 +287,46 @@ class VirtualGPU : public device::VirtualDevice {
       sdma_profiling_ = profile;
       hsa_amd_profiling_async_copy_enable(profile);
     }
+
+    //! Returns the number of signal slots in the ring
+    size_t RingSize() const { return ring_.size(); }
+
   private:
+    //! Signal slot of the ring
+    struct SignalSlot {
+      ProfilingSignal* signal_ = nullptr;  //!< Signal of the slot
+      uint64_t generation_ = 0;            //!< Submission that used the slot last
+    };
+
     //! Wait for the next active signal
     void WaitNext() {
-      size_t next = (current_id_ + 1) % signal_list_.size();
-      ProfilingSignal* signal = signal_list_[next];
+      size_t next = (current_id_ + 1) % ring_.size();
+      // A slot that was never submitted has nothing to wait for
+      if (ring_[next].generation_ == 0) {
+        return;
+      }
+      ProfilingSignal* signal = ring_[next].signal_;
       CpuWaitForSignal(signal);
     }
 
     //! Wait for the provided signal
     bool CpuWaitForSignal(ProfilingSignal* signal);
 
+    //! Adds idle slots from the device pool right after the current slot
+    bool Grow();
+
+    //! Returns the extra slots to the device pool once the ring stayed idle long enough
+    void Shrink();
+
     HwQueueEngine engine_ = HwQueueEngine::Unknown; //!< Engine used in the current operations
-    std::vector<ProfilingSignal*> signal_list_;     //!< The pool of all signals for processing
-    size_t current_id_ = 0;       //!< Last submitted signal
+    std::vector<SignalSlot> ring_;  //!< Ring of signal slots, in submission order
+    size_t current_id_ = 0;         //!< Last submitted slot
+    size_t minSize_ = 0;            //!< Size the ring shrinks back to
+    uint64_t generation_ = 0;       //!< Number of submissions on the ring
+    uint64_t lastGrowth_ = 0;       //!< Generation of the last growth
+    size_t growths_ = 0;            //!< Number of times the ring grew
+    size_t shrinks_ = 0;            //!< Number of times the ring shrank
+    size_t stalls_ = 0;             //!< Submissions that waited on a busy slot
     bool sdma_profiling_ = false; //!< If TRUE, then SDMA profiling is enabled
     const VirtualGPU& gpu_;       //!< VirtualGPU, associated with this tracker
     std::vector<ProfilingSignal*> external_signals_; //!< External signals for a wait in this queue
@@ -336,6 +372,7 @@ class VirtualGPU : public device::VirtualDevice {
   void flush(amd::Command* list = nullptr, bool wait = false);
   void submitFillMemory(amd::FillMemoryCommand& cmd);
   void submitStreamOperation(amd::StreamOperationCommand& cmd);
+  void submitStreamBatchOperation(amd::StreamBatchOperationCommand& cmd);
   void submitVirtualMap(amd::VirtualMapCommand& cmd);
   void submitMigrateMemObjects(amd::MigrateMemObjectsCommand& cmd);
 
@@ -418,7 +455,22 @@ class VirtualGPU : public device::VirtualDevice {
   bool isHandlerPending() const { return barriers_.IsHandlerPending(); }
 
   void* allocKernArg(size_t size, size_t alignment);
+
+  //! Defers the doorbell of kernel dispatches until endDispatchBatch()
+  void beginDispatchBatch() override { deferDoorbell_ = true; }
+  //! Rings the doorbell once for all dispatches deferred since beginDispatchBatch()
+  void endDispatchBatch() override {
+    flushDoorbell();
+    deferDoorbell_ = false;
+  }
+  //! Rings the doorbell for the dispatches deferred before \a startedBefore, if any
+  void flushDoorbell(uint64_t startedBefore = std::numeric_limits<uint64_t>::max()) const;
+
   bool isFenceDirty() const { return fence_dirty_; }
+  //! Returns the kernel argument cache of the queue
+  const KernArgCache& kernargCache() const { return kernargCache_; }
+  //! Copies the completion latency histogram of the queue, false without the completion reaper
+  bool completionHistogram(CompletionHistogram* histogram) const;
   void setLastUsedSdmaEngine(uint32_t mask) { lastUsedSdmaEngineMask_ = mask; }
   uint32_t getLastUsedSdmaEngine() const { return lastUsedSdmaEngineMask_.load(); }
   // } roc OpenCL integration
@@ -436,8 +488,35 @@ class VirtualGPU : public device::VirtualDevice {
   template <typename AqlPacket> bool dispatchGenericAqlPacket(AqlPacket* packet, uint16_t header,
                                                               uint16_t rest, bool blocking);
 
+  //! Rings the AQL queue doorbell or defers it, if a dispatch batch is open or batching is enabled
+  void ringDoorbell(uint64_t index, bool deferrable = false);
+  //! Reports an opened or closed ROC_DOORBELL_BATCH batch to the completion reaper
+  void trackDoorbellBatch(bool open) const;
+
+  //! AQL queue, which receives the doorbell writes of the doorbell batch
+  struct DoorbellQueue {
+    const VirtualGPU& gpu_;
+    void WriteDoorbell(uint64_t index) {
+      hsa_signal_store_screlease(gpu_.gpu_queue_->doorbell_signal, index);
+    }
+    void BatchOpened() { gpu_.trackDoorbellBatch(true); }
+    void BatchClosed() { gpu_.trackDoorbellBatch(false); }
+  };
+
   void dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal = false,
                              hsa_signal_t signal = hsa_signal_t{0});
+  //! Writes a barrier-AND packet assembled by the barrier coalescer into the queue
+  void writeBarrierPacket(uint16_t packetHeader, const hsa_signal_t* deps,
+                          hsa_signal_t completionSignal);
+
+  //! AQL queue, which receives the packets of the barrier coalescer
+  struct BarrierQueue {
+    VirtualGPU& gpu_;
+    bool IsSatisfied(hsa_signal_t signal) const { return hsa_signal_load_relaxed(signal) == 0; }
+    void Emit(uint16_t header, const hsa_signal_t* deps, hsa_signal_t completion) {
+      gpu_.writeBarrierPacket(header, deps, completion);
+    }
+  };
   bool dispatchCounterAqlPacket(hsa_ext_amd_aql_pm4_packet_t* packet, const uint32_t gfxVersion,
                                 bool blocking, const hsa_ven_amd_aqlprofile_1_00_pfn_t* extApi);
   void dispatchBarrierValuePacket(uint16_t packetHeader,
@@ -448,6 +527,9 @@ class VirtualGPU : public device::VirtualDevice {
                                   hsa_signal_condition32_t cond = HSA_SIGNAL_CONDITION_EQ,
                                   bool skipTs = false,
                                   hsa_signal_t completionSignal = hsa_signal_t{0});
+  //! Dispatches a barrier-value packet that blocks the queue until a stream wait condition holds
+  void dispatchStreamWaitPacket(hsa_signal_t signal, uint64_t value, uint64_t mask,
+                                unsigned int flags);
   void initializeDispatchPacket(hsa_kernel_dispatch_packet_t* packet,
                                 amd::NDRangeContainer& sizes);
 
@@ -455,6 +537,7 @@ class VirtualGPU : public device::VirtualDevice {
   void destroyPool();
 
   void resetKernArgPool() {
+    kernargCache_.Invalidate();
     kernarg_pool_cur_offset_ = 0;
     kernarg_pool_chunk_end_ = kernarg_pool_size_ / KernelArgPoolNumSignal;
     active_chunk_ = 0;
@@ -510,14 +593,21 @@ class VirtualGPU : public device::VirtualDevice {
       uint32_t addSystemScope_        : 1; //!< Insert a system scope to the next aql
       uint32_t tracking_created_      : 1; //!< Enabled if tracking object was properly initialized
       uint32_t retainExternalSignals_ : 1; //!< Indicate to retain external signal array
+      uint32_t deferDoorbell_         : 1; //!< Kernel dispatches defer the doorbell
+      uint32_t batchDoorbell_         : 1; //!< Kernel dispatches are batched by ROC_DOORBELL_BATCH
     };
     uint32_t  state_;
   };
 
+  mutable amd::Monitor doorbellLock_;    //!< Guards doorbellBatch_ against the reaper's flushes
+  mutable DoorbellBatch doorbellBatch_;  //!< Dispatches with a deferred doorbell
+  mutable bool doorbellBatchTracked_;    //!< The open doorbell batch is counted by the reaper
+
   Timestamp* timestamp_;
   hsa_agent_t gpu_device_;  //!< Physical device
   hsa_queue_t* gpu_queue_;  //!< Queue associated with a gpu
   hsa_barrier_and_packet_t barrier_packet_;
+  BarrierCoalescer<hsa_signal_t> barrierCoalescer_;  //!< Prunes barrier-AND dependencies
   hsa_amd_barrier_value_packet_t barrier_value_packet_;
 
   uint32_t dispatch_id_;  //!< This variable must be updated atomically.
@@ -547,6 +637,7 @@ class VirtualGPU : public device::VirtualDevice {
   uint32_t  kernarg_pool_cur_offset_;
   std::vector<hsa_signal_t> kernarg_pool_signal_; //!< Pool of HSA signals to manage
                                                   //!< multiple chunks
+  KernArgCache kernargCache_;     //!< Blocks of the active chunk, reusable by identical launches
 
   friend class Timestamp;
 
@@ -0,0 +1,184 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "os/numa.hpp"
+#include "thread/thread.hpp"
+#include "utils/flags.hpp"
+#include "utils/debug.hpp"
+
+#ifdef ROCCLR_SUPPORT_NUMA_POLICY
+#include <numa.h>
+#endif  // ROCCLR_SUPPORT_NUMA_POLICY
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace amd {
+
+namespace {
+
+class SystemNumaTopology : public NumaTopology {
+ public:
+  SystemNumaTopology() : numNodes_(1) {
+#ifdef ROCCLR_SUPPORT_NUMA_POLICY
+    available_ = (numa_available() >= 0);
+    if (available_) {
+      numNodes_ = std::max(numa_num_configured_nodes(), 1);
+    }
+#endif  // ROCCLR_SUPPORT_NUMA_POLICY
+  }
+
+  uint32_t numNodes() const { return numNodes_; }
+
+  bool nodeCpus(uint32_t node, Os::ThreadAffinityMask* mask) const {
+#ifdef ROCCLR_SUPPORT_NUMA_POLICY
+    if (!available_ || (node >= numNodes_)) {
+      return false;
+    }
+    bitmask* bm = numa_allocate_cpumask();
+    bool result = (numa_node_to_cpus(node, bm) == 0);
+    if (result) {
+      mask->init();
+      for (uint cpu = 0; cpu < bm->size; ++cpu) {
+        if (numa_bitmask_isbitset(bm, cpu)) {
+          mask->set(cpu);
+        }
+      }
+    }
+    numa_free_cpumask(bm);
+    return result;
+#else   // !ROCCLR_SUPPORT_NUMA_POLICY
+    (void)node;
+    (void)mask;
+    return false;
+#endif  // !ROCCLR_SUPPORT_NUMA_POLICY
+  }
+
+  bool allowedCpus(Os::ThreadAffinityMask* mask) const {
+#if defined(__linux__)
+    mask->init();
+    return (sched_getaffinity(0, sizeof(cpu_set_t), &mask->getNative()) == 0);
+#else   // !__linux__
+    return false;
+#endif  // !__linux__
+  }
+
+ private:
+  uint32_t numNodes_;       //!< Number of configured nodes
+  bool available_ = false;  //!< True if libnuma is usable
+};
+
+//! Parses a decimal number that spans [str, end), returns false on anything else
+bool ParseNumber(const char* str, const char* end, uint32_t* value) {
+  if (str == end) {
+    return false;
+  }
+  char* last = nullptr;
+  unsigned long number = strtoul(str, &last, 10);
+  if ((last != end) || (number > UINT32_MAX)) {
+    return false;
+  }
+  *value = static_cast<uint32_t>(number);
+  return true;
+}
+
+}  // namespace
+
+const NumaTopology& NumaTopology::system() {
+  // Never destroyed, the runtime may still place threads during process teardown
+  static const NumaTopology* topology = new SystemNumaTopology();
+  return *topology;
+}
+
+uint32_t NumaPlacement::resolveNode(const NumaTopology& topology, uint32_t ordinal,
+                                    uint32_t nearestNode, const char* nodeMap) {
+  if ((nodeMap == nullptr) || (nodeMap[0] == '\0')) {
+    return nearestNode;
+  }
+
+  const char* entry = nodeMap;
+  while (*entry != '\0') {
+    const char* end = strchr(entry, ',');
+    if (end == nullptr) {
+      end = entry + strlen(entry);
+    }
+    const char* colon = static_cast<const char*>(memchr(entry, ':', end - entry));
+    uint32_t device = 0;
+    uint32_t node = 0;
+    bool match = false;
+    if (colon == nullptr) {
+      // A bare node applies to every device
+      match = ParseNumber(entry, end, &node);
+    } else {
+      match = ParseNumber(entry, colon, &device) && ParseNumber(colon + 1, end, &node) &&
+              (device == ordinal);
+    }
+    if (match) {
+      if (node < topology.numNodes()) {
+        return node;
+      }
+      ClPrint(LOG_WARNING, LOG_INIT, "ROC_NUMA_NODE_MAP names node %u for device %u, but the "
+              "system has %u nodes", node, ordinal, topology.numNodes());
+      return nearestNode;
+    }
+    entry = (*end == ',') ? end + 1 : end;
+  }
+  return nearestNode;
+}
+
+bool NumaPlacement::threadMask(const NumaTopology& topology, uint32_t node,
+                               Os::ThreadAffinityMask* mask) {
+  Os::ThreadAffinityMask nodeMask;
+  if (!topology.nodeCpus(node, &nodeMask)) {
+    return false;
+  }
+  Os::ThreadAffinityMask allowed;
+  if (!topology.allowedCpus(&allowed)) {
+    *mask = nodeMask;
+    return !mask->isEmpty();
+  }
+  mask->init();
+  for (uint cpu = allowed.getFirstSet(); cpu != static_cast<uint>(-1);
+       cpu = allowed.getNextSet(cpu)) {
+    if (nodeMask.isSet(cpu)) {
+      mask->set(cpu);
+    }
+  }
+  return !mask->isEmpty();
+}
+
+bool NumaPlacement::bindThread(const Thread& thread, uint32_t node) {
+  if (!ROC_NUMA_PLACEMENT) {
+    return false;
+  }
+  Os::ThreadAffinityMask mask;
+  if (!threadMask(NumaTopology::system(), node, &mask)) {
+    ClPrint(LOG_INFO, LOG_INIT, "Thread %s keeps its affinity, no usable CPUs on NUMA node %u",
+            thread.name().c_str(), node);
+    return false;
+  }
+  thread.setAffinity(mask);
+  ClPrint(LOG_INFO, LOG_INIT, "Thread %s bound to %u CPUs of NUMA node %u",
+          thread.name().c_str(), mask.countSet(), node);
+  return true;
+}
+
+}  // namespace amd
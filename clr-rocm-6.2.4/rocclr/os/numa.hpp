@@ -0,0 +1,82 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef NUMA_HPP_
+#define NUMA_HPP_
+
+#include "top.hpp"
+#include "os/os.hpp"
+
+namespace amd {
+
+class Thread;
+
+/*! \brief NUMA layout of the host
+ *
+ *  The placement policy only sees the topology through this interface, so it can be driven by a
+ *  fake layout as well as by the running system.
+ */
+class NumaTopology {
+ public:
+  virtual ~NumaTopology() {}
+
+  //! Returns the number of NUMA nodes, at least 1
+  virtual uint32_t numNodes() const = 0;
+
+  //! Fills mask with the CPUs of node, returns false if they are unknown
+  virtual bool nodeCpus(uint32_t node, Os::ThreadAffinityMask* mask) const = 0;
+
+  //! Fills mask with the CPUs the process may run on, returns false if they are unknown
+  virtual bool allowedCpus(Os::ThreadAffinityMask* mask) const = 0;
+
+  //! Returns the topology of the running system
+  static const NumaTopology& system();
+};
+
+//! Decides the NUMA node used for the host resources of a device
+class NumaPlacement : public AllStatic {
+ public:
+  /*! \brief Resolves the NUMA node of a device
+   *
+   *  \param topology Host topology
+   *  \param ordinal rocclr device index, the position of the device among the registered GPUs
+   *  \param nearestNode Node with the shortest link distance to the device
+   *  \param nodeMap Override in the ROC_NUMA_NODE_MAP format: either a single node used for all
+   *         devices, or a comma separated list of "index:node" pairs
+   *  \return The node from nodeMap when it names a valid node for the device, else nearestNode
+   */
+  static uint32_t resolveNode(const NumaTopology& topology, uint32_t ordinal,
+                              uint32_t nearestNode, const char* nodeMap);
+
+  /*! \brief Builds the affinity mask for threads serving node
+   *
+   *  The CPUs of node are intersected with the CPUs the process may use, so an external
+   *  restriction (taskset, cgroups) is never widened. Returns false if the result is empty.
+   */
+  static bool threadMask(const NumaTopology& topology, uint32_t node,
+                         Os::ThreadAffinityMask* mask);
+
+  //! Binds thread to the CPUs of node when ROC_NUMA_PLACEMENT is enabled
+  static bool bindThread(const Thread& thread, uint32_t node);
+};
+
+}  // namespace amd
+
+#endif /*NUMA_HPP_*/
@@ -206,6 +206,11 @@ class Os : AllStatic {
   static void yield();
   //! Execute a pause instruction (for spin loops).
   static void spinPause();
+  //! Block while the shared word at addr holds expected, for at most timeoutNs.
+  //! The word may live in memory shared between processes.
+  static void waitOnAddress(volatile uint32_t* addr, uint32_t expected, uint64_t timeoutNs);
+  //! Wake all the threads and processes blocked in waitOnAddress() on addr
+  static void wakeOnAddress(volatile uint32_t* addr);
 
   // Memory routines:
   //
@@ -235,6 +240,18 @@ class Os : AllStatic {
   //! Platform-specific optimized memcpy()
   static void* fastMemcpy(void* dest, const void* src, size_t n);
 
+  /*! \brief Copies rows of rowSize bytes between two pitched 3D regions
+   *
+   *  Rows and slices that are contiguous on both sides are merged into single copies,
+   *  large regions of small rows are split between the host copy workers.
+   */
+  static void fastMemcpy3D(void* dest, size_t destRowPitch, size_t destSlicePitch,
+                           const void* src, size_t srcRowPitch, size_t srcSlicePitch,
+                           size_t rowSize, size_t rows, size_t slices);
+
+  //! Writes count consecutive copies of a pattern of patternSize bytes to dest
+  static void fastMemFill(void* dest, const void* pattern, size_t patternSize, size_t count);
+
   //! NUMA related settings
   static void setPreferredNumaNode(uint32_t node);
 
@@ -22,6 +22,8 @@
 
 #include "os/os.hpp"
 #include "thread/thread.hpp"
+#include "thread/threadpool.hpp"
+#include "thread/monitor.hpp"
 #include "utils/util.hpp"
 #include "utils/flags.hpp"
 
@@ -41,8 +43,13 @@
 #include <signal.h>
 
 #include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 #include <link.h>
+#if defined(ATI_ARCH_X86)
+#include <immintrin.h>
+#endif  // ATI_ARCH_X86
 #include <time.h>
 #ifndef DT_GNU_HASH
 #define DT_GNU_HASH 0x6ffffef5
@@ -428,6 +435,18 @@ bool Os::setThreadAffinityToMainThread() {
 
 void Os::yield() { ::sched_yield(); }
 
+void Os::waitOnAddress(volatile uint32_t* addr, uint32_t expected, uint64_t timeoutNs) {
+  struct timespec ts;
+  ts.tv_sec = timeoutNs / (1000ULL * 1000ULL * 1000ULL);
+  ts.tv_nsec = timeoutNs % (1000ULL * 1000ULL * 1000ULL);
+  // Not a private futex, since the word can be mapped by other processes
+  ::syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void Os::wakeOnAddress(volatile uint32_t* addr) {
+  ::syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
 uint64_t Os::timeNanos() {
   struct timespec tp;
   ::clock_gettime(CLOCK_MONOTONIC, &tp);
@@ -681,7 +700,311 @@ uint64_t Os::xgetbv(uint32_t ecx) {
 }
 #endif  // ATI_ARCH_X86
 
-void* Os::fastMemcpy(void* dest, const void* src, size_t n) { return memcpy(dest, src, n); }
+#if defined(ATI_ARCH_X86)
+// Copies n bytes with non-temporal stores, which keeps large copies from evicting the caller's
+// working set. The head is copied with memcpy until dest is cache line aligned.
+__attribute__((target("avx512f"))) static void streamCopyAvx512(char* dst, const char* src,
+                                                                size_t n) {
+  size_t head = (64 - (reinterpret_cast<uintptr_t>(dst) & 63)) & 63;
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  n -= head;
+  for (; n >= 256; n -= 256, dst += 256, src += 256) {
+    __m512i v0 = _mm512_loadu_si512(src);
+    __m512i v1 = _mm512_loadu_si512(src + 64);
+    __m512i v2 = _mm512_loadu_si512(src + 128);
+    __m512i v3 = _mm512_loadu_si512(src + 192);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst), v0);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 64), v1);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 128), v2);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 192), v3);
+  }
+  _mm_sfence();
+  memcpy(dst, src, n);
+}
+
+__attribute__((target("avx2"))) static void streamCopyAvx2(char* dst, const char* src, size_t n) {
+  size_t head = (32 - (reinterpret_cast<uintptr_t>(dst) & 31)) & 31;
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  n -= head;
+  for (; n >= 128; n -= 128, dst += 128, src += 128) {
+    __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+    __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 64));
+    __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 96));
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 32), v1);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 64), v2);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 96), v3);
+  }
+  _mm_sfence();
+  memcpy(dst, src, n);
+}
+
+// Fills n bytes with the pattern in block, using non-temporal stores of one broadcast vector.
+// The pattern size must divide 64 and block must hold the pattern repeated for at least
+// 128 bytes, so a vector can be loaded at any pattern phase.
+__attribute__((target("avx512f"))) static void streamFillAvx512(char* dst, const char* block,
+                                                                size_t patternSize, size_t n) {
+  size_t head = std::min((64 - (reinterpret_cast<uintptr_t>(dst) & 63)) & 63, n);
+  memcpy(dst, block, head);
+  const char* phase = block + (head % patternSize);
+  dst += head;
+  n -= head;
+  __m512i v = _mm512_loadu_si512(phase);
+  for (; n >= 256; n -= 256, dst += 256) {
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst), v);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 64), v);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 128), v);
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 192), v);
+  }
+  for (; n >= 64; n -= 64, dst += 64) {
+    _mm512_stream_si512(reinterpret_cast<__m512i*>(dst), v);
+  }
+  _mm_sfence();
+  memcpy(dst, phase, n);
+}
+
+__attribute__((target("avx2"))) static void streamFillAvx2(char* dst, const char* block,
+                                                           size_t patternSize, size_t n) {
+  size_t head = std::min((32 - (reinterpret_cast<uintptr_t>(dst) & 31)) & 31, n);
+  memcpy(dst, block, head);
+  const char* phase = block + (head % patternSize);
+  dst += head;
+  n -= head;
+  // Two vectors cover a full 64 byte period of the pattern
+  __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(phase));
+  __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(phase + 32));
+  for (; n >= 128; n -= 128, dst += 128) {
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 32), v1);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 64), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 96), v1);
+  }
+  for (; n >= 64; n -= 64, dst += 64) {
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst), v0);
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 32), v1);
+  }
+  _mm_sfence();
+  memcpy(dst, phase, n);
+}
+#endif  // ATI_ARCH_X86
+
+// Single threaded copy of one chunk, picks the widest streaming path the CPU supports
+static void hostCopyChunk(char* dst, const char* src, size_t n) {
+#if defined(ATI_ARCH_X86)
+  static const int simdLevel = __builtin_cpu_supports("avx512f") ? 2 :
+                               (__builtin_cpu_supports("avx2") ? 1 : 0);
+  if (n >= ROC_HOST_COPY_NT_THRESHOLD) {
+    if (simdLevel == 2) {
+      streamCopyAvx512(dst, src, n);
+      return;
+    } else if (simdLevel == 1) {
+      streamCopyAvx2(dst, src, n);
+      return;
+    }
+  }
+#endif  // ATI_ARCH_X86
+  memcpy(dst, src, n);
+}
+
+#ifdef ROCCLR_SUPPORT_NUMA_POLICY
+// Moves the calling copy worker onto the NUMA node that holds the destination pages,
+// so the stores of each chunk stay node local. Must only run on pool workers, the
+// caller of fastMemcpy() keeps its own affinity.
+static void bindCopyWorker(void* dst) {
+  static thread_local int boundNode = -1;
+  void* page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(dst) &
+                                       ~(static_cast<uintptr_t>(Os::pageSize()) - 1));
+  int node = -1;
+  if (numa_move_pages(0, 1, &page, nullptr, &node, 0) != 0 || node < 0 || node == boundNode) {
+    return;
+  }
+  if (numa_run_on_node(node) == 0) {
+    boundNode = node;
+  }
+}
+#endif  // ROCCLR_SUPPORT_NUMA_POLICY
+
+// Worker pool for large host copies, created on first use
+static ThreadPool* getHostCopyPool() {
+  static Monitor lock("Host copy pool lock");
+  static ThreadPool* pool = nullptr;
+  ScopedLock sl(lock);
+  if (pool == nullptr) {
+    pool = new ThreadPool("Host Copy", ROC_HOST_COPY_THREADS);
+  }
+  return pool;
+}
+
+void* Os::fastMemcpy(void* dest, const void* src, size_t n) {
+  if (n < ROC_HOST_COPY_NT_THRESHOLD) {
+    return memcpy(dest, src, n);
+  }
+  char* dst = reinterpret_cast<char*>(dest);
+  const char* source = reinterpret_cast<const char*>(src);
+  if (ROC_HOST_COPY_THREADS == 0 || n < ROC_HOST_COPY_MT_THRESHOLD) {
+    hostCopyChunk(dst, source, n);
+    return dest;
+  }
+
+  ThreadPool* pool = getHostCopyPool();
+  size_t numWorkers = (pool != nullptr) ? pool->numWorkers() : 0;
+  if (numWorkers < 2) {
+    hostCopyChunk(dst, source, n);
+    return dest;
+  }
+  // Split on page boundaries of the destination, so no two workers write the same page
+  const size_t page = pageSize();
+  size_t chunk = alignUp((n + numWorkers - 1) / numWorkers, page);
+  size_t numChunks = (n + chunk - 1) / chunk;
+#ifdef ROCCLR_SUPPORT_NUMA_POLICY
+  static const bool numaBind = (numa_available() >= 0) && (numa_max_node() > 0);
+#endif  // ROCCLR_SUPPORT_NUMA_POLICY
+  // A copy from another thread doesn't queue behind a running one, it copies on its own thread
+  pool->tryParallelFor(numChunks, [&](size_t i) {
+    size_t offset = i * chunk;
+    size_t size = std::min(chunk, n - offset);
+#ifdef ROCCLR_SUPPORT_NUMA_POLICY
+    if (numaBind && ThreadPool::isWorkerThread()) {
+      bindCopyWorker(dst + offset);
+    }
+#endif  // ROCCLR_SUPPORT_NUMA_POLICY
+    hostCopyChunk(dst + offset, source + offset, size);
+  });
+  return dest;
+}
+
+// Size of the host block, which holds the repeated fill pattern
+static constexpr size_t kFillBlockSize = 4 * Ki;
+
+// Single threaded fill of n bytes, starting at a pattern boundary. block holds the pattern
+// repeated for blockSize bytes, a multiple of the pattern size.
+static void hostFillChunk(char* dst, const char* block, size_t blockSize, size_t patternSize,
+                          size_t n) {
+#if defined(ATI_ARCH_X86)
+  static const int simdLevel = __builtin_cpu_supports("avx512f") ? 2 :
+                               (__builtin_cpu_supports("avx2") ? 1 : 0);
+  if ((n >= ROC_HOST_COPY_NT_THRESHOLD) && ((64 % patternSize) == 0)) {
+    if (simdLevel == 2) {
+      streamFillAvx512(dst, block, patternSize, n);
+      return;
+    } else if (simdLevel == 1) {
+      streamFillAvx2(dst, block, patternSize, n);
+      return;
+    }
+  }
+#endif  // ATI_ARCH_X86
+  for (; n >= blockSize; n -= blockSize, dst += blockSize) {
+    memcpy(dst, block, blockSize);
+  }
+  memcpy(dst, block, n);
+}
+
+void Os::fastMemFill(void* dest, const void* pattern, size_t patternSize, size_t count) {
+  const size_t n = patternSize * count;
+  if (n == 0) {
+    return;
+  }
+  char* dst = reinterpret_cast<char*>(dest);
+  const char* pat = reinterpret_cast<const char*>(pattern);
+  if (patternSize > kFillBlockSize / 2) {
+    for (size_t i = 0; i < count; ++i) {
+      fastMemcpy(dst + i * patternSize, pat, patternSize);
+    }
+    return;
+  }
+
+  // A pattern of identical bytes is a memset
+  bool uniform = true;
+  for (size_t i = 1; (i < patternSize) && uniform; ++i) {
+    uniform = (pat[i] == pat[0]);
+  }
+  if (uniform && (n < ROC_HOST_COPY_NT_THRESHOLD)) {
+    memset(dst, pat[0], n);
+    return;
+  }
+
+  // Build the block on the host by doubling the pattern, so the destination is never read back
+  alignas(64) char block[kFillBlockSize];
+  const size_t blockSize = (kFillBlockSize / patternSize) * patternSize;
+  memcpy(block, pat, patternSize);
+  for (size_t filled = patternSize; filled < blockSize; filled *= 2) {
+    memcpy(block + filled, block, std::min(filled, blockSize - filled));
+  }
+
+  ThreadPool* pool = ((ROC_HOST_COPY_THREADS != 0) && (n >= ROC_HOST_COPY_MT_THRESHOLD)) ?
+      getHostCopyPool() : nullptr;
+  size_t numWorkers = (pool != nullptr) ? pool->numWorkers() : 0;
+  if (numWorkers < 2) {
+    hostFillChunk(dst, block, blockSize, patternSize, n);
+    return;
+  }
+  // Split on pattern boundaries, so every chunk starts with the first byte of the pattern
+  size_t chunk = alignUp((n + numWorkers - 1) / numWorkers, pageSize());
+  chunk -= chunk % patternSize;
+  size_t numChunks = (n + chunk - 1) / chunk;
+  // Like fastMemcpy(), a fill doesn't wait for a copy from another thread to release the pool
+  pool->tryParallelFor(numChunks, [&](size_t i) {
+    size_t offset = i * chunk;
+    hostFillChunk(dst + offset, block, blockSize, patternSize, std::min(chunk, n - offset));
+  });
+}
+
+void Os::fastMemcpy3D(void* dest, size_t destRowPitch, size_t destSlicePitch, const void* src,
+                      size_t srcRowPitch, size_t srcSlicePitch, size_t rowSize, size_t rows,
+                      size_t slices) {
+  if ((rowSize == 0) || (rows == 0) || (slices == 0)) {
+    return;
+  }
+  // Merge the rows, then the slices, when they are contiguous on both sides
+  if ((rows > 1) && (destRowPitch == rowSize) && (srcRowPitch == rowSize)) {
+    rowSize *= rows;
+    rows = 1;
+  }
+  if ((rows == 1) && (slices > 1) && (destSlicePitch == rowSize) && (srcSlicePitch == rowSize)) {
+    rowSize *= slices;
+    slices = 1;
+  }
+  char* dst = reinterpret_cast<char*>(dest);
+  const char* source = reinterpret_cast<const char*>(src);
+  const size_t numRows = rows * slices;
+  if (numRows == 1) {
+    fastMemcpy(dst, source, rowSize);
+    return;
+  }
+
+  // Large rows are split by fastMemcpy itself, many small rows are split here
+  ThreadPool* pool = ((ROC_HOST_COPY_THREADS != 0) && (rowSize < ROC_HOST_COPY_MT_THRESHOLD) &&
+                      (rowSize * numRows >= ROC_HOST_COPY_MT_THRESHOLD)) ?
+      getHostCopyPool() : nullptr;
+  size_t numWorkers = (pool != nullptr) ? pool->numWorkers() : 0;
+  auto copyRows = [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      size_t slice = i / rows;
+      size_t row = i % rows;
+      char* d = dst + slice * destSlicePitch + row * destRowPitch;
+      const char* s = source + slice * srcSlicePitch + row * srcRowPitch;
+      if (numWorkers < 2) {
+        fastMemcpy(d, s, rowSize);
+      } else {
+        hostCopyChunk(d, s, rowSize);
+      }
+    }
+  };
+  if (numWorkers < 2) {
+    copyRows(0, numRows);
+    return;
+  }
+  size_t rowsPerChunk = (numRows + numWorkers - 1) / numWorkers;
+  size_t numChunks = (numRows + rowsPerChunk - 1) / rowsPerChunk;
+  pool->tryParallelFor(numChunks, [&](size_t i) {
+    copyRows(i * rowsPerChunk, std::min((i + 1) * rowsPerChunk, numRows));
+  });
+}
 
 uint64_t Os::offsetToEpochNanos() {
   static uint64_t offset = 0;
@@ -788,57 +1111,182 @@ bool Os::GetFileHandle(const char* fname, FileDesc* fd_ptr, size_t* sz_ptr) {
   return true;
 }
 
-bool amd::Os::FindFileNameFromAddress(const void* image, std::string* fname_ptr,
-                                      size_t* foffset_ptr) {
+namespace {
+
+// File backed address range of one PT_LOAD segment of a loaded ELF object
+struct MappedFileRange {
+  uintptr_t low_address;   //!< First address of the file backed part of the segment
+  uintptr_t high_address;  //!< One past the last file backed address
+  size_t file_offset;      //!< File offset of low_address
+  size_t name_index;       //!< Index of the object path in names_
+};
+
+// Sorted address to file table of all objects known to the dynamic loader. The loader's add and
+// remove counters are checked on every lookup, so the table is rebuilt only when a library was
+// loaded or unloaded since the last lookup.
+class MappedFileIndex {
+ public:
+  MappedFileIndex() : lock_("Mapped file index lock", true), adds_(0), subs_(0), valid_(false) {}
+
+  bool Find(uintptr_t address, std::string* fname_ptr, size_t* foffset_ptr) {
+    amd::ScopedLock sl(lock_);
+    LoaderCounters counters = {0, 0, false};
+    dl_iterate_phdr(ReadCounters, &counters);
+    if (!valid_ || !counters.valid || counters.adds != adds_ || counters.subs != subs_) {
+      Rebuild();
+      adds_ = counters.adds;
+      subs_ = counters.subs;
+      valid_ = counters.valid;
+    }
+
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), address,
+                               [](uintptr_t addr, const MappedFileRange& range) {
+                                 return addr < range.low_address;
+                               });
+    if (it == ranges_.begin()) {
+      return false;
+    }
+    --it;
+    if (address >= it->high_address) {
+      return false;
+    }
+    *fname_ptr = names_[it->name_index];
+    *foffset_ptr = it->file_offset + address - it->low_address;
+    return true;
+  }
+
+ private:
+  struct LoaderCounters {
+    unsigned long long adds;
+    unsigned long long subs;
+    bool valid;
+  };
+
+  static int ReadCounters(dl_phdr_info* info, size_t size, void* data) {
+    LoaderCounters* counters = reinterpret_cast<LoaderCounters*>(data);
+    if (size >= offsetof(dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+      counters->adds = info->dlpi_adds;
+      counters->subs = info->dlpi_subs;
+      counters->valid = true;
+    }
+    // The counters are the same for every object, stop after the first one
+    return 1;
+  }
+
+  static int Collect(dl_phdr_info* info, size_t size, void* data) {
+    MappedFileIndex* index = reinterpret_cast<MappedFileIndex*>(data);
+    // The main program reports an empty name, the vdso has no backing file
+    char path[PATH_MAX];
+    const char* name = info->dlpi_name;
+    if (name == nullptr || name[0] == '\0') {
+      ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+      if (len <= 0) {
+        return 0;
+      }
+      path[len] = '\0';
+    } else if (realpath(name, path) == nullptr) {
+      return 0;
+    }
+
+    size_t name_index = index->names_.size();
+    bool used = false;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+      const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+      if (phdr.p_type != PT_LOAD || phdr.p_filesz == 0) {
+        continue;
+      }
+      uintptr_t low_address = info->dlpi_addr + phdr.p_vaddr;
+      index->ranges_.push_back({low_address, low_address + phdr.p_filesz,
+                                static_cast<size_t>(phdr.p_offset), name_index});
+      used = true;
+    }
+    if (used) {
+      index->names_.push_back(path);
+    }
+    return 0;
+  }
+
+  void Rebuild() {
+    ranges_.clear();
+    names_.clear();
+    dl_iterate_phdr(Collect, this);
+    std::sort(ranges_.begin(), ranges_.end(),
+              [](const MappedFileRange& a, const MappedFileRange& b) {
+                return a.low_address < b.low_address;
+              });
+  }
+
+  amd::Monitor lock_;
+  std::vector<MappedFileRange> ranges_;
+  std::vector<std::string> names_;
+  unsigned long long adds_;  //!< Loader add counter when the table was built
+  unsigned long long subs_;  //!< Loader remove counter when the table was built
+  bool valid_;
+};
+
+// Scans /proc/self/maps for the mapping that holds address. Used for images the application
+// mapped itself, which the dynamic loader doesn't know about.
+bool FindFileNameInProcMaps(uintptr_t address, std::string* fname_ptr, size_t* foffset_ptr) {
+  FILE* proc_maps = fopen("/proc/self/maps", "r");
+  if (proc_maps == nullptr) {
+    return false;
+  }
 
-  // Get the list of mapped file list
   bool ret_value = false;
-  std::ifstream proc_maps;
-  proc_maps.open("/proc/self/maps", std::ifstream::in);
-  if (!proc_maps.is_open() || !proc_maps.good()) {
-    return ret_value;
-  }
-
-  // For every line on the list map find out low, high address
-  std::string line;
-  while (std::getline(proc_maps, line)) {
-    char dash;
-    std::stringstream tokens(line);
-    uintptr_t low_address, high_address;
-    tokens >> std::hex >> low_address >> std::dec
-           >> dash
-           >> std::hex >> high_address >> std::dec;
-    if (dash != '-') {
+  char* line = nullptr;
+  size_t line_size = 0;
+  while (getline(&line, &line_size, proc_maps) > 0) {
+    // Only the address range is parsed for the lines that don't match
+    char* next = nullptr;
+    uintptr_t low_address = strtoull(line, &next, 16);
+    if (*next != '-') {
+      continue;
+    }
+    uintptr_t high_address = strtoull(next + 1, &next, 16);
+    if ((address < low_address) || (address >= high_address)) {
       continue;
     }
 
-    // If address is > low_address and < high_address, then this
-    // is the mapped file. Get the URI path and offset.
-    uintptr_t address = reinterpret_cast<uintptr_t>(image);
-    if ((address >= low_address) && (address < high_address)) {
-      std::string permissions, device, uri_file_path;
-      size_t offset;
-      uint64_t inode;
-      tokens >> permissions
-             >> std::hex >> offset >> std::dec
-             >> device
-             >> inode
-             >> uri_file_path;
-
-      if (inode == 0 || uri_file_path.empty()) {
-        return ret_value;
+    char permissions[8];
+    char device[32];
+    unsigned long long offset = 0;
+    unsigned long long inode = 0;
+    int path_pos = 0;
+    if (sscanf(next, " %7s %llx %31s %llu %n", permissions, &offset, device, &inode,
+               &path_pos) >= 4 && inode != 0 && path_pos > 0) {
+      std::string uri_file_path(next + path_pos);
+      while (!uri_file_path.empty() && isspace(uri_file_path.back())) {
+        uri_file_path.pop_back();
+      }
+      if (!uri_file_path.empty()) {
+        *fname_ptr = uri_file_path;
+        *foffset_ptr = offset + address - low_address;
+        ret_value = true;
       }
-
-      *fname_ptr = uri_file_path;
-      *foffset_ptr = offset + address - low_address;
-      ret_value = true;
-      break;
     }
+    break;
   }
 
+  free(line);
+  fclose(proc_maps);
   return ret_value;
 }
 
+}  // namespace
+
+bool amd::Os::FindFileNameFromAddress(const void* image, std::string* fname_ptr,
+                                      size_t* foffset_ptr) {
+  static MappedFileIndex mapped_file_index;
+  uintptr_t address = reinterpret_cast<uintptr_t>(image);
+
+  // Code objects embedded in the executable or a shared library are resolved from the loader's
+  // table, anything else falls back to the kernel's list of mappings
+  if (mapped_file_index.Find(address, fname_ptr, foffset_ptr)) {
+    return true;
+  }
+  return FindFileNameInProcMaps(address, fname_ptr, foffset_ptr);
+}
+
 bool Os::MemoryMapFileDesc(FileDesc fdesc, size_t fsize, size_t foffset, const void** mmap_ptr) {
   if (fdesc <= 0) {
     return false;
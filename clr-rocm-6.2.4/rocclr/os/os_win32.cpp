@@ -348,6 +348,16 @@ bool Os::setThreadAffinityToMainThread() {
 }
 void Os::yield() { ::SwitchToThread(); }
 
+void Os::waitOnAddress(volatile uint32_t* addr, uint32_t expected, uint64_t timeoutNs) {
+  // WaitOnAddress() doesn't work across processes, so fall back to a timed sleep
+  if (*addr == expected) {
+    DWORD ms = static_cast<DWORD>(timeoutNs / (1000 * 1000));
+    ::Sleep((ms != 0) ? ms : 1);
+  }
+}
+
+void Os::wakeOnAddress(volatile uint32_t* addr) {}
+
 uint64_t Os::timeNanos() {
   LARGE_INTEGER current;
   QueryPerformanceCounter(&current);
@@ -758,6 +768,52 @@ $memcpy_final:
 #endif
 }
 
+void Os::fastMemFill(void* dest, const void* pattern, size_t patternSize, size_t count) {
+  static constexpr size_t kFillBlockSize = 4 * Ki;
+  char* dst = reinterpret_cast<char*>(dest);
+  const char* pat = reinterpret_cast<const char*>(pattern);
+  if (patternSize > kFillBlockSize / 2) {
+    for (size_t i = 0; i < count; ++i) {
+      fastMemcpy(dst + i * patternSize, pat, patternSize);
+    }
+    return;
+  }
+
+  // Double the pattern into a host block and copy the block
+  char block[kFillBlockSize];
+  const size_t blockSize = (kFillBlockSize / patternSize) * patternSize;
+  memcpy(block, pat, patternSize);
+  for (size_t filled = patternSize; filled < blockSize; filled *= 2) {
+    memcpy(block + filled, block, std::min(filled, blockSize - filled));
+  }
+  size_t n = patternSize * count;
+  for (; n >= blockSize; n -= blockSize, dst += blockSize) {
+    memcpy(dst, block, blockSize);
+  }
+  memcpy(dst, block, n);
+}
+
+void Os::fastMemcpy3D(void* dest, size_t destRowPitch, size_t destSlicePitch, const void* src,
+                      size_t srcRowPitch, size_t srcSlicePitch, size_t rowSize, size_t rows,
+                      size_t slices) {
+  // Merge the rows, then the slices, when they are contiguous on both sides
+  if ((rows > 1) && (destRowPitch == rowSize) && (srcRowPitch == rowSize)) {
+    rowSize *= rows;
+    rows = 1;
+  }
+  if ((rows == 1) && (slices > 1) && (destSlicePitch == rowSize) && (srcSlicePitch == rowSize)) {
+    rowSize *= slices;
+    slices = 1;
+  }
+  for (size_t slice = 0; slice < slices; ++slice) {
+    for (size_t row = 0; row < rows; ++row) {
+      fastMemcpy(reinterpret_cast<char*>(dest) + slice * destSlicePitch + row * destRowPitch,
+                 reinterpret_cast<const char*>(src) + slice * srcSlicePitch + row * srcRowPitch,
+                 rowSize);
+    }
+  }
+}
+
 uint64_t Os::offsetToEpochNanos() {
   static uint64_t offset = 0;
 
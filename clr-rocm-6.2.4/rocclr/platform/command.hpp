@@ -834,6 +834,47 @@ class StreamOperationCommand : public OneMemoryArgCommand {
   const size_t sizeBytes() const { return sizeBytes_; }
 };
 
+//! A batch of stream wait and write value operations executed in order as one command
+class StreamBatchOperationCommand : public Command {
+ public:
+  struct Operation {
+    cl_command_type type_;  //!< ROCCLR_COMMAND_STREAM_WAIT_VALUE or WRITE_VALUE
+    Memory* memory_;        //!< Memory to wait on or to write
+    size_t offset_;         //!< Offset into memory
+    size_t sizeBytes_;      //!< Size of the value, 4 or 8 bytes
+    uint64_t value_;        //!< Value to wait on or to write
+    uint64_t mask_;         //!< Mask applied on the memory value for a wait
+    unsigned int flags_;    //!< Wait condition
+  };
+
+ private:
+  std::vector<Operation> ops_;  //!< Operations in submission order
+
+ public:
+  StreamBatchOperationCommand(HostQueue& queue, const EventWaitList& eventWaitList,
+                              std::vector<Operation>&& ops)
+      : Command(queue, ROCCLR_COMMAND_STREAM_BATCH_OPERATION, eventWaitList, AMD_SERIALIZE_COPY),
+        ops_(std::move(ops)) {
+    for (auto& op : ops_) {
+      assert(((op.type_ == ROCCLR_COMMAND_STREAM_WRITE_VALUE) ||
+              (op.type_ == ROCCLR_COMMAND_STREAM_WAIT_VALUE)) && "Invalid Stream Operation");
+      op.memory_->retain();
+    }
+  }
+
+  virtual void releaseResources() {
+    for (auto& op : ops_) {
+      op.memory_->release();
+    }
+    Command::releaseResources();
+  }
+
+  virtual void submit(device::VirtualDevice& device) { device.submitStreamBatchOperation(*this); }
+
+  //! Returns the operations of the batch
+  const std::vector<Operation>& ops() const { return ops_; }
+};
+
 /*! \brief      A generic copy memory command
  *
  *  \details    Used for both buffers and images. Backends are expected
@@ -28,6 +28,7 @@
 #ifndef COMMAND_QUEUE_HPP_
 #define COMMAND_QUEUE_HPP_
 
+#include "os/numa.hpp"
 #include "thread/thread.hpp"
 #include "platform/object.hpp"
 #include "platform/command.hpp"
@@ -167,6 +168,7 @@ class HostQueue : public CommandQueue {
     //! The command queue thread entry point.
     void run(void* data) {
       HostQueue* queue = static_cast<HostQueue*>(data);
+      NumaPlacement::bindThread(*this, queue->device().getPreferredNumaNode());
       virtualDevice_ = queue->device().createVirtualDevice(queue);
       if (virtualDevice_ != nullptr) {
         queue->loop(virtualDevice_);
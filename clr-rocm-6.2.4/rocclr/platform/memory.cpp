@@ -1500,27 +1500,17 @@ void Image::Format::formatColor(const void* colorRGBA, void* colorFormat) const
   }
 }
 
-Monitor SvmBuffer::AllocatedLock_ ROCCLR_INIT_PRIORITY(101) ("Guards SVM allocation list");
-std::map<uintptr_t, uintptr_t> SvmBuffer::Allocated_ ROCCLR_INIT_PRIORITY(101);
-
+// The allocated ranges are kept in the memory object map, one lookup answers both questions
 void SvmBuffer::Add(uintptr_t k, uintptr_t v) {
-  ScopedLock lock(AllocatedLock_);
-  Allocated_.insert(std::pair<uintptr_t, uintptr_t>(k, v));
+  MemObjMap::AddSvmRange(reinterpret_cast<const void*>(k), v - k);
 }
 
 void SvmBuffer::Remove(uintptr_t k) {
-  ScopedLock lock(AllocatedLock_);
-  Allocated_.erase(k);
+  MemObjMap::RemoveSvmRange(reinterpret_cast<const void*>(k));
 }
 
 bool SvmBuffer::Contains(uintptr_t ptr) {
-  ScopedLock lock(AllocatedLock_);
-  auto it = Allocated_.upper_bound(ptr);
-  if (it == Allocated_.begin()) {
-    return false;
-  }
-  --it;
-  return ptr >= it->first && ptr < it->second;
+  return MemObjMap::IsSvmRange(reinterpret_cast<const void*>(ptr));
 }
 
 // The allocation flags are ignored for now.
@@ -1542,11 +1532,7 @@ void SvmBuffer::free(const Context& context, void* ptr) {
 }
 
 void SvmBuffer::memFill(void* dst, const void* src, size_t srcSize, size_t times) {
-  address dstAddress = reinterpret_cast<address>(dst);
-  const_address srcAddress = reinterpret_cast<const_address>(src);
-  for (size_t i = 0; i < times; i++) {
-    ::memcpy(dstAddress + i * srcSize, srcAddress, srcSize);
-  }
+  amd::Os::fastMemFill(dst, src, srcSize, times);
 }
 
 // ================================================================================================
@@ -24,6 +24,7 @@
 #include "top.hpp"
 #include "utils/flags.hpp"
 #include "thread/monitor.hpp"
+#include "utils/concurrent.hpp"
 #include "platform/context.hpp"
 #include "platform/object.hpp"
 #include "platform/interop.hpp"
@@ -679,9 +680,6 @@ class SvmBuffer : AllStatic {
   static void Add(uintptr_t k, uintptr_t v);
   static void Remove(uintptr_t k);
   static bool Contains(uintptr_t ptr);
-
-  static std::map<uintptr_t, uintptr_t> Allocated_;  // !< Allocated buffers
-  static Monitor AllocatedLock_;
 };
 
 class ArenaMemory: public Buffer {
@@ -23,6 +23,7 @@
 #include "platform/program.hpp"
 #include "platform/context.hpp"
 #include "utils/options.hpp"
+#include "thread/threadpool.hpp"
 #if defined(WITH_COMPILER_LIB)
 #include "utils/libUtils.h"
 #include "utils/bif_section_labels.hpp"
@@ -34,7 +35,9 @@
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace amd {
 
@@ -485,6 +488,18 @@ void Program::StubProgramSource(const std::string& app_name) {
   program_counter++;
 }
 
+// Device programs of one build are compiled concurrently, the compiler stack needs more than
+// the default thread stack
+static ThreadPool* getBuildPool() {
+  static Monitor lock("Program build pool lock");
+  static ThreadPool* pool = nullptr;
+  ScopedLock sl(lock);
+  if (pool == nullptr) {
+    pool = new ThreadPool("Program Build", ROC_BUILD_THREADS, 8 * Mi);
+  }
+  return pool;
+}
+
 int32_t Program::build(const std::vector<Device*>& devices, const char* options,
                       void(CL_CALLBACK* notifyFptr)(cl_program, void*), void* data,
                       bool optionChangable, bool newDevProg) {
@@ -513,9 +528,20 @@ int32_t Program::build(const std::vector<Device*>& devices, const char* options,
   std::string cppstr(options ? options : "");
   optionChangable &= adjustOptionsOnIgnoreEnv(cppstr);
 
-  // Build the program programs associated with the given devices.
+  struct BuildJob {
+    device::Program* devProgram_;
+    std::unique_ptr<option::Options> options_;
+    int32_t result_;
+    uint64_t startTime_;
+    uint64_t buildTime_;
+  };
+  std::vector<BuildJob> jobs;
+  jobs.reserve(devices.size());
+
+  // Prepare the programs associated with the given devices.
   for (const auto& it : devices) {
-    option::Options parsedOptions;
+    std::unique_ptr<option::Options> options_ptr(new option::Options());
+    option::Options& parsedOptions = *options_ptr;
     constexpr bool LinkOptsOnly = false;
     if ((language_ != HIP) && !ParseAllOptions(cppstr, parsedOptions, optionChangable, LinkOptsOnly,
                          it->settings().useLightning_)) {
@@ -557,15 +583,43 @@ int32_t Program::build(const std::vector<Device*>& devices, const char* options,
     if (devProgram->buildStatus() != CL_BUILD_NONE) {
       continue;
     }
-    int32_t result = devProgram->build(sourceCode_, options, &parsedOptions, precompiledHeaders_);
+    jobs.push_back({devProgram, std::move(options_ptr), CL_SUCCESS, 0, 0});
+  }
+
+  // Build the device programs. The compiler dumps share file name counters, so keep them serial.
+  auto buildJob = [&](size_t i) {
+    BuildJob& job = jobs[i];
+    job.startTime_ = Os::timeNanos();
+    job.result_ = job.devProgram_->build(sourceCode_, options, job.options_.get(),
+                                         precompiledHeaders_);
+    job.buildTime_ = Os::timeNanos() - job.startTime_;
+  };
+  const uint64_t submitTime = Os::timeNanos();
+  bool serial = (jobs.size() < 2) || (ROC_BUILD_THREADS == 0);
+  for (const auto& job : jobs) {
+    serial |= (job.options_->oVariables->DumpFlags > 0);
+  }
+  if (serial) {
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      buildJob(i);
+    }
+  } else {
+    // A busy pool builds another program already, so build this one on the calling thread
+    getBuildPool()->tryParallelFor(jobs.size(), buildJob);
+  }
+
+  // Report in device order
+  for (auto& job : jobs) {
+    job.devProgram_->setBuildTime(serial ? 0 : job.startTime_ - submitTime, job.buildTime_);
+    job.devProgram_->printBuildLog(job.options_.get());
 
     // Check if the previous device failed a build
-    if ((result != CL_SUCCESS) && (retval != CL_SUCCESS)) {
+    if ((job.result_ != CL_SUCCESS) && (retval != CL_SUCCESS)) {
       retval = CL_INVALID_OPERATION;
     }
     // Update the returned value with a build error
-    else if (result != CL_SUCCESS) {
-      retval = result;
+    else if (job.result_ != CL_SUCCESS) {
+      retval = job.result_;
     }
   }
 
@@ -0,0 +1,137 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "thread/threadpool.hpp"
+#include "os/os.hpp"
+
+namespace amd {
+
+//! Set on the worker threads of all the pools
+static thread_local bool poolWorker = false;
+
+ThreadPool::ThreadPool(const std::string& name, uint numWorkers, size_t stackSize)
+    : lock_("ThreadPool lock", true), submitLock_("ThreadPool submit lock", true),
+      jobId_(0), terminate_(false) {
+  workers_.reserve(numWorkers);
+  for (uint i = 0; i < numWorkers; ++i) {
+    Worker* worker = new Worker(name + " Worker", stackSize);
+    if (worker == nullptr || worker->state() < Thread::INITIALIZED) {
+      delete worker;
+      break;
+    }
+    workers_.push_back(worker);
+    worker->start(this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    ScopedLock sl(lock_);
+    terminate_ = true;
+    lock_.notifyAll();
+  }
+  for (auto worker : workers_) {
+    while (worker->state() < Thread::FINISHED && Os::isThreadAlive(*worker)) {
+      Os::yield();
+    }
+    delete worker;
+  }
+  workers_.clear();
+}
+
+void ThreadPool::work(Job& job) {
+  size_t index;
+  while ((index = job.next_.fetch_add(1, std::memory_order_relaxed)) < job.count_) {
+    job.task_(index);
+    if (job.done_.fetch_add(1, std::memory_order_acq_rel) + 1 == job.count_) {
+      job.finished_.post();
+    }
+  }
+}
+
+bool ThreadPool::isWorkerThread() { return poolWorker; }
+
+void ThreadPool::loop() {
+  poolWorker = true;
+  uint64_t lastJobId = 0;
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      ScopedLock sl(lock_);
+      while (!terminate_ && jobId_ == lastJobId) {
+        lock_.wait();
+      }
+      if (terminate_) {
+        return;
+      }
+      lastJobId = jobId_;
+      job = job_;
+    }
+    // A worker waking up late finds the indices of its job already claimed, or no job at all
+    // once the submitter has released it
+    if (job != nullptr) {
+      work(*job);
+    }
+  }
+}
+
+void ThreadPool::parallelFor(size_t count, const Task& task) {
+  if (count == 0) {
+    return;
+  }
+  if (workers_.empty() || count == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  ScopedLock sl(submitLock_);
+  submit(count, task);
+}
+
+bool ThreadPool::tryParallelFor(size_t count, const Task& task) {
+  if (workers_.empty() || count < 2 || !submitLock_.tryLock()) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return false;
+  }
+  submit(count, task);
+  submitLock_.unlock();
+  return true;
+}
+
+void ThreadPool::submit(size_t count, const Task& task) {
+  auto job = std::make_shared<Job>(task, count);
+  {
+    ScopedLock sl(lock_);
+    job_ = job;
+    ++jobId_;
+    lock_.notifyAll();
+  }
+  work(*job);
+  job->finished_.wait();
+
+  ScopedLock sl(lock_);
+  job_.reset();
+}
+
+}  // namespace amd
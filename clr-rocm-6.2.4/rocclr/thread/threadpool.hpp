@@ -0,0 +1,112 @@
+/* Copyright (c) 2024 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef THREADPOOL_HPP_
+#define THREADPOOL_HPP_
+
+#include "top.hpp"
+#include "thread/monitor.hpp"
+#include "thread/semaphore.hpp"
+#include "thread/thread.hpp"
+#include "utils/flags.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace amd {
+
+/*! \addtogroup Threads
+ *  @{
+ */
+
+//! \brief Fixed size pool of runtime threads for independent host work
+class ThreadPool : public HeapObject {
+ public:
+  //! Work item executed for every index of a parallelFor() range
+  typedef std::function<void(size_t)> Task;
+
+  //! Create a pool of \a numWorkers threads with \a stackSize bytes of stack
+  ThreadPool(const std::string& name, uint numWorkers, size_t stackSize = CQ_THREAD_STACK_SIZE);
+
+  //! Terminate and destroy the worker threads
+  ~ThreadPool();
+
+  /*! \brief Run task(i) for every i in [0, count).
+   *  The indices are shared between the workers and the calling thread,
+   *  the call returns when all of them have completed.
+   */
+  void parallelFor(size_t count, const Task& task);
+
+  /*! \brief Same as parallelFor(), but runs the whole range on the calling thread
+   *  if the pool is busy with another range. Returns true if the pool was used.
+   */
+  bool tryParallelFor(size_t count, const Task& task);
+
+  //! Return the number of worker threads
+  uint numWorkers() const { return static_cast<uint>(workers_.size()); }
+
+  //! Return true if the calling thread is a worker of a pool, and not a parallelFor() caller
+  static bool isWorkerThread();
+
+ private:
+  //! One parallelFor() range, kept alive by every thread working on it
+  struct Job {
+    Job(const Task& task, size_t count) : task_(task), count_(count), next_(0), done_(0) {}
+    const Task& task_;           //!< Work item
+    const size_t count_;         //!< Number of indices
+    std::atomic<size_t> next_;   //!< Next index to claim
+    std::atomic<size_t> done_;   //!< Number of completed indices
+    Semaphore finished_;         //!< Posted when all indices are done
+  };
+
+  class Worker : public Thread {
+   public:
+    Worker(const std::string& name, size_t stackSize) : Thread(name, stackSize) {}
+
+    //! The worker thread entry point.
+    void run(void* data) { static_cast<ThreadPool*>(data)->loop(); }
+  };
+
+  //! Worker main loop, waits for jobs until the pool is terminated
+  void loop();
+
+  //! Claim and run the indices of the job until none are left
+  static void work(Job& job);
+
+  //! Hand a range to the workers and join it, submitLock_ must be held
+  void submit(size_t count, const Task& task);
+
+  Monitor lock_;                  //!< Guards job_ and terminate_
+  Monitor submitLock_;            //!< Serializes the parallelFor() callers
+  std::vector<Worker*> workers_;  //!< Worker threads
+  std::shared_ptr<Job> job_;      //!< Current job
+  uint64_t jobId_;                //!< Incremented for every new job
+  bool terminate_;                //!< Workers must exit
+};
+
+/*! @}
+ */
+
+}  // namespace amd
+
+#endif /*THREADPOOL_HPP_*/
@@ -23,9 +23,13 @@
 
 #include "top.hpp"
 #include "os/alloc.hpp"
+#include "os/os.hpp"
 
 #include <atomic>
+#include <map>
+#include <mutex>
 #include <new>
+#include <type_traits>
 
 //! \addtogroup Utils
 
@@ -111,6 +115,120 @@ template <typename T, int N = 5> class ConcurrentLinkedQueue : public HeapObject
   inline bool empty();
 };
 
+/*! \brief An ordered map of address ranges, which favors lookups over updates.
+ *
+ * Entries are keyed by the start address of their range. The map is kept twice (left-right):
+ * readers use the copy that is published, writers update the other copy, publish it, wait until
+ * the readers of the old copy are gone and repeat the update there. A reader only increments a
+ * counter in one of several reader slots, so lookups never take a lock, never wait for a writer
+ * and don't share a cache line with readers on other threads. Writers are serialized.
+ *
+ * The callbacks run while the map is guarded and must not access the same map again. A modify()
+ * callback runs once per copy, so it must only change the map and has to return the same result
+ * for both copies. Other side effects belong outside of it, driven by the returned value.
+ */
+template <typename T, size_t Slots = 16> class ConcurrentRangeMap : public HeapObject {
+ public:
+  typedef std::map<uintptr_t, T> Map;
+
+  ConcurrentRangeMap() : published_(0), readIndicator_(0) {
+    for (auto& indicator : slots_) {
+      for (auto& slot : indicator) {
+        slot.readers_.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /*! \brief Looks up the entry with the greatest start address not above \a key.
+   *
+   * Returns f(start, value) for that entry, or \a notFound if \a key is below all entries.
+   */
+  template <typename R, typename F> R floor(uintptr_t key, R notFound, F f) const {
+    ReadGuard guard(*this);
+    const Map& map = maps_[published_.load(std::memory_order_seq_cst)];
+    auto it = map.upper_bound(key);
+    if (it == map.begin()) {
+      return notFound;
+    }
+    --it;
+    return f(it->first, it->second);
+  }
+
+  //! Runs f(map) with shared access to the map
+  template <typename F> auto read(F f) const {
+    ReadGuard guard(*this);
+    return f(maps_[published_.load(std::memory_order_seq_cst)]);
+  }
+
+  //! Runs f(map) on both copies with exclusive access, returns the result of the first run
+  template <typename F> auto modify(F f) {
+    std::lock_guard<std::mutex> lock(writeLock_);
+    const uint32_t published = published_.load(std::memory_order_relaxed);
+    if constexpr (std::is_void_v<decltype(f(maps_[published]))>) {
+      f(maps_[published ^ 1]);
+      Publish(published ^ 1);
+      f(maps_[published]);
+    } else {
+      auto result = f(maps_[published ^ 1]);
+      Publish(published ^ 1);
+      f(maps_[published]);
+      return result;
+    }
+  }
+
+ private:
+  //! Reader counter, padded to a cache line
+  struct Slot {
+    std::atomic<uint32_t> readers_;
+    char padding_[64 - sizeof(std::atomic<uint32_t>)];
+  };
+
+  //! Returns the reader slot of the calling thread
+  static size_t slotIndex() {
+    static std::atomic<size_t> next(0);
+    thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % Slots;
+    return index;
+  }
+
+  //! Sends readers to the updated copy and returns once the other copy has no readers left
+  void Publish(uint32_t copy) {
+    published_.store(copy, std::memory_order_seq_cst);
+    // Readers that may still use the old copy arrived on the current indicator. New readers are
+    // sent to the other indicator once it drained, then the current one must drain as well
+    const uint32_t indicator = readIndicator_.load(std::memory_order_relaxed);
+    WaitForReaders(indicator ^ 1);
+    readIndicator_.store(indicator ^ 1, std::memory_order_seq_cst);
+    WaitForReaders(indicator);
+  }
+
+  //! Spins until no reader is registered on the read indicator
+  void WaitForReaders(uint32_t indicator) const {
+    for (auto& slot : slots_[indicator]) {
+      while (slot.readers_.load(std::memory_order_seq_cst) != 0) {
+        Os::yield();
+      }
+    }
+  }
+
+  class ReadGuard : public StackObject {
+   public:
+    ReadGuard(const ConcurrentRangeMap& map)
+        : slot_(map.slots_[map.readIndicator_.load(std::memory_order_seq_cst)][slotIndex()]) {
+      slot_.readers_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~ReadGuard() { slot_.readers_.fetch_sub(1, std::memory_order_release); }
+
+   private:
+    Slot& slot_;
+  };
+
+  mutable Slot slots_[2][Slots];          //!< Reader counters of both read indicators
+  std::atomic<uint32_t> published_;       //!< The copy readers use
+  std::atomic<uint32_t> readIndicator_;   //!< The reader counters new readers arrive on
+  std::mutex writeLock_;                  //!< Serializes writers
+  Map maps_[2];                           //!< Both copies, ranges ordered by start address
+};
+
 /*@}*/
 
 template <typename T, int N> inline ConcurrentLinkedQueue<T, N>::ConcurrentLinkedQueue() {
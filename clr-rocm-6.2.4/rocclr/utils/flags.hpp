@@ -253,6 +253,55 @@ release(bool, HIP_ALWAYS_USE_NEW_COMGR_UNBUNDLING_ACTION, false,              \
         "Force to always use new comgr unbundling action")                    \
 release(bool, DEBUG_CLR_KERNARG_HDP_FLUSH_WA, false,                          \
         "Toggle kernel arg copy workaround")                                  \
+release(bool, HIP_LAZY_MODULE_SYMBOLS, true,                                  \
+        "Create hipModule function/variable objects on first lookup, "        \
+        "0 = Register all symbols at module load")                            \
+release(bool, HIP_CODE_OBJECT_CACHE, true,                                    \
+        "Share code objects extracted from identical bundles across modules " \
+        "and devices with the same ISA")                                      \
+release(bool, HIP_STREAMING_UNBUNDLER, true,                                  \
+        "Decompress only the needed code objects of compressed bundles "      \
+        "instead of handing the whole bundle to comgr")                       \
+release(bool, HIP_PARALLEL_MULTI_DEVICE_LAUNCH, true,                         \
+        "Submit the per-device kernels of multi-device cooperative launches " \
+        "from parallel worker threads")                                       \
+release(uint, HIP_IPC_EVENT_SPIN_US, 20,                                      \
+        "Time in microseconds an IPC event wait spins before it blocks")      \
+release(size_t, ROC_HOST_COPY_NT_THRESHOLD, 1 * Mi,                           \
+        "Host copies of at least this many bytes use non-temporal stores")    \
+release(size_t, ROC_HOST_COPY_MT_THRESHOLD, 64 * Mi,                          \
+        "Host copies of at least this many bytes are split across workers")   \
+release(uint, ROC_HOST_COPY_THREADS, 4,                                       \
+        "Number of worker threads for large host copies, 0 disables")         \
+release(bool, HIP_HMM_RANGE_TRACKING, false,                                  \
+        "Track managed memory advice and prefetches per range and skip the "  \
+        "ones that are already in effect, host accesses aren't tracked")      \
+release(bool, ROC_NUMA_PLACEMENT, true,                                       \
+        "Bind the host queue and hostcall threads to the CPUs of the NUMA "   \
+        "node of their device")                                               \
+release(cstring, ROC_NUMA_NODE_MAP, "",                                       \
+        "Override the NUMA node of the host memory and threads of a device, " \
+        "one node for all or 'index:node,...' by rocclr device index")        \
+release(bool, ROC_COMPLETION_REAPER, true,                                    \
+        "Complete direct dispatch callbacks and markers on a runtime thread " \
+        "instead of per command HSA async handlers")                          \
+release(bool, AMD_OCL_PROGRAM_CACHE, true,                                    \
+        "Cache code objects of OpenCL programs built from source on disk")    \
+release(cstring, AMD_OCL_PROGRAM_CACHE_PATH, "",                              \
+        "Program cache directory, empty uses the user cache directory")       \
+release(size_t, AMD_OCL_PROGRAM_CACHE_SIZE, 512,                              \
+        "Size cap of the program cache in MB, 0 disables the cache")          \
+release(uint, ROC_BUILD_THREADS, 8,                                           \
+        "Number of threads building a program for several devices at once, "  \
+        "0 builds one device at a time")                                      \
+release(uint, ROC_DOORBELL_BATCH, 0,                                          \
+        "Maximum number of kernel dispatches sharing one doorbell write in "  \
+        "direct dispatch mode, 0 rings the doorbell for every dispatch")      \
+release(uint, ROC_DOORBELL_BATCH_US, 20,                                      \
+        "Time in microseconds a batched dispatch may wait for the doorbell")  \
+release(uint, ROC_KERNARG_CACHE, 0,                                           \
+        "Number of kernel argument blocks a queue keeps for reuse by "        \
+        "launches with identical arguments, 0 disables the cache")            \
 
 namespace amd {
 
@@ -90,6 +90,29 @@ extern "C" hipError_t hipHccModuleLaunchKernel(hipFunction_t f, uint32_t globalW
                                     hipEvent_t startEvent __dparm(NULL),
                                     hipEvent_t stopEvent __dparm(NULL));
 
+/**
+ * @brief Launches a batch of kernels on a single stream.
+ *
+ * All launches are validated before any of them is submitted. If one launch is invalid, none of
+ * the kernels is launched. The valid batch is submitted in order, with a single doorbell write
+ * for the whole batch, which amortizes the per-launch runtime overhead of bursts of small kernels.
+ *
+ * @param [in] launchParamsList  List of launch parameters, one per kernel. The grid dimensions
+ * are specified in blocks. The hStream field of each entry must be equal to @p stream.
+ * @param [in] numKernels  Number of kernels in the list.
+ * @param [in] stream  Stream where the kernels should be dispatched.
+ * May be 0, in which case the default stream is used with associated synchronization rules.
+ * @param [in] flags  The value of hipExtAnyOrderLaunch, signifies if kernels can be
+ * launched in any order.
+ * @returns #hipSuccess, #hipErrorNotInitialized, #hipErrorInvalidValue,
+ * #hipErrorInvalidConfiguration, #hipErrorInvalidResourceHandle
+ *
+ */
+HIP_PUBLIC_API
+extern "C" hipError_t hipExtLaunchKernelBatch(const hipFunctionLaunchParams* launchParamsList,
+                                              unsigned int numKernels, hipStream_t stream,
+                                              unsigned int flags);
+
 #if defined(__cplusplus)
 
 /**
@@ -1082,6 +1082,25 @@ typedef struct hipFunctionLaunchParams_t {
     hipStream_t hStream;         ///< Stream identifier
     void **kernelParams;         ///< Kernel parameters
 } hipFunctionLaunchParams;
+/**
+ * Operation types of hipStreamBatchMemOp
+ */
+typedef enum hipStreamBatchMemOpType {
+  hipStreamMemOpWaitValue32 = 0x1,   ///< Wait on a 32 bit value, see hipStreamWaitValue32
+  hipStreamMemOpWriteValue32 = 0x2,  ///< Write a 32 bit value, see hipStreamWriteValue32
+  hipStreamMemOpWaitValue64 = 0x4,   ///< Wait on a 64 bit value, see hipStreamWaitValue64
+  hipStreamMemOpWriteValue64 = 0x5   ///< Write a 64 bit value, see hipStreamWriteValue64
+} hipStreamBatchMemOpType;
+/**
+ * struct hipStreamBatchMemOpParams_t
+ */
+typedef struct hipStreamBatchMemOpParams_t {
+    hipStreamBatchMemOpType operation; ///< Operation type
+    void* address;                     ///< Memory to wait on or to write
+    uint64_t value;                    ///< Value to compare against or to write
+    uint64_t mask;                     ///< Mask applied on the memory value, waits only
+    unsigned int flags;                ///< Wait condition, one of hipStreamWaitValue* flags
+} hipStreamBatchMemOpParams;
 typedef enum hipExternalMemoryHandleType_enum {
   hipExternalMemoryHandleTypeOpaqueFd = 1,
   hipExternalMemoryHandleTypeOpaqueWin32 = 2,
@@ -2735,6 +2754,28 @@ hipError_t hipStreamWriteValue32(hipStream_t stream, void* ptr, uint32_t value,
  * hipStreamWaitValue64
  */
 hipError_t hipStreamWriteValue64(hipStream_t stream, void* ptr, uint64_t value, unsigned int flags);
+/**
+ * @brief Enqueues a batch of wait and write commands to the stream.[BETA]
+ *
+ * @param [in] stream     - Stream identifier
+ * @param [in] count      - Number of operations in paramArray
+ * @param [in] paramArray - Operations to enqueue, executed in array order
+ * @param [in] flags      - reserved, must be 0
+ *
+ * @returns #hipSuccess, #hipErrorInvalidValue
+ *
+ * Each operation behaves like the matching hipStreamWaitValue32/64 or hipStreamWriteValue32/64
+ * call. The whole batch is enqueued as a single command, and consecutive operations that are
+ * executed by a blit kernel share one dispatch. All operations are validated before any of them
+ * is enqueued.
+ *
+ * @warning This API is marked as beta, meaning, while this is feature complete,
+ * it is still open to changes and may have outstanding issues.
+ *
+ * @see hipStreamWaitValue32, hipStreamWaitValue64, hipStreamWriteValue32, hipStreamWriteValue64
+ */
+hipError_t hipStreamBatchMemOp(hipStream_t stream, unsigned int count,
+                               hipStreamBatchMemOpParams* paramArray, unsigned int flags);
 // end doxygen Stream Memory Operations
 /**
  * @}
@@ -5976,6 +6017,25 @@ hipError_t hipDrvMemcpy2DUnaligned(const hip_Memcpy2D* pCopy);
 hipError_t hipExtLaunchKernel(const void* function_address, dim3 numBlocks, dim3 dimBlocks,
                               void** args, size_t sharedMemBytes, hipStream_t stream,
                               hipEvent_t startEvent, hipEvent_t stopEvent, int flags);
+/**
+ * @brief Launches a batch of kernels on a single stream.
+ *
+ * @param [in] launchParamsList  List of launch parameters, one per kernel. The grid dimensions
+ * are specified in blocks. The hStream field of each entry must be equal to @p stream.
+ * @param [in] numKernels  Number of kernels in the list.
+ * @param [in] stream  Stream where the kernels should be dispatched.
+ * May be 0, in which case the default stream is used with associated synchronization rules.
+ * @param [in] flags  The value of hipExtAnyOrderLaunch, signifies if kernels can be
+ * launched in any order.
+ * @returns #hipSuccess, #hipErrorNotInitialized, #hipErrorInvalidValue,
+ * #hipErrorInvalidConfiguration, #hipErrorInvalidResourceHandle
+ *
+ * All launches are validated before any of them is submitted. The batch is submitted in order,
+ * with a single doorbell write for the whole batch.
+ */
+hipError_t hipExtLaunchKernelBatch(const hipFunctionLaunchParams* launchParamsList,
+                                   unsigned int numKernels, hipStream_t stream,
+                                   unsigned int flags);
 // doxygen end Clang launch
 /**
  * @}
@@ -8028,6 +8088,39 @@ hipError_t hipGraphReleaseUserObject(hipGraph_t graph, hipUserObject_t object,
  */
 hipError_t hipGraphDebugDotPrint(hipGraph_t graph, const char* path, unsigned int flags);
 
+/**
+ * @brief Save a graph to a binary file, which can be loaded by another process.
+ *
+ * The file holds the node types, the node parameters, the edges and the memory node layouts.
+ * Kernels are referenced by their mangled names and must be registered statically. Pointers into
+ * the allocations of the graph's memory allocation nodes are saved as relocations and are fixed
+ * up on load. Other pointers are saved as they are.
+ *
+ * @param [in] graph - graph object to save.
+ * @param [in] path - path to write the graph file.
+ * @param [in] flags - Currently must be 0.
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorNotSupported, #hipErrorOperatingSystem
+ *
+ * Host nodes, event nodes, external semaphore nodes, driver and symbol memcpy nodes, memcpy
+ * nodes with arrays and kernels launched from modules can't be saved.
+ * @warning : This API is marked as beta, meaning, while this is feature complete,
+ * it is still open to changes and may have outstanding issues.
+ */
+hipError_t hipExtGraphSave(hipGraph_t graph, const char* path, unsigned int flags);
+
+/**
+ * @brief Load a graph saved with hipExtGraphSave.
+ *
+ * @param [out] pGraph - returns the created graph on the current device.
+ * @param [in] path - path of the graph file.
+ * @param [in] flags - Currently must be 0.
+ * @returns #hipSuccess, #hipErrorInvalidValue, #hipErrorInvalidDeviceFunction,
+ * #hipErrorOperatingSystem
+ * @warning : This API is marked as beta, meaning, while this is feature complete,
+ * it is still open to changes and may have outstanding issues.
+ */
+hipError_t hipExtGraphLoad(hipGraph_t* pGraph, const char* path, unsigned int flags);
+
 /**
  * @brief Copies attributes from source node to destination node.
  *